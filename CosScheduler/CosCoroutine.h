@@ -0,0 +1,557 @@
+/*!
+ ********************************************************************
+   @file            CosCoroutine.h
+   @par Project   : co-operative Scheduler
+   @par Module    : Task functions as C++20 coroutines
+
+   @brief  Coroutine tasks for the scheduler of COS.
+
+   The macros COS_TASK_SLEEP(), COS_SEM_WAIT() etc. return from the task
+   function and jump back by switch(__LINE__) at the next call. Local
+   variables are lost at every scheduling point, so they have to be
+   static; then a task function can not run as several tasks, and the
+   macros can not be used in called functions or in a switch statement.
+
+   A C++20 coroutine keeps its local variables in a frame, which
+   survives the suspension:
+
+   @verbatim
+CosCoTask producer(CosFifo<int, 4> &fifo, int id, CosTicks_t period)
+{   for(int n = 0; n < 10; n++)
+    {   co_await CosCoWrite(fifo, 100 * id + n);
+        co_await CosCoSleep(period);
+    }
+}
+...
+CosCoSpawn(2, producer(fifo, 1, _milliSecToTicks(20)));
+CosCoSpawn(2, producer(fifo, 2, _milliSecToTicks(30)));
+   @endverbatim
+
+   CosCoSpawn() creates a normal COS task, the scheduler does not know
+   the difference: its task function resumes the coroutine, the
+   awaitables below set sleep time and state of the task before the
+   coroutine suspends, exactly like the macros do.
+
+   - co_await CosCoSleep(t), CosCoYield(): COS_TASK_SLEEP(), COS_TASK_SCHEDULE()
+   - co_await sem, CosCoWait(&sem): COS_SEM_WAIT(), yields also if the
+     semaphore is free
+   - co_await CosCoRead(fifo), CosCoWrite(fifo, item): CosFifo<T,N>
+   - co_await CosCoRead(&q, data), CosCoWrite(&q, data): CosFifo_t
+   - co_await f(...): calls the coroutine f, which may suspend itself
+
+   The task ends with the coroutine, its frame is released and the
+   task deleted. Do not delete a coroutine task by COS_DeleteTask(), its
+   frame would be lost. Coroutines return no value.
+
+   The frames are taken from a static pool of COS_CORO_FRAMES blocks of
+   COS_CORO_FRAME_BYTES bytes (CosCoFramePool), the heap is not used.
+   The size of a frame is known to the compiler only; if it does not
+   fit or the pool is empty, CosCoSpawn() returns NULL. Size the pool
+   for the deepest nesting of calls in all tasks at once.
+   CosCoFramePool::getStatistics() shows the peak usage and the largest
+   rejected size. Exceptions are not used.
+
+   A called coroutine without frame, or an exception that leaves a
+   coroutine, is an error the caller can not see. Only the failing task
+   is stopped, the other tasks, the timers and the watchdog kick go on:
+   the error is reported by the hook of CosCoFramePool::setFailedHook()
+   (default: a line by serPuts()), then the task is suspended. After a
+   missing frame, COS_ResumeTask() continues the caller behind the
+   skipped call. After an exception, the task stays suspended; if the
+   coroutine of CosCoSpawn() itself failed, the task is deleted.
+
+   A C++20 compiler with <coroutine> is required, e.g. GCC 10 or later
+   with -std=c++20.
+
+
+   @par Author    : Ernst Forgber (Fgb)
+   @par Company   : Hochschule Hannover - University of Applied Sciences and Arts, Germany
+   @par Department: Faculty 1
+
+ ********************************************************************
+
+   @par History   :
+   @verbatim
+   Version | Date        | Author  | Change Description
+   0.0     | 18.10. 2026 | Fgb     | First Version
+   0.1     | 18.10. 2026 | Fgb     | trap on a called coroutine without frame, CosCoWait yields
+   0.2     | 18.10. 2026 | Fgb     | failing coroutine: report by hook, suspend only its task
+   @endverbatim
+
+ ********************************************************************/
+/**************************************************************************
+
+Copyright 2026 Ernst Forgber
+
+
+This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+
+
+#ifndef cos_coroutine_oop_h_
+#define cos_coroutine_oop_h_
+
+#include <stddef.h>     // for size_t, max_align_t
+#include <coroutine>
+
+extern "C" {
+#include "utility/cos_scheduler.h"
+#include "utility/cos_semaphore.h"
+#include "utility/cos_data_fifo.h"
+#include "utility/cos_ser.h"
+}
+#include "CosFifo.h"
+
+
+/* A called coroutine that gets no frame suspends its task, see
+   CosCoFramePool::setFailedHook(): size the pool for all tasks at their
+   deepest nesting of calls, CosCoFramePool::getStatistics() shows the peak. */
+#ifndef COS_CORO_FRAMES
+#define COS_CORO_FRAMES       8    /*!< frames in the pool: running coroutine tasks plus called coroutines */
+#endif
+#ifndef COS_CORO_FRAME_BYTES
+#define COS_CORO_FRAME_BYTES  256  /*!< bytes per frame */
+#endif
+
+
+
+/*! usage of the frame pool */
+typedef struct
+{
+        uint16_t used;            /*!< frames in use */
+        uint16_t peak;            /*!< high-water mark of used */
+        uint16_t failed;          /*!< frames that could not be allocated */
+        uint16_t largestFailed;   /*!< largest size that did not fit */
+        uint16_t callsFailed;     /*!< called coroutines without frame */
+        uint16_t exceptions;      /*!< coroutines left by an exception */
+} CosCoPoolStats_t;
+
+/* errors of a coroutine task, see CosCoFramePool::setFailedHook() */
+#define COS_CO_NO_FRAME   1  /*!< a called coroutine got no frame */
+#define COS_CO_EXCEPTION  2  /*!< an exception left a coroutine */
+
+
+/*!
+ ********************************************************************
+  @par Description
+  Pool of coroutine frames: fixed blocks in static memory, a free
+  list links the released blocks. Allocation and release take constant
+  time, there is no fragmentation.
+ ********************************************************************/
+class CosCoFramePool
+{
+public:
+    /*! returns a block of at least 'size' bytes, NULL if none is left */
+    static void *alloc(size_t size) noexcept
+    {   Block *b;
+
+        if((size > COS_CORO_FRAME_BYTES) || ((NULL == free_) && (fresh_ >= COS_CORO_FRAMES)))
+        {   stats_.failed++;
+            if(size > stats_.largestFailed)
+            {   stats_.largestFailed = (uint16_t)((size > 0xFFFF) ? 0xFFFF : size);
+            }
+            return NULL;
+        }
+        if(NULL != free_)
+        {   b = free_;
+            free_ = b->next;
+        }
+        else
+        {   b = &blocks_[fresh_++];  /* never used before */
+        }
+        if(++stats_.used > stats_.peak)
+        {   stats_.peak = stats_.used;
+        }
+        return b;
+    }
+
+    /*! returns a block to the pool */
+    static void release(void *p) noexcept
+    {   Block *b = static_cast<Block *>(p);
+
+        b->next = free_;
+        free_ = b;
+        stats_.used--;
+    }
+
+    static const CosCoPoolStats_t &getStatistics(void) noexcept
+    {   return stats_;
+    }
+
+    /*! sets the function that reports a failed coroutine task, e.g. to
+        log the error or to reset; error is COS_CO_NO_FRAME or
+        COS_CO_EXCEPTION. NULL: a line by serPuts(). The task is
+        suspended when the hook returns. */
+    static void setFailedHook(void (*hook)(CosTask_t *pt, uint8_t error)) noexcept
+    {   failedHook_ = hook;
+    }
+
+    /*! PLEASE NOTE: This method is for internal use only! A coroutine
+        of the task failed: counts the error, reports it and suspends
+        the task. The other tasks go on. */
+    static void _failed(CosTask_t *pt, uint8_t error) noexcept
+    {
+        if(COS_CO_NO_FRAME == error)
+        {   stats_.callsFailed++;
+        }
+        else
+        {   stats_.exceptions++;
+        }
+        if(NULL != failedHook_)
+        {   failedHook_(pt, error);
+        }
+        else
+        {
+#if (COS_PLATFORM == PLATFORM_RENESAS_RX63N) || (COS_PLATFORM == PLATFORM_POSIX)
+            serPuts((char *)((COS_CO_NO_FRAME == error) ?
+                             "\r\ncoroutine task suspended: no frame for a call\r\n" :
+                             "\r\ncoroutine task suspended: exception\r\n"));
+#endif
+        }
+        COS_SuspendTask(pt);
+    }
+
+private:
+    union Block
+    {   Block *next;                                          /*!< link in the free list */
+        alignas(max_align_t) unsigned char bytes[COS_CORO_FRAME_BYTES];  /*!< frame */
+    };
+
+    static inline Block blocks_[COS_CORO_FRAMES];
+    static inline Block *free_ = NULL;     /*!< released blocks */
+    static inline uint16_t fresh_ = 0;     /*!< blocks_[fresh_...] never used */
+    static inline CosCoPoolStats_t stats_ = {0, 0, 0, 0, 0, 0};
+    static inline void (*failedHook_)(CosTask_t *pt, uint8_t error) = NULL;  /*!< see setFailedHook() */
+};
+
+
+
+/*!
+ ********************************************************************
+  @par Description
+  PLEASE NOTE: This struct is for internal use only! One per coroutine
+  task, pData of the COS task points to it.
+ ********************************************************************/
+typedef struct
+{
+        CosTask_t *pt;                  /*!< the COS task */
+        std::coroutine_handle<> root;   /*!< coroutine passed to CosCoSpawn() */
+        std::coroutine_handle<> active; /*!< innermost suspended coroutine */
+        uint8_t failed;                 /*!< 1 after an exception, never resumed again */
+} CosCoContext_t;
+
+
+
+/*!
+ ********************************************************************
+  @par Description
+  Return type of a coroutine task function. The object owns the
+  coroutine until it is passed to CosCoSpawn(), or until a calling
+  coroutine has awaited it.
+ ********************************************************************/
+class CosCoTask
+{
+public:
+    struct promise_type
+    {
+        CosCoContext_t own;                  /*!< context, if this is the root */
+        CosCoContext_t *ctx;                 /*!< context of the task */
+        std::coroutine_handle<> caller;      /*!< awaiting coroutine, if called */
+
+        promise_type() noexcept : own{NULL, {}, {}, 0}, ctx(&own), caller() {}
+
+        CosCoTask get_return_object() noexcept
+        {   return CosCoTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        static CosCoTask get_return_object_on_allocation_failure() noexcept
+        {   return CosCoTask();
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        /*! a called coroutine continues with its caller, unless it failed */
+        struct FinalAwaiter
+        {   bool await_ready() noexcept { return false; }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) noexcept
+            {   if(h.promise().caller && !h.promise().ctx->failed)
+                {   return h.promise().caller;
+                }
+                return std::noop_coroutine();
+            }
+            void await_resume() noexcept {}
+        };
+        FinalAwaiter final_suspend() noexcept { return {}; }
+
+        void return_void() noexcept {}
+        /*! reports the error and stops the task, see CosCoFramePool::setFailedHook() */
+        void unhandled_exception() noexcept
+        {   ctx->failed = 1;
+            CosCoFramePool::_failed(ctx->pt, COS_CO_EXCEPTION);
+        }
+
+        static void *operator new(size_t size) noexcept { return CosCoFramePool::alloc(size); }
+        static void operator delete(void *p) noexcept { CosCoFramePool::release(p); }
+    };
+
+    typedef std::coroutine_handle<promise_type> Handle_t;  /*!< handle of the coroutine */
+
+    CosCoTask() noexcept : h_() {}
+    CosCoTask(CosCoTask &&t) noexcept : h_(t.h_) { t.h_ = Handle_t(); }
+    ~CosCoTask()
+    {   if(h_)
+        {   h_.destroy();
+        }
+    }
+
+    /*! false if there was no frame for the coroutine */
+    bool valid(void) const noexcept { return static_cast<bool>(h_); }
+
+    /*! co_await f(...): runs the called coroutine within the task of the
+        caller; without frame see CosCoFramePool::setFailedHook() */
+    bool await_ready() const noexcept
+    {   return h_ && h_.done();
+    }
+    std::coroutine_handle<> await_suspend(Handle_t caller) noexcept
+    {   if(!h_)  /* no frame: the caller suspends, its task is stopped */
+        {   caller.promise().ctx->active = caller;
+            CosCoFramePool::_failed(caller.promise().ctx->pt, COS_CO_NO_FRAME);
+            return std::noop_coroutine();
+        }
+        h_.promise().ctx = caller.promise().ctx;
+        h_.promise().caller = caller;
+        return h_;
+    }
+    void await_resume() noexcept {}
+
+    /*! PLEASE NOTE: This method is for internal use only! Passes the coroutine to CosCoSpawn(). */
+    Handle_t _release(void) noexcept
+    {   Handle_t h = h_;
+        h_ = Handle_t();
+        return h;
+    }
+
+private:
+    explicit CosCoTask(Handle_t h) noexcept : h_(h) {}
+    CosCoTask(const CosCoTask &);             // not copyable, owns the frame
+    CosCoTask &operator=(const CosCoTask &);
+
+    Handle_t h_;
+};
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * PLEASE NOTE: This function is for internal use only! Task function of
+ * all coroutine tasks: resumes the coroutine that suspended last. When
+ * the coroutine of the task has returned, the frame is released and the
+ * task deleted, like COS_TASK_END() does. A task whose coroutine failed
+ * by an exception is not resumed again, e.g. after COS_ResumeTask().
+ ************************************************************************/
+inline void _coTaskFunc(CosTask_t *pt)
+{   CosCoContext_t *ctx = static_cast<CosCoContext_t *>(pt->pData);
+    std::coroutine_handle<> root = ctx->root;
+
+    if(ctx->failed)
+    {   COS_SuspendTask(pt);
+        return;
+    }
+    ctx->active.resume();
+    if(root.done())
+    {   pt->lineCnt = 0;
+        COS_DeleteTask(pt);
+        root.destroy();
+    }
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Creates a task that runs the coroutine. The coroutine starts when the
+ * scheduler calls the task for the first time.
+ *
+ * @param  prio            - IN, priority of the task
+ * @param  t               - IN, coroutine, e.g. producer(fifo, 1)
+ *
+ * @retval pointer to the task, NULL on error (no frame or no task)
+ ************************************************************************/
+inline CosTask_t *CosCoSpawn(uint8_t prio, CosCoTask &&t) noexcept
+{   CosCoTask::Handle_t h;
+    CosTask_t *pt;
+
+    if(!t.valid())
+    {   return NULL;
+    }
+    h = t._release();
+    h.promise().own.root = h;
+    h.promise().own.active = h;
+    pt = COS_CreateTask(prio, &h.promise().own, _coTaskFunc);
+    if(NULL == pt)
+    {   h.destroy();
+        return NULL;
+    }
+    h.promise().own.pt = pt;
+    return pt;
+}
+
+
+
+/*! PLEASE NOTE: for internal use only! Context of the task a coroutine runs in. */
+inline CosCoContext_t *_coSuspend(CosCoTask::Handle_t h) noexcept
+{   CosCoContext_t *ctx = h.promise().ctx;
+    ctx->active = h;
+    return ctx;
+}
+
+
+/*! co_await CosCoSleep(t): COS_TASK_SLEEP() */
+struct CosCoSleep
+{   CosTicks_t t_Ticks;  /*!< sleep time */
+
+    explicit CosCoSleep(CosTicks_t t) noexcept : t_Ticks(t) {}
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(CosCoTask::Handle_t h) const noexcept
+    {   _coSuspend(h)->pt->sleepTime_Ticks = t_Ticks;
+    }
+    void await_resume() const noexcept {}
+};
+
+/*! co_await CosCoYield(): COS_TASK_SCHEDULE() */
+inline CosCoSleep CosCoYield(void) noexcept
+{   return CosCoSleep(0);
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * co_await CosCoWait(&sem) or co_await sem: COS_SEM_WAIT(). The
+ * coroutine always suspends, like the macro returns: if the semaphore
+ * is free, the task stays ready and goes on at the next call, else it
+ * is blocked and COS_SEM_SIGNAL() passes the semaphore to it. So a loop
+ * of waits that never block, e.g. writes to a FIFO in overwrite mode,
+ * still lets the other tasks run.
+ ************************************************************************/
+struct CosCoWait
+{   CosSema_t *s;  /*!< semaphore */
+
+    explicit CosCoWait(CosSema_t *sem) noexcept : s(sem) {}
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(CosCoTask::Handle_t h) const noexcept
+    {   CosTask_t *pt = _coSuspend(h)->pt;
+
+        if(s->count <= 0)
+        {   pt->state = TASK_STATE_BLOCKED;
+            COS_TRACE_EVENT(COS_TRACE_BLOCK, pt, 0);
+            s->root_pt = _addTaskAtBeginningOfTaskList(s->root_pt, pt);
+        }
+        s->count--;
+    }
+    void await_resume() const noexcept {}
+};
+
+inline CosCoWait operator co_await(CosSema_t &s) noexcept
+{   return CosCoWait(&s);
+}
+
+
+/*! co_await CosCoRead(fifo): CosFifoBlockingRead(), returns the item */
+template<typename T, uint8_t N>
+struct CosCoFifoRead : CosCoWait
+{   CosFifo<T, N> *q;  /*!< FIFO */
+
+    explicit CosCoFifoRead(CosFifo<T, N> &fifo) noexcept : CosCoWait(&fifo.rSema), q(&fifo) {}
+    T await_resume() const
+    {   T item;
+        q->_read(item);
+        return item;
+    }
+};
+
+/*! co_await CosCoWrite(fifo, item): CosFifoBlockingWrite(). Yields also
+    if there is room, see CosCoWait: a producer loop does not starve the
+    other tasks. */
+template<typename T, uint8_t N>
+struct CosCoFifoWrite : CosCoWait
+{   CosFifo<T, N> *q;  /*!< FIFO */
+    T item;            /*!< copy of the item, written after the wait */
+
+    CosCoFifoWrite(CosFifo<T, N> &fifo, const T &x) : CosCoWait(&fifo.wSema), q(&fifo), item(x) {}
+    void await_resume() const
+    {   q->_write(item);
+    }
+};
+
+template<typename T, uint8_t N>
+inline CosCoFifoRead<T, N> CosCoRead(CosFifo<T, N> &fifo) noexcept
+{   return CosCoFifoRead<T, N>(fifo);
+}
+
+template<typename T, uint8_t N>
+inline CosCoFifoWrite<T, N> CosCoWrite(CosFifo<T, N> &fifo, const T &item)
+{   return CosCoFifoWrite<T, N>(fifo, item);
+}
+
+
+/*! co_await CosCoRead(&q, data): COS_FifoBlockingReadSingleSlot() */
+struct CosCoSlotRead : CosCoWait
+{   CosFifo_t *q;  /*!< FIFO */
+    void *data;    /*!< slot buffer, slotSize bytes */
+
+    CosCoSlotRead(CosFifo_t *fifo, void *d) noexcept : CosCoWait(&fifo->rSema), q(fifo), data(d)
+    {   FifoStatCode(_qStatBeforeWait(q, &q->rSema););
+    }
+    void await_resume() const noexcept
+    {   _qReadSingleSlot(q, static_cast<char *>(data));
+    }
+};
+
+/*! co_await CosCoWrite(&q, data): COS_FifoBlockingWriteSingleSlot().
+    Yields also in overwrite mode or if there is room, see CosCoWait. */
+struct CosCoSlotWrite : CosCoWait
+{   CosFifo_t *q;      /*!< FIFO */
+    const void *data;  /*!< slot to write, slotSize bytes */
+
+    CosCoSlotWrite(CosFifo_t *fifo, const void *d) noexcept : CosCoWait(&fifo->wSema), q(fifo), data(d)
+    {   FifoStatCode(_qStatBeforeWait(q, &q->wSema););
+    }
+    void await_resume() const noexcept
+    {   _qWriteSingleSlot(q, static_cast<const char *>(data));
+    }
+};
+
+inline CosCoSlotRead CosCoRead(CosFifo_t *q, void *data) noexcept
+{   return CosCoSlotRead(q, data);
+}
+
+inline CosCoSlotWrite CosCoWrite(CosFifo_t *q, const void *data) noexcept
+{   return CosCoSlotWrite(q, data);
+}
+
+
+#endif  // belongs to #ifndef at top of file...
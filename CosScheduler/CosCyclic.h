@@ -0,0 +1,378 @@
+/*!
+ ********************************************************************
+   @file            CosCyclic.h
+   @par Project   : co-operative Scheduler
+   @par Module    : Cyclic executive with a static schedule table
+
+   @brief  Table driven alternative to COS_RunScheduler() for builds
+           that must not take scheduling decisions at run time.
+
+   A task set is declared as a constexpr array of CosCyclicTask_t with
+   period and release offset of every task. COS_CYCLIC_SCHEDULE()
+   builds the schedule table from it at compile time:
+
+   - minor frame: greatest common divisor of all periods and offsets
+   - major frame: least common multiple of all periods
+   - for every minor frame of the major frame, the list of task
+     functions released at the start of that frame, in the order of
+     the task set
+
+   CosCyclicExecutive::run() then simply walks through the table: it
+   calls the functions of a frame, waits for the start of the next
+   frame and starts again with the first frame after the major frame.
+   There is no list scan and no priority comparison, the dispatch cost
+   of a frame only depends on the number of its table entries. The
+   largest number of entries per frame is available at compile time
+   (maxEntriesPerFrame), the longest measured frame and the number of
+   frame overruns at run time (CosCyclicStats_t).
+
+   The task functions run to completion and take no arguments, the
+   macros COS_TASK_SLEEP() etc. can not be used. Do not mix the cyclic
+   executive with COS_RunScheduler() in one program.
+
+   The task set is checked by the compiler: periods must not be zero,
+   offsets must be less than the period and all times must be
+   multiples of COS_MICROSEC_PER_TICK. The table may have up to 65535
+   frames and 65535 entries.
+
+   A C++14 compiler is required (constexpr loops).
+
+
+   @par Author    : Ernst Forgber (Fgb)
+   @par Company   : Hochschule Hannover - University of Applied Sciences and Arts, Germany
+   @par Department: Faculty 1
+
+ ********************************************************************
+
+   @par History   :
+   @verbatim
+   Version | Date        | Author  | Change Description
+   0.0     | 18.10. 2026 | Fgb     | First Version
+   @endverbatim
+
+ ********************************************************************/
+/**************************************************************************
+
+Copyright 2026 Ernst Forgber
+
+
+This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+
+#ifndef cos_cyclic_oop_h_
+#define cos_cyclic_oop_h_
+
+#include <stddef.h>  // for size_t
+
+extern "C" {
+#include "utility/cos_configure.h"
+#include "utility/cos_systime.h"
+}
+
+
+typedef void (*CosCyclicFunc_t)(void);  /*!< task function of the cyclic executive */
+
+/*! one task of a cyclic task set */
+typedef struct
+{
+        CosCyclicFunc_t func;  /*!< called once per period, runs to completion */
+        uint32_t period_us;    /*!< period in microseconds */
+        uint32_t offset_us;    /*!< release time within the period in microseconds */
+} CosCyclicTask_t;
+
+/*! run time statistics of CosCyclicExecutive */
+typedef struct
+{
+        uint32_t majorCycles;       /*!< number of completed major frames */
+        uint32_t overruns;          /*!< minor frames that ended after their deadline */
+        CosTicks_t maxFrame_Ticks;  /*!< longest minor frame, measured from its start */
+} CosCyclicStats_t;
+
+
+
+/*! greatest common divisor, gcd(0,b) == b */
+constexpr uint64_t _cyclicGcd(uint64_t a, uint64_t b)
+{   return (b == 0) ? a : _cyclicGcd(b, a % b);
+}
+
+
+/*!
+ ********************************************************************
+  @par Description
+  Length of the minor frame in microseconds, 0 if the task set is
+  invalid.
+ ********************************************************************/
+template<size_t N>
+constexpr uint64_t CosCyclicMinorFrame_us(const CosCyclicTask_t (&t)[N])
+{   uint64_t g = 0;
+    for(size_t i = 0; i < N; i++)
+    {   if((t[i].func == NULL) || (t[i].period_us == 0) || (t[i].offset_us >= t[i].period_us)
+           || (t[i].period_us % COS_MICROSEC_PER_TICK != 0)
+           || (t[i].offset_us % COS_MICROSEC_PER_TICK != 0))
+        {   return 0;
+        }
+        g = _cyclicGcd(g, t[i].period_us);
+        g = _cyclicGcd(g, t[i].offset_us);
+    }
+    if(g / COS_MICROSEC_PER_TICK > (CosTicks_t)(-1) / 2)
+    {   return 0;  // frame overruns could not be detected
+    }
+    return g;
+}
+
+
+/*!
+ ********************************************************************
+  @par Description
+  Length of the major frame in microseconds, 0 if the task set is
+  invalid or if the major frame is longer than 2^32 microseconds.
+ ********************************************************************/
+template<size_t N>
+constexpr uint64_t CosCyclicMajorFrame_us(const CosCyclicTask_t (&t)[N])
+{   uint64_t l = 1;
+    if(CosCyclicMinorFrame_us(t) == 0)
+    {   return 0;
+    }
+    for(size_t i = 0; i < N; i++)
+    {   l = l / _cyclicGcd(l, t[i].period_us) * t[i].period_us;
+        if(l > 0xFFFFFFFFUL)
+        {   return 0;
+        }
+    }
+    return l;
+}
+
+
+/*! number of minor frames per major frame, 0 if the task set is invalid */
+template<size_t N>
+constexpr uint32_t CosCyclicFrameCount(const CosCyclicTask_t (&t)[N])
+{   return (CosCyclicMajorFrame_us(t) == 0) ? 0 :
+           (uint32_t)(CosCyclicMajorFrame_us(t) / CosCyclicMinorFrame_us(t));
+}
+
+
+/*! number of task activations per major frame, 0 if the task set is invalid */
+template<size_t N>
+constexpr uint32_t CosCyclicEntryCount(const CosCyclicTask_t (&t)[N])
+{   uint32_t n = 0;
+    for(size_t i = 0; i < N; i++)
+    {   n += (CosCyclicMajorFrame_us(t) == 0) ? 0 :
+             (uint32_t)(CosCyclicMajorFrame_us(t) / t[i].period_us);
+    }
+    return n;
+}
+
+
+
+/*!
+ ********************************************************************
+  @par Description
+  Static schedule table. Frame f calls the functions
+  entry[frameStart[f]] .. entry[frameStart[f+1]-1]. Objects should be
+  declared with COS_CYCLIC_SCHEDULE(), which computes the template
+  arguments from the task set and makes the table a compile time
+  constant.
+ ********************************************************************/
+template<uint32_t NFrames, uint32_t NEntries>
+class CosCyclicSchedule
+{
+    static_assert(NFrames > 0, "CosCyclic: invalid task set (period 0, offset >= period, "
+                               "time not a multiple of COS_MICROSEC_PER_TICK, or major frame too long)");
+    static_assert(NFrames <= 0xFFFF, "CosCyclic: too many minor frames, choose harmonic periods");
+    static_assert(NEntries <= 0xFFFF, "CosCyclic: too many table entries");
+
+public:
+    static constexpr uint32_t frames = NFrames;    /*!< minor frames per major frame */
+    static constexpr uint32_t entries = NEntries;  /*!< task activations per major frame */
+
+    CosTicks_t minorFrame_Ticks;         /*!< length of a minor frame */
+    uint16_t maxEntriesPerFrame;         /*!< most task activations in one frame */
+    uint16_t frameStart[NFrames + 1];    /*!< first entry of each frame */
+    CosCyclicFunc_t entry[NEntries];     /*!< task functions in calling order */
+
+    /*!
+     ****************************************************************
+      @par Description
+      Builds the table. The task set has to be the one the template
+      arguments were computed from.
+
+      @param  t - IN, task set
+     ****************************************************************/
+    template<size_t N>
+    constexpr explicit CosCyclicSchedule(const CosCyclicTask_t (&t)[N])
+        : minorFrame_Ticks(0), maxEntriesPerFrame(0), frameStart(), entry()
+    {   const uint64_t minor_us = CosCyclicMinorFrame_us(t);
+        uint16_t e = 0;
+
+        minorFrame_Ticks = (CosTicks_t)(minor_us / COS_MICROSEC_PER_TICK);
+        for(uint32_t f = 0; f < NFrames; f++)
+        {   const uint64_t start_us = f * minor_us;
+            frameStart[f] = e;
+            for(size_t i = 0; i < N; i++)
+            {   if((start_us + t[i].period_us - t[i].offset_us) % t[i].period_us == 0)
+                {   entry[e++] = t[i].func;  // released at the start of frame f
+                }
+            }
+            if(e - frameStart[f] > maxEntriesPerFrame)
+            {   maxEntriesPerFrame = (uint16_t)(e - frameStart[f]);
+            }
+        }
+        frameStart[NFrames] = e;
+    }
+};
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Declares the compile time schedule table 'name' for the constexpr
+ * task set array 'taskSet'.
+ *
+ * @par Macro parameters: (name, const CosCyclicTask_t taskSet[])
+ *
+ * @param  name            - IN, name of the table object
+ * @param  taskSet         - IN, constexpr array of CosCyclicTask_t
+ ************************************************************************/
+#define COS_CYCLIC_SCHEDULE(name, taskSet) \
+    constexpr CosCyclicSchedule<CosCyclicFrameCount(taskSet), \
+                                CosCyclicEntryCount(taskSet)> name(taskSet)
+
+
+
+/*!
+ ********************************************************************
+  @par Description
+  Table driven dispatcher. run() replaces COS_RunScheduler(): it calls
+  the task functions of one minor frame after the other and waits for
+  the start of the next frame in between. Frames are started on a
+  fixed time grid, after an overrun the following frames are started
+  immediately until the executive is back on time. With virtual time
+  (COS_VIRTUAL_TIME, see cos_systime.c) the clock jumps to the start
+  of the next frame instead of waiting.
+
+  @par Code example:
+  @verbatim
+void readSensors(void)  { ... }
+void controlLoop(void)  { ... }
+void updateDisplay(void){ ... }
+
+constexpr CosCyclicTask_t taskSet[] =
+{   // function      period_us  offset_us
+    { readSensors,     5000UL,     0UL },
+    { controlLoop,    10000UL,  2500UL },
+    { updateDisplay, 100000UL,  5000UL },
+};
+COS_CYCLIC_SCHEDULE(schedule, taskSet);     // minor frame 2.5 ms, 40 frames
+static_assert(schedule.maxEntriesPerFrame <= 2, "frame too busy");
+
+CosCyclicExecutive<decltype(schedule)> executive(schedule);
+
+int main(void)
+{   _initSystemTime();
+    executive.run();                         // returns after stop()
+    ...
+}
+  @endverbatim
+ ********************************************************************/
+template<class Schedule>
+class CosCyclicExecutive
+{
+public:
+    /*! @param s - IN, schedule table, usually declared by COS_CYCLIC_SCHEDULE() */
+    explicit CosCyclicExecutive(const Schedule &s) : schedule_(s), stop_(0)
+    {   resetStatistics();
+    }
+
+    /*!
+     ****************************************************************
+      @par Description
+      Runs the schedule until stop() is called. The first frame starts
+      immediately, stop() takes effect at the end of the current frame.
+     ****************************************************************/
+    void run(void)
+    {   const CosTicks_t minor = schedule_.minorFrame_Ticks;
+        CosTicks_t frameBegin = _gettime_Ticks();
+
+        stop_ = 0;
+        while(!stop_)
+        {   for(uint16_t f = 0; f < Schedule::frames; f++)
+            {   const uint16_t last = schedule_.frameStart[f + 1];
+                CosTicks_t used;
+
+                for(uint16_t e = schedule_.frameStart[f]; e < last; e++)
+                {   schedule_.entry[e]();
+                }
+                used = (CosTicks_t)(_gettime_Ticks() - frameBegin);
+                if(used > stats_.maxFrame_Ticks)
+                {   stats_.maxFrame_Ticks = used;
+                }
+                if(used > minor)
+                {   stats_.overruns++;
+                }
+#if COS_VIRTUAL_TIME
+                if(used < minor)
+                {   _setVirtualTime_Ticks((CosTicks_t)(frameBegin + minor));
+                }
+#else
+                while((CosTicks_t)(_gettime_Ticks() - frameBegin) < minor)
+                {   // wait for the start of the next frame
+                }
+#endif
+                frameBegin += minor;
+                if(stop_)
+                {   return;
+                }
+            }
+            stats_.majorCycles++;
+        }
+    }
+
+    /*! makes run() return at the end of the current minor frame */
+    void stop(void) { stop_ = 1; }
+
+    /*! statistics since construction or the last resetStatistics() */
+    const CosCyclicStats_t &getStatistics(void) const { return stats_; }
+
+    /*! clears the statistics */
+    void resetStatistics(void)
+    {   stats_.majorCycles = 0;
+        stats_.overruns = 0;
+        stats_.maxFrame_Ticks = 0;
+    }
+
+private:
+    CosCyclicExecutive(const CosCyclicExecutive &);  // not copyable
+    CosCyclicExecutive &operator=(const CosCyclicExecutive &);
+
+    const Schedule &schedule_;  /*!< compile time schedule table */
+    volatile uint8_t stop_;     /*!< set by stop() */
+    CosCyclicStats_t stats_;    /*!< run time statistics */
+};
+
+
+#endif  // belongs to #ifndef at top of file...
@@ -0,0 +1,289 @@
+/*!
+ ********************************************************************
+   @file            CosFifo.h
+   @par Project   : co-operative Scheduler
+   @par Module    : Typed FIFO for the C++ layer of COS
+
+   @brief  openCM / Arduino version of the data-FIFO (queue), typed at
+           compile time.
+
+   The C-version of the FIFO (see cos_data_fifo.h) stores slots of a
+   run-time 'slotSize' and copies them with memcpy(). CosFifo<T,N> knows
+   element type T and capacity N at compile time: the slot copy is
+   inlined (a fixed size memcpy() for trivially copyable types), the
+   index mask is a constant and wrong element types are rejected by the
+   compiler. The buffer is part of the object, no malloc() is used.
+
+   Capacity N has to be a power of two. Since the semaphore counter of
+   COS is an 8 bit value, N is limited to 64 slots.
+
+   A C++11 compiler is required (static_assert, constexpr).
+
+
+   @par Author    : Ernst Forgber (Fgb)
+   @par Company   : Hochschule Hannover - University of Applied Sciences and Arts, Germany
+   @par Department: Faculty 1
+
+ ********************************************************************
+
+   @par History   :
+   @verbatim
+   Version | Date        | Author  | Change Description
+   0.0     | 18.10. 2026 | Fgb     | First Version
+   0.1     | 18.10. 2026 | Fgb     | trace events
+   0.2     | 18.10. 2026 | Fgb     | std::is_trivially_copyable instead of builtin
+   @endverbatim
+
+ ********************************************************************/
+/**************************************************************************
+
+Copyright 2026 Ernst Forgber
+
+
+This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+
+#ifndef cos_fifo_oop_h_
+#define cos_fifo_oop_h_
+
+#include <string.h>  // for memcpy()
+
+extern "C" {
+#include "utility/cos_semaphore.h"
+}
+
+#if COS_PLATFORM == PLATFORM_ARDUINO
+    /* the AVR core has no <type_traits>, use the compiler builtin */
+    #define COS_IS_TRIVIALLY_COPYABLE(T)  __has_trivial_copy(T)
+#else
+    #include <type_traits>
+    #define COS_IS_TRIVIALLY_COPYABLE(T)  std::is_trivially_copyable<T>::value
+#endif
+
+
+/*!
+ ********************************************************************
+  @par Description
+  Copies a single slot. The general version uses the assignment
+  operator of T, the specialisation for trivially copyable types uses
+  memcpy() with a size known at compile time, which the compiler
+  unrolls into a few load/store instructions.
+ ********************************************************************/
+template<typename T, bool isTrivial = COS_IS_TRIVIALLY_COPYABLE(T)>
+struct CosFifoSlotCopy
+{
+    static inline void copy(T &dst, const T &src) { dst = src; }
+};
+
+/*! specialisation of CosFifoSlotCopy for trivially copyable types */
+template<typename T>
+struct CosFifoSlotCopy<T, true>
+{
+    static inline void copy(T &dst, const T &src) { memcpy(&dst, &src, sizeof(T)); }
+};
+
+
+
+/*!
+ ********************************************************************
+  @par Description
+  FIFO for N elements of type T. Tasks use the blocking macros
+  CosFifoBlockingWrite() and CosFifoBlockingRead(), the methods
+  tryWrite() and tryRead() never block.
+
+  @par Code example:
+  @verbatim
+typedef struct { int16_t x, y, z; } Vector_t;
+
+CosFifo<Vector_t, 8> fifo_1;
+
+void producerTask(CosTask_t *pt)
+{   static Vector_t vec = {1,1,1};
+    COS_TASK_BEGIN(pt);
+    while(1)
+    {   vec.x++;
+        CosFifoBlockingWrite(pt, &fifo_1, vec);
+        COS_TASK_SLEEP(pt,_milliSecToTicks(200));
+    }
+    COS_TASK_END(pt);
+}
+
+void consumerTask(CosTask_t *pt)
+{   static Vector_t vec;
+    COS_TASK_BEGIN(pt);
+    while(1)
+    {   CosFifoBlockingRead(pt, &fifo_1, vec);
+        ...
+    }
+    COS_TASK_END(pt);
+}
+  @endverbatim
+ ********************************************************************/
+template<typename T, uint8_t N>
+class CosFifo
+{
+    static_assert(N > 0, "CosFifo: capacity must be at least one slot");
+    static_assert((N & (N - 1)) == 0, "CosFifo: capacity must be a power of two");
+    static_assert(N <= 64, "CosFifo: capacity is limited by the 8 bit semaphore counter");
+
+public:
+    static constexpr uint8_t capacity = N;      /*!< number of slots */
+    static constexpr uint8_t indexMask = N - 1; /*!< wraps read and write index */
+
+    CosSema_t rSema;  /*!< wait at this semaphore when reading */
+    CosSema_t wSema;  /*!< wait at this semaphore when writing */
+
+    /*! creates an empty FIFO */
+    CosFifo() : rIndex_(0), wIndex_(0), usedSlots_(0)
+    {   COS_SemCreate(&rSema, 0);   // nothing to read yet
+        COS_SemCreate(&wSema, N);   // all slots are still free
+    }
+
+    /*! frees the lists of waiting tasks, tasks are not deleted */
+    ~CosFifo()
+    {   COS_SemDestroy(&rSema);
+        COS_SemDestroy(&wSema);
+    }
+
+    bool    isEmpty(void)  const { return usedSlots_ == 0; }  /*!< true if FIFO is empty */
+    bool    isFull(void)   const { return usedSlots_ == N; }  /*!< true if FIFO is full */
+    uint8_t usedSlots(void) const { return usedSlots_; }      /*!< number of used slots */
+
+    /*!
+     ****************************************************************
+      @par Description
+      Writes an item without blocking. The write semaphore is updated
+      as if the caller had passed CosFifoBlockingWrite().
+
+      @param  item - IN, item to be stored
+      @retval true if written, false if the FIFO is full
+     ****************************************************************/
+    bool tryWrite(const T &item)
+    {   if(wSema.count <= 0)  // full, or free slot promised to a woken writer
+        {   return false;
+        }
+        (wSema.count)--;  // same as passing COS_SEM_WAIT()
+        _write(item);
+        return true;
+    }
+
+    /*!
+     ****************************************************************
+      @par Description
+      Reads an item without blocking. The read semaphore is updated
+      as if the caller had passed CosFifoBlockingRead().
+
+      @param  item - OUT, item read from the FIFO
+      @retval true if read, false if the FIFO is empty
+     ****************************************************************/
+    bool tryRead(T &item)
+    {   if(rSema.count <= 0)  // empty, or item promised to a woken reader
+        {   return false;
+        }
+        (rSema.count)--;  // same as passing COS_SEM_WAIT()
+        _read(item);
+        return true;
+    }
+
+    /*!
+     ****************************************************************
+      @par Description
+      PLEASE NOTE: This method is for internal use only! It is called
+      by CosFifoBlockingWrite() after passing the write semaphore, a
+      free slot is guaranteed.
+     ****************************************************************/
+    void _write(const T &item)
+    {   CosFifoSlotCopy<T>::copy(buffer_[wIndex_], item);
+        wIndex_ = (wIndex_ + 1) & indexMask;  /* circular buffer */
+        usedSlots_++;
+        COS_TRACE_EVENT(COS_TRACE_FIFO_WRITE, NULL, usedSlots_);
+        COS_SEM_SIGNAL(&rSema);  // unblock tasks that wait for reading
+    }
+
+    /*!
+     ****************************************************************
+      @par Description
+      PLEASE NOTE: This method is for internal use only! It is called
+      by CosFifoBlockingRead() after passing the read semaphore, an
+      item is guaranteed.
+     ****************************************************************/
+    void _read(T &item)
+    {   CosFifoSlotCopy<T>::copy(item, buffer_[rIndex_]);
+        rIndex_ = (rIndex_ + 1) & indexMask;  /* circular buffer */
+        usedSlots_--;
+        COS_TRACE_EVENT(COS_TRACE_FIFO_READ, NULL, usedSlots_);
+        COS_SEM_SIGNAL(&wSema);  // unblock tasks that wait for writing
+    }
+
+private:
+    CosFifo(const CosFifo &);            // not copyable, tasks may wait at it
+    CosFifo &operator=(const CosFifo &);
+
+    T       buffer_[N];  /*!< slot storage */
+    uint8_t rIndex_;     /*!< next slot to read */
+    uint8_t wIndex_;     /*!< next slot to write */
+    uint8_t usedSlots_;  /*!< number of used slots */
+};
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Typed version of COS_FifoBlockingWriteSingleSlot(). If there is no
+ * free slot, the task *pt is blocked until another task reads from the
+ * FIFO. May only be used directly in the task function.
+ *
+ * @par Macro parameters: (CosTask_t *pt, CosFifo<T,N> *q, const T &item)
+ *
+ * @param  pt              - IN/OUT, pointer to task struct
+ * @param  q               - IN/OUT, pointer to FIFO object
+ * @param  item            - IN, item to be written
+ ************************************************************************/
+#define CosFifoBlockingWrite(pt, q, item)  COS_SEM_WAIT(&((q)->wSema),(pt)); \
+                                           (q)->_write(item)
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Typed version of COS_FifoBlockingReadSingleSlot(). If the FIFO is
+ * empty, the task *pt is blocked until another task writes to the
+ * FIFO. May only be used directly in the task function.
+ *
+ * @par Macro parameters: (CosTask_t *pt, CosFifo<T,N> *q, T &item)
+ *
+ * @param  pt              - IN/OUT, pointer to task struct
+ * @param  q               - IN/OUT, pointer to FIFO object
+ * @param  item            - OUT, item read from the FIFO
+ ************************************************************************/
+#define CosFifoBlockingRead(pt, q, item)   COS_SEM_WAIT(&((q)->rSema),(pt)); \
+                                           (q)->_read(item)
+
+
+#endif  // belongs to #ifndef at top of file...
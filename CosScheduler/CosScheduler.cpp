@@ -31,6 +31,16 @@
    0.6     | 31.05. 2016 | Fgb       | Bugfix: Sleep-Zeit im Scheduler auf 0
                                      | zureuckgesetzt, siehe dort
    0.7     | 11.11.2016  | Fgb       | port to openCM (ARM Cortex-M3)
+   0.8     | 18.10.2026  | Fgb       | 32 bit time base, CosRunScheduler() calls
+                                     | COS_RunScheduler()
+   0.9     | 18.10.2026  | Fgb       | CosStopScheduler()
+   0.10    | 18.10.2026  | Fgb       | task statistics
+   0.11    | 18.10.2026  | Fgb       | CosGetCPULoadPerMille()
+   0.12    | 18.10.2026  | Fgb       | wake-up latency histograms
+   0.13    | 18.10.2026  | Fgb       | heap statistics
+   0.14    | 18.10.2026  | Fgb       | execution budget, watchdog kick
+   0.15    | 18.10.2026  | Fgb       | counters of the scheduler loop
+   0.16    | 18.10.2026  | Fgb       | CosCreateTaskWithData()
    @endverbatim
 
  ********************************************************************/
@@ -52,15 +62,15 @@ This program is free software: you can redistribute it and/or modify
     You should have received a copy of the GNU General Public License
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
-    Dieses Programm ist Freie Software: Sie knnen es unter den Bedingungen
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
     der GNU General Public License, wie von der Free Software Foundation,
     Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
-    verffentlichten Version, weiterverbreiten und/oder modifizieren.
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
 
-    Dieses Programm wird in der Hoffnung, dass es ntzlich sein wird, aber
-    OHNE JEDE GEWHRLEISTUNG, bereitgestellt; sogar ohne die implizite
-    Gewhrleistung der MARKTFHIGKEIT oder EIGNUNG FR EINEN BESTIMMTEN ZWECK.
-    Siehe die GNU General Public License fr weitere Details.
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
 
     Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
     Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.*****************************************************************************/
@@ -73,7 +83,9 @@ This program is free software: you can redistribute it and/or modify
   \section PlatformSecLabel COS on platform openCM / Arduino
   This is COS for platforms openCM and Arduino. On these platforms, no
   further hardware resources as timers or interrupts are required.
-  COS uses millis() as system clock. See documentation of file
+  On openCM, COS uses the DWT cycle counter of the Cortex-M3 as system
+  clock, on Arduino micros(). The length of a tick is set in
+  cos_configure.h. See documentation of file
   CosScheduler.cpp for an overview of the functionality COS provides.
 
   \section InstallationSecLabel  Installation
@@ -165,6 +177,7 @@ void loop()
  ********************************************************************/
 int8_t CosInitTaskList(void)
 {
+    _initSystemTime();  // start the system clock
     return COS_InitTaskList();
 }
 
@@ -228,6 +241,22 @@ void loop()
 }
 
 
+/*!
+ ********************************************************************
+  @par Description
+       Wrapper for function COS_CreateTaskWithData(), see there for
+       details. CosCreateTask<Ctx>() in CosTaskContext.h builds a typed
+       context on top of it.
+
+  @see
+  @arg  COS_CreateTaskWithData()
+ ********************************************************************/
+CosTask_t* CosCreateTaskWithData(uint8_t prio, uint16_t dataSize, void (*func) (CosTask_t *))
+{
+    return COS_CreateTaskWithData(prio, dataSize, func);
+}
+
+
 /*!
  ********************************************************************
   @par Description
@@ -359,6 +388,23 @@ int8_t CosGetCPULoadInPercent(void)
 }
 
 
+/*!
+ ********************************************************************
+  @par Description
+       Wrapper for function COS_GetCPULoadPerMille(), see there for details.
+
+  @see
+  @arg  COS_GetCPULoadPerMille()
+
+  @param  window - IN, COS_LOAD_100MS, COS_LOAD_1S or COS_LOAD_10S
+  @retval CPU load in 1/1000
+ ********************************************************************/
+uint16_t CosGetCPULoadPerMille(uint8_t window)
+{
+    return COS_GetCPULoadPerMille(window);
+}
+
+
 /*!
  ********************************************************************
   @par Description
@@ -387,6 +433,19 @@ void CosPrintTaskList(void)
         Serial.print("\r\ntask:");  Serial.print((uint32_t) pt->task_pt);
         Serial.print("\r\nState:"); Serial.print(pt->task_pt->state);
         Serial.print("\r\nPrio:");  Serial.print(pt->task_pt->prio);
+  #if COS_TASK_STATISTICS
+        Serial.print("\r\nRuns:");  Serial.print(pt->task_pt->stats.activations);
+        Serial.print("\r\nAvg:");   Serial.print(COS_TaskStatsAverage_Ticks(&pt->task_pt->stats));
+        Serial.print("\r\nMax:");   Serial.print(pt->task_pt->stats.max_Ticks);
+  #endif
+  #if COS_TASK_LATENCY
+        Serial.print("\r\nLat p50:"); Serial.print(COS_TaskLatencyPercentile_Ticks(&pt->task_pt->latency, 500));
+        Serial.print(" p99:");         Serial.print(COS_TaskLatencyPercentile_Ticks(&pt->task_pt->latency, 990));
+        Serial.print(" max:");         Serial.print(pt->task_pt->latency.max_Ticks);
+  #endif
+  #if COS_TASK_BUDGET
+        Serial.print("\r\nOverruns:"); Serial.print(pt->task_pt->budgetOverruns);
+  #endif
         Serial.print("\r\n");
 #endif
 
@@ -394,6 +453,19 @@ void CosPrintTaskList(void)
         SerialUSB.print("\r\ntask:");  SerialUSB.print((uint32_t) pt->task_pt);
         SerialUSB.print("\r\nState:"); SerialUSB.print(pt->task_pt->state);
         SerialUSB.print("\r\nPrio:");  SerialUSB.print(pt->task_pt->prio);
+  #if COS_TASK_STATISTICS
+        SerialUSB.print("\r\nRuns:");  SerialUSB.print(pt->task_pt->stats.activations);
+        SerialUSB.print("\r\nAvg:");   SerialUSB.print(COS_TaskStatsAverage_Ticks(&pt->task_pt->stats));
+        SerialUSB.print("\r\nMax:");   SerialUSB.print(pt->task_pt->stats.max_Ticks);
+  #endif
+  #if COS_TASK_LATENCY
+        SerialUSB.print("\r\nLat p50:"); SerialUSB.print(COS_TaskLatencyPercentile_Ticks(&pt->task_pt->latency, 500));
+        SerialUSB.print(" p99:");         SerialUSB.print(COS_TaskLatencyPercentile_Ticks(&pt->task_pt->latency, 990));
+        SerialUSB.print(" max:");         SerialUSB.print(pt->task_pt->latency.max_Ticks);
+  #endif
+  #if COS_TASK_BUDGET
+        SerialUSB.print("\r\nOverruns:"); SerialUSB.print(pt->task_pt->budgetOverruns);
+  #endif
         SerialUSB.print("\r\n");
 #endif
         pt = pt->next_pt;
@@ -409,12 +481,13 @@ void CosPrintTaskList(void)
 /*!
  ********************************************************************
   @par Description
-       Priority base scheduler for Arduino and
-       openCM. The task-list is sorted due to priority, scheduler will run
+       Wrapper for function COS_RunScheduler(), see there for details.
+       The task-list is sorted due to priority, scheduler will run
        the first task in the list that is in 'ready' state and has an expired
        'sleep time'. The scheduler run in an endless loop.
 
-
+  @see
+  @arg  COS_RunScheduler()
 
   @retval 0, this function runs in an endless loop
 
@@ -424,40 +497,203 @@ void CosPrintTaskList(void)
   @endverbatim
  ********************************************************************/
 int8_t CosRunScheduler(void)
-{   // Scheduler version for Arduino and openCM:
-    Node_t *pt=NULL;
-    uint16_t t_Ticks;
-
-    //DebugCode(_msg("RunScheduler,prio based\r\n"););
-
-    pt = COS_GetTaskListRootPointer(); /* first task, highest prio */
-    while(1) /* loop forever */
-    {   /* time to run? */
-        t_Ticks =millis();
-        /* time wrap around is ok, time difference will be right... */
-        if(((uint16_t)(t_Ticks - pt->task_pt->lastActivationTime_Ticks) >=
-             pt->task_pt->sleepTime_Ticks)&&
-            (pt->task_pt->state == TASK_STATE_READY))
-        {  pt->task_pt->lastActivationTime_Ticks = t_Ticks;
-           /*  when the task function runs to its very end, the task will be deleted:
-               it will be removed from the list, and the task struct will be freed,
-               i.e. pt->task_pt is no longer valid.
-           */
-           pt->task_pt->sleepTime_Ticks = 0;  // Bugfix 22.10.2015: sleep time must be specified by task!
-           pt->task_pt->func(pt->task_pt);  /* call task function, must not block! */
-           pt = COS_GetTaskListRootPointer(); /* next: check task with highest prio */
-        }
-        else
-        {  pt = pt->next_pt;  /* check next task in list */
-           if(NULL==pt)
-           {  pt = COS_GetTaskListRootPointer();  /* treat linear list as ring list */
-           }
-        }
-    }
-    return 0;
+{
+    return COS_RunScheduler();
+}
+
+
+
+/*!
+ ********************************************************************
+  @par Description
+       Wrapper for function COS_StopScheduler(), see there for details.
+       CosRunScheduler() returns after the current task function has
+       returned.
+
+  @see
+  @arg  COS_StopScheduler()
+ ********************************************************************/
+void CosStopScheduler(void)
+{
+    COS_StopScheduler();
+}
+
+
+#if COS_TASK_STATISTICS
+/*!
+ ********************************************************************
+  @par Description
+       Wrapper for function COS_GetTaskStatistics(), see there for details.
+
+  @see
+  @arg  COS_GetTaskStatistics(), COS_TaskStatsAverage_Ticks()
+ ********************************************************************/
+int8_t CosGetTaskStatistics(CosTask_t* task_pt, CosTaskStats_t *stats)
+{
+    return COS_GetTaskStatistics(task_pt, stats);
+}
+
+
+/*!
+ ********************************************************************
+  @par Description
+       Wrapper for function COS_ResetTaskStatistics(), see there for details.
+
+  @see
+  @arg  COS_ResetTaskStatistics()
+ ********************************************************************/
+int8_t CosResetTaskStatistics(CosTask_t* task_pt)
+{
+    return COS_ResetTaskStatistics(task_pt);
+}
+#endif
+
+
+#if COS_TASK_LATENCY
+/*!
+ ********************************************************************
+  @par Description
+       Wrapper for function COS_GetTaskLatency(), see there for details.
+
+  @see
+  @arg  COS_GetTaskLatency(), COS_TaskLatencyPercentile_Ticks()
+ ********************************************************************/
+int8_t CosGetTaskLatency(CosTask_t* task_pt, CosTaskLatency_t *lat)
+{
+    return COS_GetTaskLatency(task_pt, lat);
+}
+
+
+/*!
+ ********************************************************************
+  @par Description
+       Wrapper for function COS_ResetTaskLatency(), see there for details.
+
+  @see
+  @arg  COS_ResetTaskLatency()
+ ********************************************************************/
+int8_t CosResetTaskLatency(CosTask_t* task_pt)
+{
+    return COS_ResetTaskLatency(task_pt);
+}
+#endif
+
+
+#if COS_MEMORY_STATISTICS
+/*!
+ ********************************************************************
+  @par Description
+       Wrapper for function COS_GetMemoryStatistics(), see there for details.
+
+  @see
+  @arg  COS_GetMemoryStatistics(), COS_ResetMemoryPeak()
+ ********************************************************************/
+int8_t CosGetMemoryStatistics(CosMemStats_t *stats)
+{
+    return COS_GetMemoryStatistics(stats);
+}
+
+
+/*!
+ ********************************************************************
+  @par Description
+       Prints the heap counters of COS to the serial monitor on Arduino
+       and openCM, see COS_GetMemoryStatistics().
+ ********************************************************************/
+void CosPrintMemoryStatistics(void)
+{
+    CosMemStats_t m;
+
+    COS_GetMemoryStatistics(&m);
+#if COS_PLATFORM == PLATFORM_ARDUINO
+    Serial.print("\r\nHeap bytes:"); Serial.print(m.currentBytes);
+    Serial.print(" peak:");          Serial.print(m.peakBytes);
+    Serial.print("\r\nAllocs:");     Serial.print(m.allocations);
+    Serial.print(" frees:");         Serial.print(m.frees);
+    Serial.print(" failed:");        Serial.print(m.failed);
+    Serial.print("\r\n");
+#elif COS_PLATFORM == PLATFORM_OPEN_CM_9_04
+    SerialUSB.print("\r\nHeap bytes:"); SerialUSB.print(m.currentBytes);
+    SerialUSB.print(" peak:");          SerialUSB.print(m.peakBytes);
+    SerialUSB.print("\r\nAllocs:");     SerialUSB.print(m.allocations);
+    SerialUSB.print(" frees:");         SerialUSB.print(m.frees);
+    SerialUSB.print(" failed:");        SerialUSB.print(m.failed);
+    SerialUSB.print("\r\n");
+#else
+    COS_PrintMemoryStatistics();
+#endif
+}
+#endif
+
+
+#if COS_TASK_BUDGET
+/*!
+ ********************************************************************
+  @par Description
+       Wrapper for function COS_SetTaskBudget(), see there for details.
+
+  @see
+  @arg  COS_SetTaskBudget(), COS_GetBudgetViolations()
+ ********************************************************************/
+int8_t CosSetTaskBudget(CosTask_t* task_pt, CosTicks_t budget_Ticks, uint8_t action)
+{
+    return COS_SetTaskBudget(task_pt, budget_Ticks, action);
 }
 
 
+/*!
+ ********************************************************************
+  @par Description
+       Wrapper for function COS_SetBudgetHook(), see there for details.
+ ********************************************************************/
+void CosSetBudgetHook(CosBudgetHook_t hook)
+{
+    COS_SetBudgetHook(hook);
+}
+
+
+/*!
+ ********************************************************************
+  @par Description
+       Wrapper for function COS_SetWatchdogKick(), see there for details.
+ ********************************************************************/
+void CosSetWatchdogKick(void (*kick)(void))
+{
+    COS_SetWatchdogKick(kick);
+}
+#endif
+
+
+#if COS_SCHEDULER_COUNTERS
+/*!
+ ********************************************************************
+  @par Description
+       Wrapper for function COS_GetSchedulerCounters(), see there for
+       details. On Arduino, the reads of the system time are the calls
+       of micros().
+
+  @see
+  @arg  COS_GetSchedulerCounters(), COS_SchedulerRatePerSec()
+ ********************************************************************/
+int8_t CosGetSchedulerCounters(CosSchedCounters_t *c)
+{
+    return COS_GetSchedulerCounters(c);
+}
+
+
+/*!
+ ********************************************************************
+  @par Description
+       Wrapper for function COS_ResetSchedulerCounters(), see there for
+       details.
+ ********************************************************************/
+void CosResetSchedulerCounters(void)
+{
+    COS_ResetSchedulerCounters();
+}
+#endif
+
+
 } // extern "C"
 
 
@@ -48,15 +48,15 @@ This program is free software: you can redistribute it and/or modify
     You should have received a copy of the GNU General Public License
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
-    Dieses Programm ist Freie Software: Sie knnen es unter den Bedingungen
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
     der GNU General Public License, wie von der Free Software Foundation,
     Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
-    verffentlichten Version, weiterverbreiten und/oder modifizieren.
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
 
-    Dieses Programm wird in der Hoffnung, dass es ntzlich sein wird, aber
-    OHNE JEDE GEWHRLEISTUNG, bereitgestellt; sogar ohne die implizite
-    Gewhrleistung der MARKTFHIGKEIT oder EIGNUNG FR EINEN BESTIMMTEN ZWECK.
-    Siehe die GNU General Public License fr weitere Details.
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
 
     Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
     Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
@@ -88,19 +88,49 @@ extern "C" {
 #include "utility/cos_scheduler.h"
 #include "utility/cos_semaphore.h"
 #include "utility/cos_data_fifo.h"
+#include "utility/cos_msg_queue.h"
+#include "utility/cos_stream_buffer.h"
+#include "utility/cos_timer.h"
+#include "utility/cos_trace.h"
+#include "utility/cos_latency.h"
+#include "utility/cos_memory.h"
 
 void CosVersionInfo(void);
 
 // wrapper functions for Arduino and openCM
 int8_t CosInitTaskList(void);
 CosTask_t* CosCreateTask(uint8_t prio, void * pData, void (*func) (CosTask_t *));
+CosTask_t* CosCreateTaskWithData(uint8_t prio, uint16_t dataSize, void (*func) (CosTask_t *));
 int8_t CosDeleteTask(CosTask_t* task_pt);
 int8_t CosSuspendTask(CosTask_t* task_pt);
 int8_t CosResumeTask(CosTask_t* task_pt);
 int8_t CosSetTaskPrio(CosTask_t* task_pt,uint8_t taskPrio);
 int8_t CosRunScheduler(void);
+void   CosStopScheduler(void);
 void   CosPrintTaskList(void);
 int8_t CosGetCPULoadInPercent(void);
+uint16_t CosGetCPULoadPerMille(uint8_t window);
+#if COS_TASK_STATISTICS
+int8_t CosGetTaskStatistics(CosTask_t* task_pt, CosTaskStats_t *stats);
+int8_t CosResetTaskStatistics(CosTask_t* task_pt);
+#endif
+#if COS_TASK_LATENCY
+int8_t CosGetTaskLatency(CosTask_t* task_pt, CosTaskLatency_t *lat);
+int8_t CosResetTaskLatency(CosTask_t* task_pt);
+#endif
+#if COS_MEMORY_STATISTICS
+int8_t CosGetMemoryStatistics(CosMemStats_t *stats);
+void   CosPrintMemoryStatistics(void);
+#endif
+#if COS_TASK_BUDGET
+int8_t CosSetTaskBudget(CosTask_t* task_pt, CosTicks_t budget_Ticks, uint8_t action);
+void   CosSetBudgetHook(CosBudgetHook_t hook);
+void   CosSetWatchdogKick(void (*kick)(void));
+#endif
+#if COS_SCHEDULER_COUNTERS
+int8_t CosGetSchedulerCounters(CosSchedCounters_t *c);
+void   CosResetSchedulerCounters(void);
+#endif
 
 
 } // extern "C"
@@ -0,0 +1,195 @@
+/*!
+ ********************************************************************
+   @file            CosTaskContext.h
+   @par Project   : co-operative Scheduler
+   @par Module    : Typed per-task context for the C++ layer of COS
+
+   @brief  Task functions with a context object instead of static
+           variables.
+
+   Local variables of a task function do not survive COS_TASK_SLEEP()
+   etc., so tasks usually keep their state in static variables; then
+   the function can run as one task only. CosCreateTask<Ctx>() gives
+   every task its own object of type Ctx and passes it to the task
+   function by reference:
+
+   @verbatim
+struct Motor
+{   uint8_t  id;
+    uint16_t steps;
+    uint16_t n;      // loop counter survives COS_TASK_SLEEP()
+};
+
+void motorTask(CosTask_t *pt, Motor &m)
+{   COS_TASK_BEGIN(pt);
+    for(m.n = 0; m.n < m.steps; m.n++)
+    {   step(m.id);
+        COS_TASK_SLEEP(pt, _milliSecToTicks(10));
+    }
+    COS_TASK_END(pt);
+}
+...
+CosCreateTask(3, motorTask, Motor{1, 200});
+CosCreateTask(3, motorTask, Motor{2, 50});   // same function, own state
+   @endverbatim
+
+   The object is initialised with the remaining arguments of
+   CosCreateTask<Ctx>(): a Ctx like Motor{1, 200} is copied, other
+   arguments go to the constructor of Ctx, without arguments the object
+   is zero-initialised. (Values for the members of an aggregate Ctx are
+   better passed as Ctx{...}: forwarded, an int literal for a uint8_t
+   member is a narrowing conversion.) It lies in the memory block of the task
+   struct (COS_CreateTaskWithData()): one allocation per task, and
+   the data of the task the scheduler dispatches is next to its task
+   struct. The block is released by COS_DeleteTask() or COS_TASK_END().
+   COS does not call destructors, so Ctx has to be trivially
+   destructible.
+
+   A C++11 compiler is required (variadic templates, static_assert).
+
+
+   @par Author    : Ernst Forgber (Fgb)
+   @par Company   : Hochschule Hannover - University of Applied Sciences and Arts, Germany
+   @par Department: Faculty 1
+
+ ********************************************************************
+
+   @par History   :
+   @verbatim
+   Version | Date        | Author  | Change Description
+   0.0     | 18.10. 2026 | Fgb     | First Version
+   0.1     | 18.10. 2026 | Fgb     | std::is_trivially_destructible instead of builtin
+   @endverbatim
+
+ ********************************************************************/
+/**************************************************************************
+
+Copyright 2026 Ernst Forgber
+
+
+This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+
+
+#ifndef cos_task_context_oop_h_
+#define cos_task_context_oop_h_
+
+extern "C" {
+#include "utility/cos_configure.h"
+#include "utility/cos_scheduler.h"
+}
+
+#if COS_PLATFORM == PLATFORM_ARDUINO
+    #include <new.h>  // placement new of the Arduino core
+    /* the AVR core has no <type_traits>, use the compiler builtin */
+    #define COS_IS_TRIVIALLY_DESTRUCTIBLE(T)  __has_trivial_destructor(T)
+#else
+    #include <new>
+    #include <type_traits>
+    #define COS_IS_TRIVIALLY_DESTRUCTIBLE(T)  std::is_trivially_destructible<T>::value
+#endif
+
+
+
+/*!
+ ********************************************************************
+  @par Description
+  PLEASE NOTE: This struct is for internal use only! User data of a
+  task created by CosCreateTask<Ctx>(): typed task function and context.
+ ********************************************************************/
+template<typename Ctx>
+struct CosTaskContext
+{
+    void (*fn)(CosTask_t *, Ctx &);  /*!< typed task function */
+    Ctx ctx;                         /*!< context of the task */
+
+    template<typename... Args>
+    CosTaskContext(void (*f)(CosTask_t *, Ctx &), Args &&... init)
+        : fn(f), ctx{static_cast<Args &&>(init)...}
+    {
+    }
+};
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * PLEASE NOTE: This function is for internal use only! Task function
+ * of all tasks with context type Ctx: calls the typed task function.
+ * After COS_TASK_END() the context is gone, it is not touched again.
+ ************************************************************************/
+template<typename Ctx>
+void _cosTaskContextFunc(CosTask_t *pt)
+{   CosTaskContext<Ctx> *c = static_cast<CosTaskContext<Ctx> *>(pt->pData);
+    c->fn(pt, c->ctx);
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Creates a task with its own context object of type Ctx, see top of
+ * file. pData of the task points to internal data, use the reference
+ * passed to the task function or CosTaskGetContext<Ctx>().
+ *
+ * @param  prio            - IN, task priority, see COS_CreateTask()
+ * @param  fn              - IN, task function
+ * @param  init            - IN, Ctx object or constructor arguments, may be empty
+ *
+ * @retval pointer to the task, NULL on error
+ ************************************************************************/
+template<typename Ctx, typename... Args>
+CosTask_t *CosCreateTask(uint8_t prio, void (*fn)(CosTask_t *, Ctx &), Args &&... init)
+{   CosTask_t *pt;
+
+    static_assert(COS_IS_TRIVIALLY_DESTRUCTIBLE(Ctx), "COS does not call the destructor of a task context");
+    static_assert(sizeof(CosTaskContext<Ctx>) <= 0xFFFF, "task context too large");
+    static_assert(alignof(CosTaskContext<Ctx>) <= COS_TASK_DATA_ALIGN, "task context needs a larger alignment");
+
+    pt = COS_CreateTaskWithData(prio, (uint16_t) sizeof(CosTaskContext<Ctx>), _cosTaskContextFunc<Ctx>);
+    if(NULL != pt)
+    {   new (pt->pData) CosTaskContext<Ctx>(fn, static_cast<Args &&>(init)...);
+    }
+    return pt;
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Returns the context of a task created by CosCreateTask<Ctx>(), e.g.
+ * to change it from another task. Ctx has to be the type of the
+ * context, it is not checked.
+ ************************************************************************/
+template<typename Ctx>
+Ctx &CosTaskGetContext(CosTask_t *pt)
+{   return static_cast<CosTaskContext<Ctx> *>(pt->pData)->ctx;
+}
+
+
+#endif  // belongs to #ifndef at top of file...
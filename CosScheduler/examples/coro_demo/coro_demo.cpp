@@ -0,0 +1,140 @@
+/*!
+ ********************************************************************
+   @file            coro_demo.cpp
+   @par Project   : co-operative scheduler (COS)
+   @par Module    : Demo program for coroutine tasks
+
+   @brief  Two tasks run the same producer coroutine with different
+           arguments, a consumer reads their items from a typed FIFO and
+           hands every fourth one to a reporter task by a semaphore. All
+           state is held in local variables (see CosCoroutine.h). The
+           program stops after 12 items on a POSIX host and prints the
+           usage of the frame pool. Build with CMake from the top level
+           directory:
+   @verbatim
+   cmake -S . -B build && cmake --build build && ./build/cos_coro_demo
+   @endverbatim
+
+   @par Author    : Ernst Forgber (Fgb)
+   @par Company   : Hochschule Hannover - University of Applied Sciences and Arts, Germany
+   @par Department: Faculty 1
+ ********************************************************************
+
+   @par History   :
+   @verbatim
+   Version | Date        | Author | Change Description
+   0.0     | 18.10. 2026 | Fgb    | First Version
+   0.1     | 18.10. 2026 | Fgb    | drain task of the TX buffer
+   @endverbatim
+
+ ********************************************************************/
+/**************************************************************************
+
+Copyright 2026 Ernst Forgber
+
+
+This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+
+
+
+
+#include "CosCoroutine.h"
+
+extern "C" {
+#include "cos_ser.h"
+}
+
+
+CosFifo<int, 4> fifo;
+CosSema_t reportSema;
+int lastItem;
+
+
+/*! runs as two tasks, one per id */
+CosCoTask producer(int id, CosTicks_t period)
+{   for(int n = 0; n < 6; n++)
+    {   co_await CosCoWrite(fifo, 100 * id + n);
+        co_await CosCoSleep(period);
+    }
+    serPrintf("producer %d done\r\n", id);
+}
+
+/*! called coroutine: suspends the task of its caller */
+CosCoTask pause(int item)
+{   if(item % 2 != 0)
+    {   co_await CosCoSleep(_milliSecToTicks(5));
+    }
+}
+
+CosCoTask consumer(int count)
+{   for(int n = 1; n <= count; n++)
+    {   int item = co_await CosCoRead(fifo);
+        serPrintf("tick %lu: item %d\r\n", (unsigned long)_gettime_Ticks(), item);
+        co_await pause(item);
+        if(n % 4 == 0)
+        {   lastItem = item;
+            COS_SEM_SIGNAL(&reportSema);
+        }
+    }
+    co_await CosCoSleep(_milliSecToTicks(10));  // reporter runs first
+    COS_StopScheduler();
+}
+
+CosCoTask reporter(void)
+{   int reports = 0;
+    while(1)
+    {   co_await reportSema;
+        serPrintf("report %d: item %d\r\n", ++reports, lastItem);
+    }
+}
+
+
+int main(void)
+{
+    _initSystemTime();
+    serInit(9600UL);
+    if(0!=COS_InitTaskList())
+    {   serPuts("COS_InitTaskList has crashed...");
+    }
+#if COS_SER_TX_BUFFER > 0
+    serTxStart(1);  /* sends the buffered output */
+#endif
+    COS_SemCreate(&reportSema, 0);
+    CosCoSpawn(2, producer(1, _milliSecToTicks(20)));
+    CosCoSpawn(2, producer(2, _milliSecToTicks(30)));
+    CosCoSpawn(3, consumer(12));
+    CosCoSpawn(4, reporter());
+    if(0!=COS_RunScheduler())
+    {   serPuts("COS_RunScheduler has crashed...");
+    }
+
+    const CosCoPoolStats_t &stats = CosCoFramePool::getStatistics();
+    serPrintf("frames used %u, peak %u, failed %u\r\n", stats.used, stats.peak, stats.failed);
+    return 0;
+}
@@ -0,0 +1,116 @@
+/*!
+ ********************************************************************
+   @file            cyclic_demo.cpp
+   @par Project   : co-operative scheduler (COS)
+   @par Module    : Demo program for the cyclic executive
+
+   @brief  Three run-to-completion tasks in a schedule table that is
+           built at compile time (see CosCyclic.h). The executive runs
+           for four major frames on a POSIX host and prints its
+           statistics. Build with CMake from the top level directory:
+   @verbatim
+   cmake -S . -B build && cmake --build build && ./build/cos_cyclic_demo
+   @endverbatim
+
+   @par Author    : Ernst Forgber (Fgb)
+   @par Company   : Hochschule Hannover - University of Applied Sciences and Arts, Germany
+   @par Department: Faculty 1
+ ********************************************************************
+
+   @par History   :
+   @verbatim
+   Version | Date        | Author | Change Description
+   0.0     | 18.10. 2026 | Fgb    | First Version
+   @endverbatim
+
+ ********************************************************************/
+/**************************************************************************
+
+Copyright 2026 Ernst Forgber
+
+
+This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+
+#include "CosCyclic.h"
+
+extern "C" {
+#include "cos_ser.h"
+}
+
+
+void fastTask(void);
+void slowTask(void);
+void reportTask(void);
+
+/*! the task set: function, period and offset in microseconds */
+constexpr CosCyclicTask_t taskSet[] =
+{
+    { fastTask,    50000UL,      0UL },
+    { slowTask,   100000UL,  25000UL },
+    { reportTask, 200000UL, 175000UL },
+};
+
+COS_CYCLIC_SCHEDULE(schedule, taskSet);  // minor frame 25 ms, 8 frames
+
+static_assert(schedule.frames == 8, "unexpected number of minor frames");
+static_assert(schedule.maxEntriesPerFrame == 1, "tasks should never share a frame");
+
+CosCyclicExecutive<decltype(schedule)> executive(schedule);
+
+
+/*! runs every 50 ms */
+void fastTask(void)
+{   serPuts("fast at tick "); serOutUint32Dec(_gettime_Ticks()); serPuts("\r\n");
+}
+
+/*! runs every 100 ms, 25 ms after fastTask() */
+void slowTask(void)
+{   serPuts("slow at tick "); serOutUint32Dec(_gettime_Ticks()); serPuts("\r\n");
+}
+
+/*! runs at the end of every major frame and stops after four of them */
+void reportTask(void)
+{   const CosCyclicStats_t &stats = executive.getStatistics();
+
+    serPuts("major frame "); serOutUint32Dec(stats.majorCycles);
+    serPuts(", longest minor frame "); serOutUint32Dec(stats.maxFrame_Ticks);
+    serPuts(" ticks, overruns "); serOutUint32Dec(stats.overruns); serPuts("\r\n");
+    if(stats.majorCycles == 3)
+    {   executive.stop();
+    }
+}
+
+
+int main(void)
+{
+    _initSystemTime();
+    serInit(9600UL);
+    executive.run();
+    return 0;
+}
@@ -0,0 +1,159 @@
+/*!
+ ********************************************************************
+   @file            posix_demo.c
+   @par Project   : co-operative scheduler (COS)
+   @par Module    : Demo program for a POSIX host
+
+   @brief  Producer and consumer tasks and a software timer, running on
+           a Linux or other POSIX host. Output is written to stdout.
+           Build with CMake from the top level directory:
+   @verbatim
+   cmake -S . -B build && cmake --build build && ./build/cos_posix_demo
+   @endverbatim
+
+   @par Author    : Ernst Forgber (Fgb)
+   @par Company   : Hochschule Hannover - University of Applied Sciences and Arts, Germany
+   @par Department: Faculty 1
+ ********************************************************************
+
+   @par History   :
+   @verbatim
+   Version | Date        | Author | Change Description
+   0.0     | 18.10. 2026 | Fgb    | First Version
+   0.1     | 18.10. 2026 | Fgb    | trace dump with COS_TRACE
+   0.2     | 18.10. 2026 | Fgb    | heap statistics at the end
+   0.3     | 18.10. 2026 | Fgb    | COS_StopScheduler() instead of exit()
+   0.4     | 18.10. 2026 | Fgb    | drain task of the TX buffer
+   @endverbatim
+
+ ********************************************************************/
+/**************************************************************************
+
+Copyright 2026 Ernst Forgber
+
+
+This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+
+#include "cos_ser.h"
+#include "cos_scheduler.h"
+#include "cos_semaphore.h"
+#include "cos_data_fifo.h"
+#include "cos_timer.h"
+
+
+CosFifo_t fifo_1; /*!< global fifo for inter-task communication */
+
+
+/*!
+ *****************************************************************
+ * @par Description:
+ *  The task runs in a loop and sends integer values via FIFO to
+ *  the consumer task.
+ *
+ * @param  pt              - IN/OUT, pointer to task struct
+ ****************************************************************/
+void producerTask(CosTask_t *pt)
+{   static int16_t x=0;
+    COS_TASK_BEGIN(pt);
+
+    serPuts("Prod started\r\n");
+    for (x=0; x<10; x++)
+    {    serPuts("prod sends:"); serOutInt16Dec(x); serPuts("\r\n");
+         COS_FifoBlockingWriteSingleSlot(pt, &fifo_1, &x);
+         COS_TASK_SLEEP(pt,_milliSecToTicks(50));
+    }
+    serPuts("Prod ends\r\n");
+    COS_TASK_END(pt);
+}
+
+
+/*!
+ *****************************************************************
+ * @par Description:
+ *  The consumer task receives integer values via FIFO from the
+ *  producer task. After the last value, it stops the scheduler.
+ *
+ * @param  pt              - IN/OUT, pointer to task struct
+ ****************************************************************/
+void consumerTask(CosTask_t *pt)
+{   static int16_t x=0;
+    COS_TASK_BEGIN(pt);
+
+    serPuts("Cons started\r\n");
+    while(x < 9)
+    {    COS_FifoBlockingReadSingleSlot(pt, &fifo_1, &x);
+         serPuts("cons x="); serOutInt16Dec(x); serPuts("\r\n");
+         COS_TASK_SLEEP(pt,_milliSecToTicks(100));
+    }
+    serPuts("Cons ends\r\n");
+#if COS_MEMORY_STATISTICS
+    COS_PrintMemoryStatistics();
+#endif
+#if COS_TRACE
+    COS_TraceDump();  /* ./build/cos_posix_demo | ./build/cos_trace2json > trace.json */
+#endif
+    COS_StopScheduler();  /* main() returns */
+    COS_TASK_END(pt);
+}
+
+
+/*!
+ *****************************************************************
+ * @par Description:
+ *  Callback of a periodic software timer.
+ *
+ * @param  arg             - IN, not used
+ ****************************************************************/
+void tick(void *arg)
+{   (void) arg;
+    serPuts("timer at tick"); serOutUint32Dec(_gettime_Ticks()); serPuts("\r\n");
+}
+
+
+int main(void)
+{
+    _initSystemTime();
+    serInit(9600UL);
+    if(0!=COS_InitTaskList())
+    {   serPuts("COS_InitTaskList has crashed...");
+    }
+#if COS_SER_TX_BUFFER > 0
+    serTxStart(1);  /* sends the buffered output */
+#endif
+    COS_FifoCreate(&fifo_1, sizeof(int16_t), 5);
+    COS_CreateTask(4, NULL, producerTask);
+    COS_CreateTask(5, NULL, consumerTask);
+    COS_TimerCreate(_milliSecToTicks(250), 0, tick, NULL);
+    COS_PrintTaskList();
+    serPuts("\r\n");
+    if(0!=COS_RunScheduler())
+    {   serPuts("COS_RunScheduler has crashed...");
+    }
+    return 0;
+}
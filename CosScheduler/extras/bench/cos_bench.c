@@ -0,0 +1,451 @@
+/*!
+ ********************************************************************
+   @file            cos_bench.c
+   @par Project   : co-operative scheduler (COS)
+   @par Module    : Host tool: microbenchmarks of the COS primitives
+
+   @brief  Measures the time per operation of the scheduler, semaphores,
+           FIFOs and the task list on a POSIX host and writes the
+           results as JSON to stdout:
+   @verbatim
+   cmake -S . -B build && cmake --build build
+   ./build/cos_bench > bench.json
+   ./build/cos_bench 50 > bench.json      (50 ms per measurement, faster)
+   @endverbatim
+
+           Benchmarks, param is given in brackets:
+           - dispatch_idle_tasks (N): one COS_TASK_SCHEDULE() of a task
+             behind N suspended tasks of higher priority, i.e. the cost
+             of the list scan. Suspended tasks cost the same as sleeping
+             ones: the scheduler checks time and state of each of them.
+           - schedule_round_trip (1): COS_TASK_SCHEDULE() of the only
+             task in the list
+           - sem_ping_pong (2): two tasks, each signals the semaphore
+             the other one waits at; one op is a full round trip
+           - fifo_transfer (slot size): one slot written by a producer
+             and read by a consumer task, FIFO of 16 slots. The first
+             and the last byte of a slot carry its sequence number, the
+             consumer checks them; the tool stops on a lost, repeated or
+             corrupted slot.
+           - create_delete (N): COS_CreateTask() and COS_DeleteTask()
+             with N other tasks in the list
+           - log_write (N): a COS_LOGn() statement with N arguments,
+             only with COS_LOG
+
+           Every benchmark is repeated with twice the iterations until
+           it takes at least the minimum time (default 200 ms), the last
+           run is reported. The configuration of the library (statistics,
+           trace, latency) is part of the output, since it changes the
+           cost of a dispatch. Build with CMAKE_BUILD_TYPE=Release for
+           comparable numbers.
+
+           With COS_SCHEDULER_COUNTERS, every result also gives the tasks
+           checked and the reads of the system time per operation, i.e.
+           the work of the scheduler loop behind the measured time.
+
+           This program runs on the host, it is not part of the COS
+           library.
+
+   @par Author    : Ernst Forgber (Fgb)
+   @par Company   : Hochschule Hannover - University of Applied Sciences and Arts, Germany
+   @par Department: Faculty 1
+ ********************************************************************
+
+   @par History   :
+   @verbatim
+   Version | Date        | Author | Change Description
+   0.0     | 18.10. 2026 | Fgb    | First Version
+   0.1     | 18.10. 2026 | Fgb    | checks and time reads per op
+   0.2     | 18.10. 2026 | Fgb    | log_write
+   0.3     | 18.10. 2026 | Fgb    | fifo_transfer checks the data read
+   @endverbatim
+
+ ********************************************************************/
+/**************************************************************************
+
+Copyright 2026 Ernst Forgber
+
+
+This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "cos_scheduler.h"
+#include "cos_semaphore.h"
+#include "cos_data_fifo.h"
+#include "cos_log.h"
+
+
+#define FIFO_SLOTS        16    /*!< slots of the FIFO in fifo_transfer */
+#define MAX_IDLE_TASKS    10000 /*!< largest N of dispatch_idle_tasks */
+
+
+/*! one benchmark: setup (not measured), run 'iterations' ops, teardown */
+typedef struct
+{   const char *name;
+    uint32_t param;
+    int  (*setup)(uint32_t param);
+    void (*run)(uint32_t iterations);
+    void (*teardown)(void);
+} Bench_t;
+
+
+static CosTask_t *idle_g[MAX_IDLE_TASKS]; /*!< tasks that are never ready */
+static uint32_t nIdle_g = 0;
+static uint32_t iterations_g;       /*!< ops of the current run */
+static uint32_t count_g;            /*!< ops done by the first task */
+static uint32_t count2_g;           /*!< ops done by the second task */
+static CosSema_t semA_g, semB_g;    /*!< semaphores of sem_ping_pong */
+static CosFifo_t fifo_g;            /*!< FIFO of fifo_transfer */
+static uint32_t slotSize_g;         /*!< slot size of fifo_transfer */
+static char slot_g[256];            /*!< data of a FIFO slot, written */
+static char rxSlot_g[256];          /*!< data of a FIFO slot, read */
+static uint32_t nBadSlots_g;        /*!< slots read with unexpected data */
+static int  first_g = 1;            /*!< no result written yet */
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Monotonic host time in nanoseconds.
+ ************************************************************************/
+static uint64_t _now_ns(void)
+{   struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Task function of the idle tasks, they are suspended before they run.
+ ************************************************************************/
+static void _idleTask(CosTask_t *pt)
+{   COS_TASK_BEGIN(pt);
+    while(1)
+    {   COS_TASK_SCHEDULE(pt);
+    }
+    COS_TASK_END(pt);
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Creates n suspended tasks with priority prio.
+ ************************************************************************/
+static int _createIdleTasks(uint32_t n, uint8_t prio)
+{   for(nIdle_g = 0; nIdle_g < n; nIdle_g++)
+    {   idle_g[nIdle_g] = COS_CreateTask(prio, NULL, _idleTask);
+        if((NULL == idle_g[nIdle_g]) || (0 != COS_SuspendTask(idle_g[nIdle_g])))
+        {   return -1;
+        }
+    }
+    return 0;
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Deletes the idle tasks.
+ ************************************************************************/
+static void _deleteIdleTasks(void)
+{   while(nIdle_g > 0)
+    {   COS_DeleteTask(idle_g[--nIdle_g]);
+    }
+}
+
+
+
+/*--------------- dispatch_idle_tasks, schedule_round_trip -------------*/
+static void _yieldTask(CosTask_t *pt)
+{   COS_TASK_BEGIN(pt);
+    while(count_g < iterations_g)
+    {   count_g++;
+        COS_TASK_SCHEDULE(pt);
+    }
+    COS_StopScheduler();
+    COS_TASK_END(pt);
+}
+
+static int _setupDispatch(uint32_t n)
+{   return _createIdleTasks(n, 200);
+}
+
+static void _runDispatch(uint32_t iterations)
+{   iterations_g = iterations;
+    count_g = 0;
+    COS_CreateTask(100, NULL, _yieldTask);
+    COS_RunScheduler();
+}
+
+
+
+/*--------------- sem_ping_pong ---------------------------------------*/
+static void _pingTask(CosTask_t *pt)
+{   COS_TASK_BEGIN(pt);
+    while(count_g < iterations_g)
+    {   count_g++;
+        COS_SEM_SIGNAL(&semA_g);
+        COS_SEM_WAIT(&semB_g, pt);
+    }
+    COS_StopScheduler();
+    COS_TASK_END(pt);
+}
+
+static void _pongTask(CosTask_t *pt)
+{   COS_TASK_BEGIN(pt);
+    while(count2_g < iterations_g)
+    {   count2_g++;
+        COS_SEM_WAIT(&semA_g, pt);
+        COS_SEM_SIGNAL(&semB_g);
+    }
+    COS_TASK_END(pt);
+}
+
+static int _setupSem(uint32_t param)
+{   (void)param;
+    COS_SemCreate(&semA_g, 0);
+    COS_SemCreate(&semB_g, 0);
+    return 0;
+}
+
+static void _runSem(uint32_t iterations)
+{   iterations_g = iterations;
+    count_g = 0;
+    count2_g = 0;
+    COS_CreateTask(100, NULL, _pingTask);
+    COS_CreateTask(100, NULL, _pongTask);
+    COS_RunScheduler();
+}
+
+
+
+/*--------------- fifo_transfer ---------------------------------------*/
+static void _producerTask(CosTask_t *pt)
+{   COS_TASK_BEGIN(pt);
+    while(count_g < iterations_g)
+    {   count_g++;
+        slot_g[slotSize_g - 1] = (char)~count_g;  /* sequence number */
+        slot_g[0] = (char)count_g;
+        COS_FifoBlockingWriteSingleSlot(pt, &fifo_g, slot_g);
+    }
+    COS_TASK_END(pt);
+}
+
+static void _consumerTask(CosTask_t *pt)
+{   COS_TASK_BEGIN(pt);
+    while(count2_g < iterations_g)
+    {   count2_g++;
+        COS_FifoBlockingReadSingleSlot(pt, &fifo_g, rxSlot_g);
+        if(((char)count2_g != rxSlot_g[0]) ||
+           ((slotSize_g > 1) && ((char)~count2_g != rxSlot_g[slotSize_g - 1])))
+        {   nBadSlots_g++;
+        }
+    }
+    COS_StopScheduler();
+    COS_TASK_END(pt);
+}
+
+static int _setupFifo(uint32_t slotSize)
+{   slotSize_g = slotSize;
+    return (0 == COS_FifoCreate(&fifo_g, (uint8_t)slotSize, FIFO_SLOTS)) ? 0 : -1;
+}
+
+static void _runFifo(uint32_t iterations)
+{   iterations_g = iterations;
+    count_g = 0;
+    count2_g = 0;
+    nBadSlots_g = 0;
+    COS_CreateTask(100, NULL, _producerTask);
+    COS_CreateTask(100, NULL, _consumerTask);
+    COS_RunScheduler();
+    if(0 != nBadSlots_g)
+    {   fprintf(stderr, "cos_bench: fifo_transfer(%u): %u of %u slots read with wrong data\n",
+                (unsigned)slotSize_g, (unsigned)nBadSlots_g, (unsigned)iterations);
+        exit(1);
+    }
+}
+
+static void _teardownFifo(void)
+{   COS_FifoDestroy(&fifo_g);
+}
+
+
+
+/*--------------- create_delete ---------------------------------------*/
+static int _setupCreate(uint32_t n)
+{   return _createIdleTasks(n, 100);
+}
+
+static void _runCreate(uint32_t iterations)
+{   CosTask_t *pt;
+
+    while(iterations-- > 0)
+    {   pt = COS_CreateTask(100, NULL, _idleTask);
+        COS_DeleteTask(pt);
+    }
+}
+
+
+
+#if COS_LOG
+/*--------------- log_write -------------------------------------------*/
+static void _runLog0(uint32_t iterations)
+{   while(iterations-- > 0)
+    {   COS_LOG0("tick");
+    }
+}
+
+static void _runLog2(uint32_t iterations)
+{   while(iterations-- > 0)
+    {   COS_LOG2("speed %u -> %u", iterations, iterations + 1);
+    }
+}
+
+static void _runLog4(uint32_t iterations)
+{   while(iterations-- > 0)
+    {   COS_LOG4("%d %d %d %d", iterations, 1, 2, 3);
+    }
+}
+#endif
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Runs a benchmark with doubled iterations until it takes at least
+ * minTime_ns and writes the result as JSON object.
+ ************************************************************************/
+static void _measure(const Bench_t *b, uint64_t minTime_ns)
+{   uint32_t iterations = 100;
+    uint64_t t0, elapsed;
+#if COS_SCHEDULER_COUNTERS
+    CosSchedCounters_t c0, c1;
+#endif
+
+    if(0 != b->setup(b->param))
+    {   fprintf(stderr, "cos_bench: setup of %s(%u) failed\n", b->name, (unsigned)b->param);
+        exit(1);
+    }
+    while(1)
+    {
+#if COS_SCHEDULER_COUNTERS
+        COS_GetSchedulerCounters(&c0);
+#endif
+        t0 = _now_ns();
+        b->run(iterations);
+        elapsed = _now_ns() - t0;
+#if COS_SCHEDULER_COUNTERS
+        COS_GetSchedulerCounters(&c1);
+#endif
+        if((elapsed >= minTime_ns) || (iterations >= 0x40000000UL))
+        {   break;
+        }
+        iterations *= 2;
+    }
+    b->teardown();
+    printf("%s\n    {\"name\":\"%s\",\"param\":%u,\"iterations\":%u,\"ns_per_op\":%.2f",
+           first_g ? "" : ",", b->name, (unsigned)b->param, (unsigned)iterations,
+           (double)elapsed / iterations);
+#if COS_SCHEDULER_COUNTERS
+    printf(",\"checks_per_op\":%.2f,\"time_reads_per_op\":%.2f",
+           (double)(uint32_t)(c1.checks - c0.checks) / iterations,
+           (double)(uint32_t)(c1.timeReads - c0.timeReads) / iterations);
+#endif
+    printf("}");
+    fflush(stdout);
+    first_g = 0;
+}
+
+
+static int _noSetup(uint32_t param)
+{   (void)param;
+    return 0;
+}
+
+
+static void _noTeardown(void)
+{
+}
+
+
+int main(int argc, char *argv[])
+{   static const Bench_t bench[] =
+    {   { "dispatch_idle_tasks",     2, _setupDispatch, _runDispatch, _deleteIdleTasks },
+        { "dispatch_idle_tasks",    10, _setupDispatch, _runDispatch, _deleteIdleTasks },
+        { "dispatch_idle_tasks",   100, _setupDispatch, _runDispatch, _deleteIdleTasks },
+        { "dispatch_idle_tasks",  1000, _setupDispatch, _runDispatch, _deleteIdleTasks },
+        { "dispatch_idle_tasks", 10000, _setupDispatch, _runDispatch, _deleteIdleTasks },
+        { "schedule_round_trip",     1, _noSetup,       _runDispatch, _noTeardown },
+        { "sem_ping_pong",           2, _setupSem,      _runSem,      _noTeardown },
+        { "fifo_transfer",           1, _setupFifo,     _runFifo,     _teardownFifo },
+        { "fifo_transfer",           8, _setupFifo,     _runFifo,     _teardownFifo },
+        { "fifo_transfer",          64, _setupFifo,     _runFifo,     _teardownFifo },
+        { "fifo_transfer",         255, _setupFifo,     _runFifo,     _teardownFifo },
+        { "create_delete",           0, _setupCreate,   _runCreate,   _deleteIdleTasks },
+        { "create_delete",         100, _setupCreate,   _runCreate,   _deleteIdleTasks },
+        { "create_delete",        1000, _setupCreate,   _runCreate,   _deleteIdleTasks },
+#if COS_LOG
+        { "log_write",               0, _noSetup,       _runLog0,     _noTeardown },
+        { "log_write",               2, _noSetup,       _runLog2,     _noTeardown },
+        { "log_write",               4, _noSetup,       _runLog4,     _noTeardown },
+#endif
+    };
+    uint64_t minTime_ns = 200000000ULL;
+    size_t i;
+
+    if(argc > 2)
+    {   fprintf(stderr, "usage: %s [minimum time per benchmark in ms]\n", argv[0]);
+        return 1;
+    }
+    if(argc == 2)
+    {   minTime_ns = strtoull(argv[1], NULL, 0) * 1000000ULL;
+    }
+    _initSystemTime();
+    COS_InitTaskList();
+
+    printf("{\n  \"tool\":\"cos_bench\",\n  \"config\":{\"ticks_bits\":%u,\"microsec_per_tick\":%u,"
+           "\"virtual_time\":%d,\"task_statistics\":%d,\"task_latency\":%d,\"trace\":%d,\"log\":%d},\n"
+           "  \"results\":[",
+           (unsigned)(8 * sizeof(CosTicks_t)), (unsigned)COS_MICROSEC_PER_TICK,
+           COS_VIRTUAL_TIME, COS_TASK_STATISTICS, COS_TASK_LATENCY, COS_TRACE, COS_LOG);
+    for(i = 0; i < sizeof(bench) / sizeof(bench[0]); i++)
+    {   _measure(&bench[i], minTime_ns);
+    }
+    printf("\n  ]\n}\n");
+    return 0;
+}
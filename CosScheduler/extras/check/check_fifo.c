@@ -0,0 +1,290 @@
+/*!
+ ********************************************************************
+   @file            check_fifo.c
+   @par Project   : co-operative scheduler (COS)
+   @par Module    : Host check: data FIFO with several writers
+
+   @brief  Checks the data FIFO (cos_data_fifo.h) on the host:
+   @verbatim
+   cmake -S . -B build && cmake --build build
+   ./build/cos_check_fifo           (prints the result, exit code 1 on an error)
+   @endverbatim
+
+           - overwrite mode, two producers: both tasks write to the
+             same FIFO in COS_FIFO_MODE_OVERWRITE with
+             COS_FifoBlockingWriteSingleSlot(), a slow consumer reads.
+             Before each of its writes, the first producer wakes up the
+             second one, which has a higher priority: it reaches the
+             write macro while the first one yields between wait and
+             write. Both producers have to make all of their writes,
+             none may stay blocked at the write semaphore.
+           - wide slots: FIFOs with buffers beyond 255 bytes, up to
+             255 slots of 255 bytes, are filled and drained in steps
+             of different length, so the indexes wrap around the buffer
+             many times. Every slot has to be read back unchanged and
+             in order.
+
+           This program runs on the host, it is not part of the COS
+           library.
+
+   @par Author    : Ernst Forgber (Fgb)
+   @par Company   : Hochschule Hannover - University of Applied Sciences and Arts, Germany
+   @par Department: Faculty 1
+ ********************************************************************
+
+   @par History   :
+   @verbatim
+   Version | Date        | Author | Change Description
+   0.0     | 18.10. 2026 | Fgb    | First Version
+   0.1     | 18.10. 2026 | Fgb    | wide slots
+   @endverbatim
+
+ ********************************************************************/
+/**************************************************************************
+
+Copyright 2026 Ernst Forgber
+
+
+This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+
+
+
+#include <stdio.h>
+#include <string.h>
+#include "cos_scheduler.h"
+#include "cos_semaphore.h"
+#include "cos_data_fifo.h"
+
+
+#define WRITES        48    /*!< writes of every producer */
+#define ROUNDS        40    /*!< fill and drain steps of a wide FIFO */
+
+
+static CosFifo_t fifo_g;               /*!< FIFO under test */
+static CosSema_t go_g;                 /*!< first producer wakes up the second one */
+static uint16_t items_g[2];            /*!< item being written per producer */
+static uint16_t writes_g[2];           /*!< writes done per producer */
+static CosTask_t *producer_pt_g[2];    /*!< the producers */
+static uint32_t nErrors_g = 0;         /*!< failed checks */
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Counts a failed check and reports it.
+ ************************************************************************/
+static void _error(const char *what)
+{
+    nErrors_g++;
+    printf("error: %s\n", what);
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * First producer: wakes up the second one, then writes, WRITES times.
+ ************************************************************************/
+static void _producer0Task(CosTask_t *pt)
+{
+    COS_TASK_BEGIN(pt);
+    while(writes_g[0] < WRITES)
+    {   items_g[0] = writes_g[0];
+        COS_SEM_SIGNAL(&go_g);
+        COS_FifoBlockingWriteSingleSlot(pt, &fifo_g, (char *) &items_g[0]);
+        writes_g[0]++;
+        COS_TASK_SLEEP(pt, _milliSecToTicks(1));
+    }
+    COS_TASK_END(pt);
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Second producer: writes whenever the first one has woken it up.
+ ************************************************************************/
+static void _producer1Task(CosTask_t *pt)
+{
+    COS_TASK_BEGIN(pt);
+    while(writes_g[1] < WRITES)
+    {   COS_SEM_WAIT(&go_g, pt);
+        items_g[1] = (uint16_t)(1000 + writes_g[1]);
+        COS_FifoBlockingWriteSingleSlot(pt, &fifo_g, (char *) &items_g[1]);
+        writes_g[1]++;
+    }
+    COS_TASK_END(pt);
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Slow consumer: reads now and then, the FIFO stays mostly full.
+ ************************************************************************/
+static void _consumerTask(CosTask_t *pt)
+{   static uint16_t item;
+
+    COS_TASK_BEGIN(pt);
+    while(1)
+    {   COS_TASK_SLEEP(pt, _milliSecToTicks(3));
+        COS_FifoBlockingReadSingleSlot(pt, &fifo_g, (char *) &item);
+    }
+    COS_TASK_END(pt);
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Ends the run after a time long enough for all writes.
+ ************************************************************************/
+static void _stopTask(CosTask_t *pt)
+{
+    COS_TASK_BEGIN(pt);
+    COS_TASK_SLEEP(pt, _milliSecToTicks(200));
+    COS_StopScheduler();
+    COS_TASK_END(pt);
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Two producers write to one FIFO in overwrite mode.
+ ************************************************************************/
+static void _checkOverwriteTwoProducers(void)
+{   uint8_t i;
+
+    COS_InitTaskList();
+    if(0 != COS_FifoCreate(&fifo_g, sizeof(uint16_t), 4))
+    {   _error("overwrite: FifoCreate failed");
+        return;
+    }
+    COS_FifoSetMode(&fifo_g, COS_FIFO_MODE_OVERWRITE);
+    COS_SemCreate(&go_g, 0);
+    writes_g[0] = 0;
+    writes_g[1] = 0;
+    producer_pt_g[0] = COS_CreateTask(2, NULL, _producer0Task);
+    producer_pt_g[1] = COS_CreateTask(3, NULL, _producer1Task);
+    COS_CreateTask(4, NULL, _consumerTask);
+    COS_CreateTask(5, NULL, _stopTask);
+    COS_RunScheduler();
+
+    printf("overwrite, two producers: %u and %u of %u writes, %lu slots dropped\n",
+           writes_g[0], writes_g[1], WRITES, (unsigned long) COS_FifoGetDroppedSlots(&fifo_g));
+    for(i = 0; i < 2; i++)
+    {   if(writes_g[i] != WRITES)
+        {   _error((TASK_STATE_BLOCKED == producer_pt_g[i]->state) ?
+                   "overwrite: a producer is blocked at the write semaphore" :
+                   "overwrite: a producer did not finish");
+        }
+    }
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Fills a slot with a pattern of its sequence number.
+ ************************************************************************/
+static void _fillSlot(char *slot, uint8_t slotSize, uint32_t seq)
+{   uint8_t i;
+
+    for(i = 0; i < slotSize; i++)
+    {   slot[i] = (char)(seq * 7 + i);
+    }
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Writes and reads slots of one FIFO with 'nSlots' slots of
+ * 'slotSize' bytes. Each round writes up to 3/4 of the slots, then
+ * reads up to 1/2 of them, so the used slots and the indexes move.
+ ************************************************************************/
+static void _checkWide(uint8_t slotSize, uint8_t nSlots)
+{   static char slot[255], expected[255];
+    CosFifo_t q;
+    uint32_t nWritten = 0, nRead = 0, round, i;
+    uint8_t ok = 1;
+
+    if(0 != COS_FifoCreate(&q, slotSize, nSlots))
+    {   _error("wide: FifoCreate failed");
+        return;
+    }
+    for(round = 0; (round < ROUNDS) && ok; round++)
+    {   for(i = 0; i < (3u * nSlots + 3) / 4 + round % 3; i++)
+        {   _fillSlot(slot, slotSize, nWritten);
+            if(1 != _qWriteSingleSlot(&q, slot))
+            {   break;  /* full */
+            }
+            nWritten++;
+        }
+        for(i = 0; (i < (nSlots + 1) / 2 + round % 2) && ok; i++)
+        {   if(1 != _qReadSingleSlot(&q, slot))
+            {   break;  /* empty */
+            }
+            _fillSlot(expected, slotSize, nRead);
+            if(0 != memcmp(slot, expected, slotSize))
+            {   ok = 0;
+            }
+            nRead++;
+        }
+    }
+    while(ok && (1 == _qReadSingleSlot(&q, slot)))  /* drain */
+    {   _fillSlot(expected, slotSize, nRead);
+        ok = (0 == memcmp(slot, expected, slotSize));
+        nRead++;
+    }
+    COS_FifoDestroy(&q);
+
+    printf("wide slots: %3u slots of %3u bytes, %lu written, %lu read\n",
+           nSlots, slotSize, (unsigned long) nWritten, (unsigned long) nRead);
+    if(!ok)
+    {   _error("wide: a slot was read with wrong data");
+    }
+    else if(nRead != nWritten)
+    {   _error("wide: slots lost");
+    }
+}
+
+
+int main(void)
+{
+    _initSystemTime();
+    _checkOverwriteTwoProducers();
+    _checkWide(64, 16);
+    _checkWide(255, 16);
+    _checkWide(200, 200);
+    _checkWide(255, 255);
+    printf("fifo check: %lu errors\n", (unsigned long) nErrors_g);
+    return (0 == nErrors_g) ? 0 : 1;
+}
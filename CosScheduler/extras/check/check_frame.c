@@ -0,0 +1,253 @@
+/*!
+ ********************************************************************
+   @file            check_frame.c
+   @par Project   : co-operative scheduler (COS)
+   @par Module    : Host check: CRC, COBS encoding and decoding of frames
+
+   @brief  Checks the frame layer (cos_frame.h) on the host:
+   @verbatim
+   cmake -S . -B build && cmake --build build
+   ./build/cos_check_frame          (prints the result, exit code 1 on an error)
+   @endverbatim
+
+           - COS_Crc16() of "123456789" is the check value 0x29B1 of
+             CRC-16 CCITT, in one block and in two parts.
+           - 200000 frames with random type and payload of 0..255 bytes
+             are encoded by COS_FrameEncode() and decoded by
+             COS_FrameDecode(). The payloads are random bytes, all zero,
+             runs of 254 bytes without zero and mixes of both, the
+             edges of COBS. An encoded frame has to fit in
+             COS_FRAME_ENCODED_SIZE(), contain no 0x00 but the last
+             byte, and decode to the same type and payload.
+           - In every second frame, one data byte (not a COBS code
+             byte) is changed first; the CRC has to reject the frame.
+
+           This program runs on the host, it is not part of the COS
+           library.
+
+   @par Author    : Ernst Forgber (Fgb)
+   @par Company   : Hochschule Hannover - University of Applied Sciences and Arts, Germany
+   @par Department: Faculty 1
+ ********************************************************************
+
+   @par History   :
+   @verbatim
+   Version | Date        | Author | Change Description
+   0.0     | 18.10. 2026 | Fgb    | First Version
+   @endverbatim
+
+ ********************************************************************/
+/**************************************************************************
+
+Copyright 2026 Ernst Forgber
+
+
+This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+
+
+
+#include <stdio.h>
+#include <string.h>
+#include "cos_frame.h"
+
+
+#define ROUND_TRIPS   200000UL  /*!< frames encoded and decoded */
+#define MAX_LEN       255       /*!< largest payload of COS_FrameEncode() */
+
+
+static uint32_t random_g = 0x2545F491UL; /*!< state of _random() */
+static uint32_t nErrors_g = 0;           /*!< failed checks */
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Xorshift random numbers, the same sequence on every run.
+ ************************************************************************/
+static uint32_t _random(void)
+{
+    random_g ^= random_g << 13;
+    random_g ^= random_g >> 17;
+    random_g ^= random_g << 5;
+    return random_g;
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Counts a failed check, the first ones are reported.
+ ************************************************************************/
+static void _error(const char *what, uint32_t frame)
+{
+    if(nErrors_g++ < 10)
+    {   printf("frame %lu: %s\n", (unsigned long) frame, what);
+    }
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Fills a payload with one of the test patterns.
+ ************************************************************************/
+static void _fillPayload(uint8_t *p, uint16_t len)
+{   uint16_t i;
+
+    switch(_random() % 4)
+    {   case 0:   /* random bytes */
+            for(i = 0; i < len; i++)
+            {   p[i] = (uint8_t) _random();
+            }
+            break;
+        case 1:   /* all zero */
+            memset(p, 0, len);
+            break;
+        case 2:   /* no zero: COBS blocks of 254 bytes */
+            for(i = 0; i < len; i++)
+            {   p[i] = (uint8_t)(1 + _random() % 255);
+            }
+            break;
+        default:  /* zeros between runs of random length */
+            for(i = 0; i < len; i++)
+            {   p[i] = (0 == _random() % 64) ? 0 : (uint8_t)(1 + _random() % 255);
+            }
+            break;
+    }
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Changes one data byte of an encoded frame (not the terminating 0x00)
+ * to another value but 0x00. Code bytes are skipped: changing them
+ * moves the zeros of the decoded frame, which is a different error.
+ *
+ * @retval 1 if a byte has been changed, 0 if there are only code bytes
+ ************************************************************************/
+static uint8_t _corrupt(uint8_t *enc, uint16_t n)
+{   uint8_t isCode[COS_FRAME_ENCODED_SIZE(MAX_LEN)];
+    uint16_t i, pos, nCodes = 0;
+
+    memset(isCode, 0, sizeof(isCode));
+    for(i = 0; i < n - 1; i += enc[i])
+    {   isCode[i] = 1;
+        nCodes++;
+    }
+    if(nCodes == n - 1)
+    {   return 0;  /* e.g. type, payload and CRC all zero */
+    }
+    do
+    {   pos = (uint16_t)(_random() % (n - 1));
+    } while(isCode[pos]);
+    enc[pos] = (uint8_t)(enc[pos] % 255 + 1);  /* 1..255, not the old value */
+    return 1;
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Checks the CRC against the check value of CRC-16 CCITT.
+ ************************************************************************/
+static void _checkCrc(void)
+{   static const uint8_t check[] = "123456789";
+    uint16_t crc;
+
+    crc = COS_Crc16(COS_CRC16_INIT, check, 9);
+    if(0x29B1 != crc)
+    {   _error("CRC of \"123456789\" is not 0x29B1", 0);
+    }
+    crc = COS_Crc16(COS_CRC16_INIT, check, 4);
+    crc = COS_Crc16(crc, check + 4, 5);
+    if(0x29B1 != crc)
+    {   _error("CRC of \"123456789\" in two parts is not 0x29B1", 0);
+    }
+    printf("CRC check value: 0x%04X\n", COS_Crc16(COS_CRC16_INIT, check, 9));
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Encodes, decodes and corrupts random frames.
+ ************************************************************************/
+static void _checkRoundTrips(void)
+{   uint8_t payload[MAX_LEN];
+    uint8_t enc[COS_FRAME_ENCODED_SIZE(MAX_LEN)];
+    uint8_t type;
+    uint16_t len, i;
+    int16_t n, d;
+    uint32_t frame, nRejected = 0;
+
+    for(frame = 0; frame < ROUND_TRIPS; frame++)
+    {   len = (uint16_t)(_random() % (MAX_LEN + 1));
+        type = (uint8_t) _random();
+        _fillPayload(payload, len);
+
+        n = COS_FrameEncode(enc, sizeof(enc), type, payload, (uint8_t) len);
+        if((n < 0) || (n > COS_FRAME_ENCODED_SIZE(len)) || (0 != enc[n - 1]))
+        {   _error("encoding failed", frame);
+            continue;
+        }
+        for(i = 0; i < n - 1; i++)
+        {   if(0 == enc[i])
+            {   _error("0x00 inside the encoded frame", frame);
+                break;
+            }
+        }
+
+        if((0 == frame % 2) && _corrupt(enc, (uint16_t) n))  /* every other frame */
+        {   if(COS_FrameDecode(enc, (uint16_t)(n - 1)) >= 0)
+            {   _error("corrupted frame accepted", frame);
+            }
+            else
+            {   nRejected++;
+            }
+            n = COS_FrameEncode(enc, sizeof(enc), type, payload, (uint8_t) len);
+        }
+
+        d = COS_FrameDecode(enc, (uint16_t)(n - 1));
+        if((d != len + 1) || (enc[0] != type) || (0 != memcmp(enc + 1, payload, len)))
+        {   _error("decoded frame differs", frame);
+        }
+    }
+    printf("round trips: %lu, corrupted frames rejected: %lu\n",
+           (unsigned long) ROUND_TRIPS, (unsigned long) nRejected);
+}
+
+
+int main(void)
+{
+    _checkCrc();
+    _checkRoundTrips();
+    printf("frame check: %lu errors\n", (unsigned long) nErrors_g);
+    return (0 == nErrors_g) ? 0 : 1;
+}
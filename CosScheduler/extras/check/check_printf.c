@@ -0,0 +1,281 @@
+/*!
+ ********************************************************************
+   @file            check_printf.c
+   @par Project   : co-operative scheduler (COS)
+   @par Module    : Host check: serPrintf() against printf() of the host
+
+   @brief  Formats numbers and strings with serPrintf() and with
+           snprintf() of the C library and compares the output:
+   @verbatim
+   cmake -S . -B build && cmake --build build
+   ./build/cos_check_printf         (prints the result, exit code 1 on a difference)
+   @endverbatim
+
+           Every conversion of serPrintf() (%d %i %u %x %X %c %s %%)
+           is checked with and without the flags '-' and '0', a field
+           width and the length 'l'. The values are the edges of the
+           digit pairs, powers of 2 and 10 and their neighbours and
+           a fixed sequence of random numbers: 4.3 million values in
+           total. The output of serPrintf() goes to stdout, so stdout is
+           redirected into a temporary file while the values are
+           formatted.
+
+           This program runs on the host, it is not part of the COS
+           library.
+
+   @par Author    : Ernst Forgber (Fgb)
+   @par Company   : Hochschule Hannover - University of Applied Sciences and Arts, Germany
+   @par Department: Faculty 1
+ ********************************************************************
+
+   @par History   :
+   @verbatim
+   Version | Date        | Author | Change Description
+   0.0     | 18.10. 2026 | Fgb    | First Version
+   @endverbatim
+
+ ********************************************************************/
+/**************************************************************************
+
+Copyright 2026 Ernst Forgber
+
+
+This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "cos_ser.h"
+
+
+#define BATCH          1024  /*!< values per comparison */
+#define MAX_LINE       64    /*!< longest line of one value */
+#define RANDOM_VALUES  170000UL  /*!< random values per format */
+
+
+/*! kind of argument a format takes */
+typedef enum { ARG_INT, ARG_UINT, ARG_LONG, ARG_ULONG, ARG_CHAR, ARG_STR } Arg_t;
+
+/*! one format and its argument */
+typedef struct
+{   const char *fmt;
+    Arg_t arg;
+} Format_t;
+
+
+static FILE *capture_g;              /*!< stdout while serPrintf() writes */
+static int stdoutFd_g;               /*!< the real stdout */
+static char expected_g[BATCH * MAX_LINE]; /*!< output of snprintf() */
+static char actual_g[BATCH * MAX_LINE];   /*!< output of serPrintf() */
+static size_t nExpected_g = 0;       /*!< bytes in expected_g */
+static uint32_t values_g[BATCH];     /*!< values of the current batch */
+static uint32_t nValues_g = 0;       /*!< values in the current batch */
+static uint32_t nChecked_g = 0;      /*!< values compared */
+static uint32_t nFailed_g = 0;       /*!< batches with a difference */
+static uint32_t random_g = 0x12345678UL; /*!< state of _random() */
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Xorshift random numbers, the same sequence on every run.
+ ************************************************************************/
+static uint32_t _random(void)
+{
+    random_g ^= random_g << 13;
+    random_g ^= random_g >> 17;
+    random_g ^= random_g << 5;
+    return random_g;
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Compares the output of serPrintf() in the capture file with the
+ * output of snprintf() for the values collected so far, then empties
+ * both. The first differing line is reported.
+ ************************************************************************/
+static void _compareBatch(const Format_t *f)
+{   ssize_t n;
+    size_t i, line;
+
+#if COS_SER_TX_BUFFER > 0
+    serTxFlush();
+#endif
+    fflush(stdout);
+    n = pread(fileno(capture_g), actual_g, sizeof(actual_g), 0);
+    if((n != (ssize_t) nExpected_g) || (0 != memcmp(actual_g, expected_g, nExpected_g)))
+    {   for(i = 0, line = 0; (i < nExpected_g) && ((ssize_t) i < n) && (actual_g[i] == expected_g[i]); i++)
+        {   if('\n' == expected_g[i])
+            {   line++;
+            }
+        }
+        if(line >= nValues_g)
+        {   line = nValues_g - 1;  /* additional output after the last value */
+        }
+        if(0 == nFailed_g++)
+        {   dprintf(stdoutFd_g, "format \"%s\", value 0x%08lX: output differs\n",
+                    f->fmt, (unsigned long) values_g[line]);
+        }
+    }
+    nChecked_g += nValues_g;
+    nValues_g = 0;
+    nExpected_g = 0;
+    if((0 != ftruncate(fileno(capture_g), 0)) || (0 != fseek(stdout, 0, SEEK_SET)))
+    {   dprintf(stdoutFd_g, "cannot empty the capture file\n");
+        exit(1);
+    }
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Formats one value with serPrintf() and with snprintf(), a line of
+ * each.
+ ************************************************************************/
+static void _checkValue(const Format_t *f, uint32_t x)
+{   static const char *strings[] = { "", "a", "COS", "a string longer than the chunk of serVprintf()" };
+    char fmt[32];
+    char *out = expected_g + nExpected_g;
+    size_t size = sizeof(expected_g) - nExpected_g;
+    int n = 0;
+
+    snprintf(fmt, sizeof(fmt), "<%s>\n", f->fmt);
+    switch(f->arg)
+    {   case ARG_INT:
+            serPrintf(fmt, (int)(int32_t) x);
+            n = snprintf(out, size, fmt, (int)(int32_t) x);
+            break;
+        case ARG_UINT:
+            serPrintf(fmt, (unsigned int) x);
+            n = snprintf(out, size, fmt, (unsigned int) x);
+            break;
+        case ARG_LONG:
+            serPrintf(fmt, (long)(int32_t) x);
+            n = snprintf(out, size, fmt, (long)(int32_t) x);
+            break;
+        case ARG_ULONG:
+            serPrintf(fmt, (unsigned long) x);
+            n = snprintf(out, size, fmt, (unsigned long) x);
+            break;
+        case ARG_CHAR:
+            x = 0x20 + x % 0x5F;  /* printable */
+            serPrintf(fmt, (int) x);
+            n = snprintf(out, size, fmt, (int) x);
+            break;
+        case ARG_STR:
+            x = x % 4;
+            serPrintf(fmt, strings[x]);
+            n = snprintf(out, size, fmt, strings[x]);
+            break;
+    }
+    nExpected_g += (size_t) n;
+    values_g[nValues_g++] = x;
+    if(nValues_g == BATCH)
+    {   _compareBatch(f);
+    }
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Checks one format: the edges of the number ranges, then random
+ * values of all sizes, i.e. 1 to 32 significant bits.
+ ************************************************************************/
+static void _checkFormat(const Format_t *f)
+{   uint32_t p, i;
+
+    _checkValue(f, 0);
+    _checkValue(f, 0x7FFFFFFFUL);
+    _checkValue(f, 0x80000000UL);
+    _checkValue(f, 0xFFFFFFFFUL);
+    for(p = 1; p != 0; p <<= 1)  /* powers of 2 */
+    {   _checkValue(f, p - 1);
+        _checkValue(f, p);
+        _checkValue(f, p + 1);
+        _checkValue(f, 0 - p);
+    }
+    for(p = 1; p <= 1000000000UL; p *= 10)  /* powers of 10 */
+    {   _checkValue(f, p - 1);
+        _checkValue(f, p);
+        _checkValue(f, p + 1);
+        _checkValue(f, 0 - p);
+        _checkValue(f, 0 - p + 1);
+    }
+    for(i = 0; i < 65536UL; i += 97)  /* 16 bit arithmetic of the digit pairs */
+    {   _checkValue(f, i);
+    }
+    for(i = 0; i < RANDOM_VALUES; i++)
+    {   _checkValue(f, _random() >> (i % 32));
+    }
+    if(nValues_g > 0)
+    {   _compareBatch(f);
+    }
+}
+
+
+int main(void)
+{   static const Format_t formats[] =
+    {   { "%d",    ARG_INT   }, { "%i",    ARG_INT   }, { "%5d",   ARG_INT   },
+        { "%-7d",  ARG_INT   }, { "%012d", ARG_INT   }, { "%-08d", ARG_INT   },
+        { "%u",    ARG_UINT  }, { "%10u",  ARG_UINT  }, { "%x",    ARG_UINT  },
+        { "%X",    ARG_UINT  }, { "%04x",  ARG_UINT  }, { "%-9X",  ARG_UINT  },
+        { "%ld",   ARG_LONG  }, { "%011ld",ARG_LONG  }, { "%lu",   ARG_ULONG },
+        { "%-12lu",ARG_ULONG }, { "%lx",   ARG_ULONG }, { "%08lX", ARG_ULONG },
+        { "%c",    ARG_CHAR  }, { "%3c",   ARG_CHAR  }, { "%-2c",  ARG_CHAR  },
+        { "%s",    ARG_STR   }, { "%6s",   ARG_STR   }, { "%-5s",  ARG_STR   },
+        { "%% %d %%", ARG_INT },
+    };
+    size_t i;
+
+    capture_g = tmpfile();
+    stdoutFd_g = dup(STDOUT_FILENO);
+    if((NULL == capture_g) || (stdoutFd_g < 0))
+    {   fprintf(stderr, "cannot create the capture file\n");
+        return 1;
+    }
+    serInit(9600UL);
+    fflush(stdout);
+    dup2(fileno(capture_g), STDOUT_FILENO);  /* serPrintf() writes to stdout */
+
+    for(i = 0; i < sizeof(formats) / sizeof(formats[0]); i++)
+    {   _checkFormat(&formats[i]);
+    }
+
+    dup2(stdoutFd_g, STDOUT_FILENO);
+    printf("serPrintf: %lu values, %lu batches with differences\n",
+           (unsigned long) nChecked_g, (unsigned long) nFailed_g);
+    return (0 == nFailed_g) ? 0 : 1;
+}
@@ -0,0 +1,54 @@
+# Runs the demos with buffered serial output (COS_SER_TX_BUFFER=1024):
+# their output has to be complete, i.e. end with the last line the demo
+# prints. The demos are built twice, without and with COS_TRACE: with
+# the trace recorder, the posix demo ends with a trace dump of several
+# kilobytes, far more than the buffer. Called by the target
+# cos_check_tx_buffer in CMakeLists.txt:
+#
+#   cmake --build build --target cos_check_tx_buffer
+#
+# SRC_DIR is the top source directory, BIN_DIR the build directory of
+# the demos, CORO_DEMO is ON, if the coroutine demo is built.
+
+foreach(trace OFF ON)
+  set(dir ${BIN_DIR}/trace_${trace})
+  execute_process(COMMAND ${CMAKE_COMMAND} -S ${SRC_DIR} -B ${dir}
+                          -DCOS_SER_TX_BUFFER=1024 -DCOS_TRACE=${trace}
+                  RESULT_VARIABLE rc OUTPUT_QUIET)
+  if(NOT rc EQUAL 0)
+    message(FATAL_ERROR "configuring the demos with TX buffer (COS_TRACE=${trace}) failed")
+  endif()
+  execute_process(COMMAND ${CMAKE_COMMAND} --build ${dir}
+                  RESULT_VARIABLE rc OUTPUT_QUIET)
+  if(NOT rc EQUAL 0)
+    message(FATAL_ERROR "building the demos with TX buffer (COS_TRACE=${trace}) failed")
+  endif()
+
+  # demo and the text of its last line
+  if(trace)
+    set(demos "cos_posix_demo" "COSTRACE END")
+  else()
+    set(demos "cos_posix_demo" "Allocs:")
+  endif()
+  list(APPEND demos "cos_cyclic_demo" "major frame  3")
+  if(CORO_DEMO)
+    list(APPEND demos "cos_coro_demo" "frames used")
+  endif()
+
+  list(LENGTH demos n)
+  math(EXPR last "${n} - 1")
+  foreach(i RANGE 0 ${last} 2)
+    math(EXPR j "${i} + 1")
+    list(GET demos ${i} demo)
+    list(GET demos ${j} lastLine)
+    execute_process(COMMAND ${dir}/${demo}
+                    INPUT_FILE /dev/null
+                    OUTPUT_VARIABLE out RESULT_VARIABLE rc)
+    string(LENGTH "${out}" len)
+    string(FIND "${out}" "${lastLine}" pos REVERSE)
+    if(NOT rc EQUAL 0 OR pos EQUAL -1)
+      message(FATAL_ERROR "${demo} (COS_TRACE=${trace}): output incomplete (${len} bytes, exit ${rc})")
+    endif()
+    message(STATUS "${demo} (COS_TRACE=${trace}): ${len} bytes, ok")
+  endforeach()
+endforeach()
@@ -0,0 +1,211 @@
+/*!
+ ********************************************************************
+   @file            frametool.c
+   @par Project   : co-operative scheduler (COS)
+   @par Module    : Host tool: binary frames of cos_frame
+
+   @brief  Decodes the frames of cos_frame.c read from stdin and writes
+           one line per frame to stdout, or encodes one frame to stdout.
+           Task frames (COS_FrameSendTaskList()) and text frames are
+           shown as text, other types as hex bytes. Frames with an error
+           are counted on stderr, e.g. text output of the target between
+           the frames.
+   @verbatim
+   ./build/cos_posix_demo | ./build/cos_frametool
+   ./build/cos_frametool -e 0x80 0x78 0x00 > /dev/ttyUSB0   (type, payload bytes)
+   ./build/cos_frametool -t "hello" > /dev/ttyUSB0           (text frame)
+   @endverbatim
+
+           This program runs on the host, it is not part of the COS
+           library; it uses the encoder and decoder of cos_frame.c.
+
+   @par Author    : Ernst Forgber (Fgb)
+   @par Company   : Hochschule Hannover - University of Applied Sciences and Arts, Germany
+   @par Department: Faculty 1
+ ********************************************************************
+
+   @par History   :
+   @verbatim
+   Version | Date        | Author | Change Description
+   0.0     | 18.10. 2026 | Fgb    | First Version
+   @endverbatim
+
+ ********************************************************************/
+/**************************************************************************
+
+Copyright 2026 Ernst Forgber
+
+
+This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cos_frame.h"
+
+
+#define MAX_PAYLOAD   252
+#define MAX_ENCODED   COS_FRAME_ENCODED_SIZE(MAX_PAYLOAD)
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Reads a 16 or 32 bit value, low byte first.
+ ************************************************************************/
+static unsigned long _get(const uint8_t *p, int size)
+{   unsigned long x = 0;
+    while(size-- > 0)
+    {   x = (x << 8) | p[size];
+    }
+    return x;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Shows a frame of type COS_FRAME_TYPE_TASK, see COS_FrameSendTaskList().
+ ************************************************************************/
+static void _printTask(const uint8_t *p, int len)
+{   unsigned flags;
+    int need;
+
+    if(len < 9)
+    {   printf("task: too short\n");
+        return;
+    }
+    flags = p[8];
+    need = 9 + ((flags & 1) ? 12 : 0) + ((flags & 2) ? 12 : 0) + ((flags & 4) ? 2 : 0);
+    if(len < need)
+    {   printf("task: too short\n");
+        return;
+    }
+    printf("task 0x%08lx state %u prio %u line %lu",
+           _get(p, 4), p[4], p[5], _get(p + 6, 2));
+    p += 9;
+    if(flags & 1)
+    {   printf(" runs %lu avg %lu max %lu", _get(p, 4), _get(p + 4, 4), _get(p + 8, 4));
+        p += 12;
+    }
+    if(flags & 2)
+    {   printf(" lat_p50 %lu lat_p99 %lu lat_max %lu", _get(p, 4), _get(p + 4, 4), _get(p + 8, 4));
+        p += 12;
+    }
+    if(flags & 4)
+    {   printf(" overruns %lu", _get(p, 2));
+    }
+    printf("\n");
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Encodes a frame and writes it to stdout.
+ ************************************************************************/
+static int _send(unsigned type, const uint8_t *payload, int len)
+{   uint8_t out[MAX_ENCODED];
+    int16_t n;
+
+    if((type > 0xFF) || (len > MAX_PAYLOAD))
+    {   return 1;
+    }
+    n = COS_FrameEncode(out, sizeof(out), (uint8_t) type, payload, (uint8_t) len);
+    fwrite(out, 1, (size_t) n, stdout);
+    return 0;
+}
+
+
+
+int main(int argc, char *argv[])
+{   uint8_t buf[MAX_ENCODED];
+    unsigned long frames = 0, errors = 0;
+    int c, len = 0, overflow = 0, i;
+    int16_t n;
+
+    if((argc >= 3) && (0 == strcmp(argv[1], "-t")))
+    {   return _send(COS_FRAME_TYPE_TEXT, (const uint8_t *) argv[2], (int) strlen(argv[2]));
+    }
+    if((argc >= 3) && (0 == strcmp(argv[1], "-e")))
+    {   for(i = 3; (i < argc) && (i - 3 < MAX_PAYLOAD); i++)
+        {   buf[i - 3] = (uint8_t) strtoul(argv[i], NULL, 0);
+        }
+        return _send((unsigned) strtoul(argv[2], NULL, 0), buf, argc - 3);
+    }
+    if(argc > 1)
+    {   fprintf(stderr, "usage: %s < frames > text\n"
+                        "       %s -e type [byte ...] > frame\n"
+                        "       %s -t text > frame\n", argv[0], argv[0], argv[0]);
+        return 1;
+    }
+
+    while(EOF != (c = getchar()))
+    {   if(c != 0)
+        {   if(len < (int) sizeof(buf))
+            {   buf[len++] = (uint8_t) c;
+            }
+            else
+            {   overflow = 1;
+            }
+            continue;
+        }
+        if(len == 0)
+        {   continue;
+        }
+        n = overflow ? -1 : COS_FrameDecode(buf, (uint16_t) len);
+        len = 0;
+        overflow = 0;
+        if(n < 0)
+        {   errors++;
+            continue;
+        }
+        frames++;
+        if(buf[0] == COS_FRAME_TYPE_TEXT)
+        {   printf("text \"%.*s\"\n", n - 1, (const char *)(buf + 1));
+        }
+        else if(buf[0] == COS_FRAME_TYPE_TASK)
+        {   _printTask(buf + 1, n - 1);
+        }
+        else
+        {   printf("type 0x%02x:", buf[0]);
+            for(i = 1; i < n; i++)
+            {   printf(" %02x", buf[i]);
+            }
+            printf("\n");
+        }
+    }
+    fprintf(stderr, "%lu frames, %lu errors\n", frames, errors);
+    return 0;
+}
@@ -0,0 +1,337 @@
+/*!
+ ********************************************************************
+   @file            log2txt.c
+   @par Project   : co-operative scheduler (COS)
+   @par Module    : Host tool: log records to text
+
+   @brief  Reads the frames of COS_LogSend() (see cos_log.c) from stdin
+           and prints one line per log record: time in seconds, source
+           file and line, formatted message. The format strings are
+           taken from the source files given on the command line as
+           number=path, the numbers are the COS_LOG_FILE values of the
+           files:
+   @verbatim
+   ./build/cos_log2txt 0=src/main.c 1=src/motor.c < /dev/ttyUSB0
+   @endverbatim
+
+           The string table is built from the sources at start, so
+           they have to be those of the program on the target. Records
+           of unknown lines, or with another number of arguments, are
+           shown with their raw arguments. Other
+           frames and frames with an error are skipped and counted on
+           stderr.
+
+           This program runs on the host, it is not part of the COS
+           library; it uses the frame decoder of cos_frame.c.
+
+   @par Author    : Ernst Forgber (Fgb)
+   @par Company   : Hochschule Hannover - University of Applied Sciences and Arts, Germany
+   @par Department: Faculty 1
+ ********************************************************************
+
+   @par History   :
+   @verbatim
+   Version | Date        | Author | Change Description
+   0.0     | 18.10. 2026 | Fgb    | First Version
+   @endverbatim
+
+ ********************************************************************/
+/**************************************************************************
+
+Copyright 2026 Ernst Forgber
+
+
+This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "cos_frame.h"
+
+
+#define MAX_FILES     4096  /*!< file numbers are 12 bit values */
+#define LINE_LEN      1024
+#define MAX_ENCODED   COS_FRAME_ENCODED_SIZE(252)
+
+
+/*! format string of a log statement */
+typedef struct
+{   unsigned file;
+    unsigned line;
+    unsigned nArgs;
+    char *fmt;
+} Format_t;
+
+
+static const char *files_g[MAX_FILES];  /*!< paths from command line */
+static Format_t *formats_g = NULL;      /*!< string table */
+static size_t nFormats_g = 0;
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Copies the string literal starting at s (behind the opening quote)
+ * and resolves the common escape sequences.
+ ************************************************************************/
+static char *_literal(const char *s)
+{   char *out = malloc(strlen(s) + 1), *p = out;
+
+    while((*s != '\0') && (*s != '"'))
+    {   if((*s == '\\') && (s[1] != '\0'))
+        {   s++;
+            switch(*s)
+            {   case 'n': *p++ = '\n'; break;
+                case 'r': *p++ = '\r'; break;
+                case 't': *p++ = '\t'; break;
+                default:  *p++ = *s;   break;
+            }
+            s++;
+        }
+        else
+        {   *p++ = *s++;
+        }
+    }
+    *p = '\0';
+    return out;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Adds the COS_LOGn() statements of a source file to the string table.
+ ************************************************************************/
+static int _scanFile(unsigned file, const char *path)
+{   char line[LINE_LEN];
+    const char *s, *q;
+    unsigned lineNo = 0;
+    FILE *f = fopen(path, "r");
+
+    if(NULL == f)
+    {   return -1;
+    }
+    while(NULL != fgets(line, sizeof(line), f))
+    {   lineNo++;
+        s = strstr(line, "COS_LOG");
+        if((NULL == s) || (s[7] < '0') || (s[7] > '4') || (s[8] != '('))
+        {   continue;  /* no log statement, e.g. COS_LOG_FILE */
+        }
+        q = strchr(s, '"');
+        if(NULL == q)
+        {   continue;
+        }
+        formats_g = realloc(formats_g, (nFormats_g + 1) * sizeof(Format_t));
+        formats_g[nFormats_g].file = file;
+        formats_g[nFormats_g].line = lineNo;
+        formats_g[nFormats_g].nArgs = (unsigned)(s[7] - '0');
+        formats_g[nFormats_g].fmt = _literal(q + 1);
+        nFormats_g++;
+    }
+    fclose(f);
+    return 0;
+}
+
+
+
+static const Format_t *_find(unsigned file, unsigned line)
+{   size_t i;
+
+    for(i = 0; i < nFormats_g; i++)
+    {   if((formats_g[i].file == file) && (formats_g[i].line == line))
+        {   return &formats_g[i];
+        }
+    }
+    return NULL;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Prints a message like printf(), with 32 bit arguments from the
+ * record. Length modifiers are ignored, %s is shown as '?'.
+ ************************************************************************/
+static void _format(const char *fmt, const uint32_t *args, unsigned nArgs)
+{   char spec[32];
+    size_t n;
+    unsigned a = 0;
+
+    while(*fmt != '\0')
+    {   if(*fmt != '%')
+        {   putchar(*fmt++);
+            continue;
+        }
+        n = 0;
+        spec[n++] = *fmt++;
+        while((*fmt != '\0') && (strchr("-+ #0123456789.", *fmt) != NULL) && (n < sizeof(spec) - 3))
+        {   spec[n++] = *fmt++;
+        }
+        while((*fmt != '\0') && (strchr("hlLjzt", *fmt) != NULL))
+        {   fmt++;
+        }
+        if(*fmt == '\0')
+        {   break;
+        }
+        if(*fmt == '%')
+        {   putchar('%');
+            fmt++;
+            continue;
+        }
+        if(strchr("diuxXoc", *fmt) == NULL)
+        {   putchar('?');  /* %s, %f, ...: not available */
+            fmt++;
+            a++;
+            continue;
+        }
+        spec[n++] = *fmt;
+        spec[n] = '\0';
+        if(a >= nArgs)
+        {   putchar('?');
+        }
+        else if((*fmt == 'd') || (*fmt == 'i') || (*fmt == 'c'))
+        {   printf(spec, (int)(int32_t)args[a]);
+        }
+        else
+        {   printf(spec, (unsigned)args[a]);
+        }
+        a++;
+        fmt++;
+    }
+}
+
+
+
+int main(int argc, char *argv[])
+{   uint8_t buf[MAX_ENCODED];
+    unsigned long frames = 0, errors = 0, other = 0;
+    uint64_t t = 0, mask = 0;
+    uint32_t last = 0, time, header, args[4];
+    unsigned file, line, nArgs, usPerTick, k;
+    int c, len = 0, overflow = 0, started = 0, i;
+    const Format_t *f;
+    int16_t n;
+    char *eq;
+
+    for(i = 1; i < argc; i++)  /* source files: number=path */
+    {   eq = strchr(argv[i], '=');
+        file = (unsigned) strtoul(argv[i], NULL, 0);
+        if((NULL == eq) || (file >= MAX_FILES) || !isdigit((unsigned char)argv[i][0]))
+        {   fprintf(stderr, "usage: %s number=source.c ... < frames\n", argv[0]);
+            return 1;
+        }
+        files_g[file] = eq + 1;
+        if(0 != _scanFile(file, eq + 1))
+        {   fprintf(stderr, "%s: cannot read %s\n", argv[0], eq + 1);
+            return 1;
+        }
+    }
+
+    while(EOF != (c = getchar()))
+    {   if(c != 0)
+        {   if(len < (int) sizeof(buf))
+            {   buf[len++] = (uint8_t) c;
+            }
+            else
+            {   overflow = 1;
+            }
+            continue;
+        }
+        if(len == 0)
+        {   continue;
+        }
+        n = overflow ? -1 : COS_FrameDecode(buf, (uint16_t) len);
+        len = 0;
+        overflow = 0;
+        if(n < 0)
+        {   errors++;
+            continue;
+        }
+        if((buf[0] != COS_FRAME_TYPE_LOG) || (n < 5))
+        {   other++;
+            continue;
+        }
+        frames++;
+        usPerTick = buf[1] | (buf[2] << 8);
+        mask = (buf[3] == 16) ? 0xFFFFULL : 0xFFFFFFFFULL;
+        if(buf[4] > 0)
+        {   printf("... %u%s records lost\n", buf[4], (buf[4] == 255) ? " or more" : "");
+        }
+        for(k = 5; k + 8 <= (unsigned) n; )
+        {   time = buf[k] | (buf[k + 1] << 8) | (buf[k + 2] << 16) | ((uint32_t)buf[k + 3] << 24);
+            header = buf[k + 4] | (buf[k + 5] << 8) | (buf[k + 6] << 16) | ((uint32_t)buf[k + 7] << 24);
+            k += 8;
+            nArgs = header >> 28;
+            file = (header >> 16) & 0xFFF;
+            line = header & 0xFFFF;
+            if((nArgs > 4) || (k + 4 * nArgs > (unsigned) n))
+            {   break;
+            }
+            for(i = 0; i < (int) nArgs; i++, k += 4)
+            {   args[i] = buf[k] | (buf[k + 1] << 8) | (buf[k + 2] << 16) | ((uint32_t)buf[k + 3] << 24);
+            }
+            /* time stamps wrap around, records are in time order */
+            if(!started)
+            {   t = time & mask;
+                started = 1;
+            }
+            else
+            {   t += ((uint64_t)time - last) & mask;
+            }
+            last = time;
+
+            printf("%14.6f ", (double)t * usPerTick / 1e6);
+            if(NULL != files_g[file])
+            {   printf("%s:%u ", files_g[file], line);
+            }
+            else
+            {   printf("%u:%u ", file, line);
+            }
+            f = _find(file, line);
+            if((NULL != f) && (f->nArgs == nArgs))  /* else: other sources */
+            {   _format(f->fmt, args, nArgs);
+            }
+            else
+            {   printf("?");
+                for(i = 0; i < (int) nArgs; i++)
+                {   printf(" 0x%x", (unsigned)args[i]);
+                }
+            }
+            printf("\n");
+        }
+    }
+    fprintf(stderr, "%lu log frames, %lu other frames, %lu errors\n", frames, other, errors);
+    return 0;
+}
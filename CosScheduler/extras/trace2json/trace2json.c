@@ -0,0 +1,284 @@
+/*!
+ ********************************************************************
+   @file            trace2json.c
+   @par Project   : co-operative scheduler (COS)
+   @par Module    : Host tool: trace dump to Chrome trace JSON
+
+   @brief  Reads the output of COS_TraceDump() (see cos_trace.c) from
+           stdin and writes Chrome trace JSON to stdout. Text before
+           the line 'COSTRACE 1 ...' is ignored, so a complete log of
+           the serial interface may be used as input. Open the result
+           in chrome://tracing or https://ui.perfetto.dev: every task
+           is shown as a thread, each call of its task function as a
+           slice. Blocking, un-blocking, FIFO accesses, task creation,
+           deletion, priority changes and budget violations are instant
+           events.
+
+           Task names may be given on the command line as id=name, the
+           ids are counted from 1 in the order of task creation:
+   @verbatim
+   ./build/cos_trace2json 1=timer 2=producer 3=consumer < dump.txt > trace.json
+   @endverbatim
+
+           This program runs on the host, it is not part of the COS
+           library.
+
+   @par Author    : Ernst Forgber (Fgb)
+   @par Company   : Hochschule Hannover - University of Applied Sciences and Arts, Germany
+   @par Department: Faculty 1
+ ********************************************************************
+
+   @par History   :
+   @verbatim
+   Version | Date        | Author | Change Description
+   0.0     | 18.10. 2026 | Fgb    | First Version
+   0.1     | 18.10. 2026 | Fgb    | budget violation event
+   0.2     | 18.10. 2026 | Fgb    | task names escaped in JSON strings
+   @endverbatim
+
+ ********************************************************************/
+/**************************************************************************
+
+Copyright 2026 Ernst Forgber
+
+
+This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+
+/* event types, same values as in cos_trace.h */
+#define COS_TRACE_DISPATCH_START  1
+#define COS_TRACE_DISPATCH_END    2
+#define COS_TRACE_BLOCK           3
+#define COS_TRACE_UNBLOCK         4
+#define COS_TRACE_FIFO_WRITE      5
+#define COS_TRACE_FIFO_READ       6
+#define COS_TRACE_TASK_CREATE     7
+#define COS_TRACE_TASK_DELETE     8
+#define COS_TRACE_PRIO_CHANGE     9
+#define COS_TRACE_BUDGET         10
+
+#define MAX_TASK_ID   0xFFFF  /*!< task ids are 16 bit values */
+#define LINE_LEN      256
+
+
+static const char *names_g[MAX_TASK_ID + 1];     /*!< names from command line */
+static unsigned char known_g[MAX_TASK_ID + 1];   /*!< thread name already written */
+static unsigned char running_g[MAX_TASK_ID + 1]; /*!< slice of task is open */
+static int first_g = 1;                          /*!< no JSON event written yet */
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Starts a new JSON event, with a separator if it is not the first.
+ ************************************************************************/
+static void _beginEvent(void)
+{   printf(first_g ? "\n  {" : ",\n  {");
+    first_g = 0;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Writes a string from the command line into a JSON string: quote,
+ * backslash and control characters are escaped.
+ ************************************************************************/
+static void _putJsonString(const char *s)
+{   for(; *s != '\0'; s++)
+    {   if((*s == '"') || (*s == '\\'))
+        {   printf("\\%c", *s);
+        }
+        else if((unsigned char)*s < 0x20)
+        {   printf("\\u%04x", (unsigned char)*s);
+        }
+        else
+        {   putchar(*s);
+        }
+    }
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Writes the thread name of a task, once per task. Id 0 is shown as
+ * 'scheduler'.
+ ************************************************************************/
+static void _nameTask(unsigned id, int prio)
+{   if(known_g[id])
+    {   return;
+    }
+    known_g[id] = 1;
+    _beginEvent();
+    printf("\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"", id);
+    if(NULL != names_g[id])
+    {   _putJsonString(names_g[id]);
+    }
+    else if(0 == id)
+    {   printf("scheduler");
+    }
+    else
+    {   printf("task %u", id);
+    }
+    if(prio >= 0)
+    {   printf(" (prio %d)", prio);
+    }
+    printf("\"}}");
+    _beginEvent();
+    printf("\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"sort_index\":%u}}", id, id);
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Writes an instant event with an optional argument.
+ ************************************************************************/
+static void _instant(const char *name, unsigned id, double ts, const char *argName, unsigned arg)
+{   _beginEvent();
+    printf("\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%u,\"ts\":%.3f", name, id, ts);
+    if(NULL != argName)
+    {   printf(",\"args\":{\"%s\":%u}", argName, arg);
+    }
+    printf("}");
+}
+
+
+
+int main(int argc, char *argv[])
+{   char line[LINE_LEN];
+    unsigned version = 0, usPerTick = 1, bits = 32;
+    unsigned long lost = 0;
+    unsigned long time, id, event, arg;
+    uint64_t t = 0, last = 0, mask;
+    int started = 0, i;
+    double ts;
+
+    for(i = 1; i < argc; i++)  /* task names: id=name */
+    {   char *eq = strchr(argv[i], '=');
+        id = strtoul(argv[i], NULL, 0);
+        if((NULL == eq) || (id > MAX_TASK_ID))
+        {   fprintf(stderr, "usage: %s [id=name ...] < dump > trace.json\n", argv[0]);
+            return 1;
+        }
+        names_g[id] = eq + 1;
+    }
+
+    while(NULL != fgets(line, sizeof(line), stdin))
+    {   if(sscanf(line, "COSTRACE %u %u %u %lu", &version, &usPerTick, &bits, &lost) == 4)
+        {   started = 1;
+            break;
+        }
+    }
+    if(!started || (version != 1) || ((bits != 16) && (bits != 32)))
+    {   fprintf(stderr, "%s: no COSTRACE 1 dump found\n", argv[0]);
+        return 1;
+    }
+    if(lost > 0)
+    {   fprintf(stderr, "%s: %lu older events were overwritten on the target\n", argv[0], lost);
+    }
+    mask = (bits == 32) ? 0xFFFFFFFFULL : 0xFFFFULL;
+
+    printf("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    while(NULL != fgets(line, sizeof(line), stdin))
+    {   if(0 == strncmp(line, "COSTRACE END", 12))
+        {   break;
+        }
+        if(sscanf(line, "%lx %lx %lx %lx", &time, &id, &event, &arg) != 4)
+        {   continue;  /* not a record, e.g. other output of the target */
+        }
+        /* time stamps wrap around, records are in time order */
+        if(started == 1)
+        {   t = time & mask;
+            started = 2;
+        }
+        else
+        {   t += ((uint64_t)time - last) & mask;
+        }
+        last = time;
+        ts = (double)t * usPerTick;
+        id &= MAX_TASK_ID;
+
+        _nameTask(id, (event == COS_TRACE_TASK_CREATE) ? (int)arg : -1);
+        switch(event)
+        {   case COS_TRACE_DISPATCH_START:
+                _beginEvent();
+                printf("\"name\":\"run\",\"ph\":\"B\",\"pid\":1,\"tid\":%lu,\"ts\":%.3f}", id, ts);
+                running_g[id] = 1;
+                break;
+            case COS_TRACE_DISPATCH_END:
+                if(running_g[id])  /* start may have been overwritten */
+                {   _beginEvent();
+                    printf("\"name\":\"run\",\"ph\":\"E\",\"pid\":1,\"tid\":%lu,\"ts\":%.3f}", id, ts);
+                    running_g[id] = 0;
+                }
+                break;
+            case COS_TRACE_BLOCK:
+                _instant("block", id, ts, NULL, 0);
+                break;
+            case COS_TRACE_UNBLOCK:
+                _instant("unblock", id, ts, NULL, 0);
+                break;
+            case COS_TRACE_FIFO_WRITE:
+                _instant("fifo write", id, ts, "usedSlots", arg);
+                break;
+            case COS_TRACE_FIFO_READ:
+                _instant("fifo read", id, ts, "usedSlots", arg);
+                break;
+            case COS_TRACE_TASK_CREATE:
+                _instant("create", id, ts, "prio", arg);
+                break;
+            case COS_TRACE_TASK_DELETE:
+                _instant("delete", id, ts, NULL, 0);
+                break;
+            case COS_TRACE_PRIO_CHANGE:
+                _instant("prio", id, ts, "prio", arg);
+                break;
+            case COS_TRACE_BUDGET:
+                _instant("budget overrun", id, ts, NULL, 0);
+                break;
+            default:
+                _instant("unknown", id, ts, "event", event);
+                break;
+        }
+    }
+    printf("\n]}\n");
+    return 0;
+}
@@ -33,15 +33,15 @@ This program is free software: you can redistribute it and/or modify
     You should have received a copy of the GNU General Public License
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
-    Dieses Programm ist Freie Software: Sie knnen es unter den Bedingungen
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
     der GNU General Public License, wie von der Free Software Foundation,
     Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
-    verffentlichten Version, weiterverbreiten und/oder modifizieren.
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
 
-    Dieses Programm wird in der Hoffnung, dass es ntzlich sein wird, aber
-    OHNE JEDE GEWHRLEISTUNG, bereitgestellt; sogar ohne die implizite
-    Gewhrleistung der MARKTFHIGKEIT oder EIGNUNG FR EINEN BESTIMMTEN ZWECK.
-    Siehe die GNU General Public License fr weitere Details.
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
 
     Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
     Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
@@ -54,6 +54,7 @@ This program is free software: you can redistribute it and/or modify
 #define PLATFORM_OPEN_CM_9_04       1  /*!<  platform: openCM , ARM */
 #define PLATFORM_ARDUINO            2  /*!<  platform: arduino */
 #define PLATFORM_RENESAS_RX63N      3  /*!<  platform: renesas RX63N */
+#define PLATFORM_POSIX              4  /*!<  platform: Linux or other POSIX host */
 
 /********* end of: "don't edit this" *******/
 
@@ -62,11 +63,92 @@ This program is free software: you can redistribute it and/or modify
 /******* select the platform COS will be running on ********************/
 /******* un-comment ONLY ONE of the following options ******************/
 /***********************************************************************/
+#ifndef COS_PLATFORM  /* may be set by the build system, e.g. -DCOS_PLATFORM=PLATFORM_POSIX */
 #define COS_PLATFORM        PLATFORM_OPEN_CM_9_04 /*!< select COS platform */
 //#define COS_PLATFORM      PLATFORM_ARDUINO
 //#define COS_PLATFORM      PLATFORM_RENESAS_RX63N
+//#define COS_PLATFORM      PLATFORM_POSIX
+#endif
+
+
+
+/***********************************************************************/
+/******* optional features: 1 to include, 0 to remove the code *********/
+/***********************************************************************/
+#define COS_FIFO_STATISTICS     1 /*!< occupancy and blocking counters per FIFO */
+#define COS_TASK_STATISTICS     1 /*!< run count and execution times per task */
+#define COS_MEMORY_STATISTICS   1 /*!< counters of the heap memory used by COS, see cos_memory.h */
+#define COS_TASK_BUDGET         1 /*!< watchdog for the execution time of task calls, see COS_SetTaskBudget() */
+#define COS_SCHEDULER_COUNTERS  1 /*!< efficiency counters of the scheduler loop, see COS_GetSchedulerCounters() */
+#ifndef COS_TRACE  /* may be set by the build system */
+#define COS_TRACE               0 /*!< trace recorder for scheduler events, see cos_trace.h */
+#endif
+#define COS_TRACE_BUFFER_EVENTS 256 /*!< trace records in RAM, 8 bytes each, power of two */
+#ifndef COS_TASK_LATENCY  /* may be set by the build system */
+#define COS_TASK_LATENCY        0 /*!< wake-up latency histogram per task, see cos_latency.h */
+#endif
+#define COS_LATENCY_BUCKETS     48 /*!< 2 bytes each per task, 48: up to 7167 ticks, longer in last bucket */
+#ifndef COS_LOG  /* may be set by the build system */
+#define COS_LOG                 0 /*!< deferred-format logging, see cos_log.h */
+#endif
+#define COS_LOG_BUFFER_WORDS    256 /*!< log records in RAM, 4 bytes per word, power of two */
+
+
+
+/***********************************************************************/
+/******* system time base **********************************************/
+/***********************************************************************/
+/* With 32 bit ticks of 1 microsecond, sleep times up to 71 minutes are
+   possible. 16 bit ticks save 4 bytes of RAM per task, but limit sleep
+   times to 65535 ticks.
+*/
+#define COS_TICKS_32BIT         1 /*!< 1: 32 bit tick counter, 0: 16 bit tick counter */
+
+#if COS_PLATFORM == PLATFORM_RENESAS_RX63N
+  #define COS_MICROSEC_PER_TICK 1000 /*!< fixed by the timer interrupt, don't edit this */
+#else
+  #define COS_MICROSEC_PER_TICK 1    /*!< length of a tick in microseconds */
+#endif
+
+/* Virtual time: the clock stands still while tasks run, the scheduler
+   jumps to the next activation time, when no task is ready. For
+   simulation and regression tests of task sets, e.g. on a POSIX host.
+*/
+#ifndef COS_VIRTUAL_TIME  /* may be set by the build system */
+#define COS_VIRTUAL_TIME        0 /*!< 1: virtual time, 0: real time */
+#endif
+/* Tasks with sleep time 0 (COS_TASK_SCHEDULE(), polling tasks) are always
+   ready, the clock would never jump. After this number of their calls
+   in a row, it jumps to the next activation of a sleeping task.
+*/
+#define COS_VIRTUAL_POLL_RUNS   32 /*!< calls of tasks with sleep time 0 per virtual time step */
+
+#if COS_PLATFORM == PLATFORM_OPEN_CM_9_04
+  #define COS_CPU_CLOCK_HZ      72000000UL /*!< core clock, counted by the DWT cycle counter */
+#endif
+
+
+
+/***********************************************************************/
+/******* serial output, RX63N and POSIX ********************************/
+/***********************************************************************/
+/* With a TX buffer, serPutc() does not wait for the UART, the bytes are
+   sent by a drain task (serTxStart()) or a TX-empty interrupt.
+*/
+#ifndef COS_SER_TX_BUFFER  /* may be set by the build system */
+#define COS_SER_TX_BUFFER       0  /*!< bytes of the TX buffer, power of two, 0: serPutc() waits for the UART */
+#endif
+#define COS_SER_TX_CHUNK        1  /*!< bytes sent per call of the drain task, the UART holds one byte */
+#define COS_FRAME_MAX_PAYLOAD   64 /*!< largest payload of COS_FrameSend() (35..252), on the stack while sending, see cos_frame.h */
+
 
 
+/***********************************************************************/
+/******* software timers ***********************************************/
+/***********************************************************************/
+#define COS_TIMER_MAX_TIMERS    32  /*!< maximum number of running timers (1..65534) */
+#define COS_TIMER_TASK_PRIO     254 /*!< priority of the timer task */
+
 
 
 #endif
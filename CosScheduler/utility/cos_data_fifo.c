@@ -32,6 +32,14 @@
    0.1     | 17.09. 2013 | Fgb           | nur noch Atmel, deutsche Doku.
    0.2     | 08.10. 2015 | Fgb           | Umbau auf renesas controller
    0.3     | 21.11. 2016 | Fgb           | english docu
+   0.4     | 18.10. 2026 | Fgb           | overwrite mode for streams of samples
+   0.5     | 18.10. 2026 | Fgb           | occupancy and blocking statistics
+   0.6     | 18.10. 2026 | Fgb           | trace events
+   0.7     | 18.10. 2026 | Fgb           | buffer from _memAlloc()
+   0.8     | 18.10. 2026 | Fgb           | 32 bit counters of blocked tasks
+   0.9     | 18.10. 2026 | Fgb           | writers woken by _setTaskReady()
+   0.10    | 18.10. 2026 | Fgb           | overwrite mode: every write releases blocked writers
+   0.11    | 18.10. 2026 | Fgb           | 16 bit buffer indexes, buffers of up to 255 * 255 bytes
    @endverbatim
 
  ********************************************************************/
@@ -53,15 +61,15 @@ This program is free software: you can redistribute it and/or modify
     You should have received a copy of the GNU General Public License
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
-    Dieses Programm ist Freie Software: Sie knnen es unter den Bedingungen
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
     der GNU General Public License, wie von der Free Software Foundation,
     Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
-    verffentlichten Version, weiterverbreiten und/oder modifizieren.
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
 
-    Dieses Programm wird in der Hoffnung, dass es ntzlich sein wird, aber
-    OHNE JEDE GEWHRLEISTUNG, bereitgestellt; sogar ohne die implizite
-    Gewhrleistung der MARKTFHIGKEIT oder EIGNUNG FR EINEN BESTIMMTEN ZWECK.
-    Siehe die GNU General Public License fr weitere Details.
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
 
     Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
     Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
@@ -73,9 +81,14 @@ This program is free software: you can redistribute it and/or modify
 #include <string.h>  // for memcpy()
 #include "cos_ser.h"
 #include "cos_data_fifo.h"
+#include "cos_memory.h"
 
 
 
+/*! size of the buffer in bytes, at most 255 * 255, computed in 16 bit
+    unsigned arithmetic: an int of 16 bit would overflow */
+#define BUFFER_SIZE(q)  ((uint16_t)((uint16_t)(q)->maxSlots * (q)->slotSize))
+
 
 /*------------- DEBUGGING ---------------------------------*/
 #define DEBUG_MODULE 0  /*!< 0 for no additional debug code, 1 otherwise */ 
@@ -96,6 +109,51 @@ static void _msg(char *msg)
 
 
 
+#if COS_FIFO_STATISTICS
+/*!
+ **********************************************************************
+ * @par Description:
+ * Adds the time since the last change of the number of waiting tasks
+ * to the blocked ticks, once for every task waiting. Has to be called
+ * before the number of waiting tasks changes.
+ ************************************************************************/
+static void _qStatAccumulate(CosFifo_t *q)
+{ CosTicks_t t_Ticks = _gettime_Ticks();
+  CosTicks_t dt = (CosTicks_t)(t_Ticks - q->stats.lastChange_Ticks);
+
+  q->stats.writerBlockedTicks += (uint32_t) dt * q->stats.nWritersWaiting;
+  q->stats.readerBlockedTicks += (uint32_t) dt * q->stats.nReadersWaiting;
+  q->stats.lastChange_Ticks = t_Ticks;
+}
+#endif
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Overwrite mode: un-blocks all writers waiting at wSema and lets the
+ * next ones pass. A writer may block in COS_SEM_WAIT(), while another
+ * one has passed it and yields before writing; reading does not signal
+ * wSema in this mode, so the next write has to release it.
+ ************************************************************************/
+static void _qReleaseWriters(CosFifo_t *q)
+{ CosTask_t *task_pt=NULL;
+
+  if(q->wSema.root_pt != NULL)
+  { FifoStatCode(_qStatAccumulate(q);
+                 q->stats.nWritersWaiting = 0;);
+    while(q->wSema.root_pt != NULL)
+    { task_pt = q->wSema.root_pt->task_pt;
+      _setTaskReady(task_pt);
+      q->wSema.root_pt = _unlinkTaskFromTaskList(q->wSema.root_pt, task_pt);
+    }
+  }
+  q->wSema.count = 1;  /* writers never block */
+}
+
+
+
 /*!
  **********************************************************************
  * @par Description:
@@ -110,8 +168,10 @@ static void _msg(char *msg)
  * @param  slotSize        - IN, size of data slot (1..255) in bytes
  * @param  nSlots          - IN, number of slots (1..255) in the FIFO
  *
+ * The buffer has slotSize * nSlots bytes, up to 255 * 255 = 65025.
+ *
  * @retval 0               - no error
- * @retval negative        - an error occurrred
+ * @retval negative        - an error occurrred, e.g. slotSize or nSlots 0
  *
  * @par Code example: 
  *    A global FIFO with 5 slots for float variables and a second queue with 2
@@ -137,8 +197,12 @@ int main(void)
  ************************************************************************/
 uint8_t COS_FifoCreate(CosFifo_t *q, uint8_t slotSize, uint8_t nSlots)
 {
+  if((0 == slotSize) || (0 == nSlots))
+  { DebugCode(_msg("FifoCreate:size 0!"););
+    return -1;
+  }
   /* create buffer */
-  q->buffer = (char *) malloc(slotSize * nSlots * sizeof(char));
+  q->buffer = (char *) _memAlloc((uint16_t) slotSize * nSlots * sizeof(char));
   if(NULL == q->buffer)
   { DebugCode(_msg("FifoCreate:malloc!"););
     return -1;
@@ -148,6 +212,10 @@ uint8_t COS_FifoCreate(CosFifo_t *q, uint8_t slotSize, uint8_t nSlots)
   q->rIndex    = 0;         /* empty queue */
   q->wIndex    = 0;
   q->usedSlots = 0;
+  q->mode      = COS_FIFO_MODE_BLOCKING;
+  q->droppedSlots = 0;
+  FifoStatCode(memset(&(q->stats), 0, sizeof(CosFifoStats_t));
+               q->stats.lastChange_Ticks = _gettime_Ticks(););
   if(0!= COS_SemCreate(&(q->rSema), 0))  // nothing to read yet
   {  DebugCode(_msg("FifoCreate:SemCreate!"););
      return -1;
@@ -191,7 +259,7 @@ uint8_t COS_FifoDestroy(CosFifo_t *q)
   }
   /* delete buffer */
   if(q->buffer != NULL)
-  { free(q->buffer);
+  { _memFree(q->buffer, BUFFER_SIZE(q) * sizeof(char));
     q->buffer = NULL;
   }
   q->isInitialized = 0;
@@ -312,6 +380,8 @@ int8_t COS_FifoIsFull(CosFifo_t *q)
  * The number of 
  * bytes to be written is 'slotSize', as declared at the call of 
  * COS_FifoCreate(). If the FIFO is full, nothing is written. 
+ * In mode COS_FIFO_MODE_OVERWRITE a full FIFO drops its oldest slot
+ * instead and the new data is always written.
  * 
  *
  * @see
@@ -330,6 +400,22 @@ int8_t _qWriteSingleSlot(CosFifo_t *q, const char *data)
   { DebugCode(_msg("_qWriteSingleSlot:not init"););
     return -1;
   }
+  if(q->mode == COS_FIFO_MODE_OVERWRITE)
+  { /* writers never wait for a slot, release the ones that blocked
+       while this writer yielded in COS_SEM_WAIT() */
+    _qReleaseWriters(q);
+    if(q->usedSlots >= q->maxSlots)  /* full: drop the oldest slot */
+    { q->rIndex += q->slotSize;
+      q->rIndex %= BUFFER_SIZE(q);
+      q->droppedSlots++;
+      memcpy(&(q->buffer[q->wIndex]), data, q->slotSize); /* copy to FIFO */
+      q->wIndex += q->slotSize;
+      q->wIndex %= BUFFER_SIZE(q);
+      FifoStatCode(q->stats.nWritten++;);
+      COS_TRACE_EVENT(COS_TRACE_FIFO_WRITE, NULL, q->usedSlots);
+      return 1;  /* number of used slots unchanged, no new item to signal */
+    }
+  }
   /* if FIFO is full, return 0 without writing any data */
   if(q->usedSlots >= q->maxSlots)
   { retval = 0;  /* FIFO is full, don't write */
@@ -338,8 +424,15 @@ int8_t _qWriteSingleSlot(CosFifo_t *q, const char *data)
   { retval = 1;
     memcpy(&(q->buffer[q->wIndex]), data, q->slotSize); /* copy to FIFO */
     q->wIndex += q->slotSize;                  /* next slot */
-    q->wIndex %= (q->maxSlots * q->slotSize);  /* circular buffer */
+    q->wIndex %= BUFFER_SIZE(q);               /* circular buffer */
     q->usedSlots  += 1;
+    COS_TRACE_EVENT(COS_TRACE_FIFO_WRITE, NULL, q->usedSlots);
+    FifoStatCode(q->stats.nWritten++;
+                 if(q->usedSlots > q->stats.maxUsedSlots) q->stats.maxUsedSlots = q->usedSlots;
+                 if(q->rSema.root_pt != NULL)  /* a reader will be un-blocked */
+                 {  _qStatAccumulate(q);
+                    q->stats.nReadersWaiting--;
+                 });
     COS_SEM_SIGNAL(&(q->rSema));  // unblock tasks that wait for reading,
   }
   return retval;
@@ -391,9 +484,17 @@ int8_t _qReadSingleSlot(CosFifo_t *q, char *data)
   {   retval = 1;
        memcpy(data, &(q->buffer[q->rIndex]), q->slotSize); /* read from queue */
        q->rIndex += q->slotSize;                  /* next slot to read */
-       q->rIndex %= (q->maxSlots * q->slotSize);  /* circular buffer */
+       q->rIndex %= BUFFER_SIZE(q);               /* circular buffer */
        q->usedSlots  -= 1;
-       COS_SEM_SIGNAL(&(q->wSema));  // unblock tasks that wait for writing
+       COS_TRACE_EVENT(COS_TRACE_FIFO_READ, NULL, q->usedSlots);
+       FifoStatCode(q->stats.nRead++;);
+       if(q->mode != COS_FIFO_MODE_OVERWRITE)
+       {   FifoStatCode(if(q->wSema.root_pt != NULL)  /* a writer will be un-blocked */
+                        {  _qStatAccumulate(q);
+                           q->stats.nWritersWaiting--;
+                        });
+           COS_SEM_SIGNAL(&(q->wSema));  // unblock tasks that wait for writing
+       }
   }
   return retval;
 }
@@ -474,3 +575,208 @@ uint8_t COS_FifoGetSlotSize(CosFifo_t *q)
 
 
 
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * This function sets the mode of a FIFO. After COS_FifoCreate(), a FIFO
+ * is in mode COS_FIFO_MODE_BLOCKING: a writer blocks, if there is
+ * no free slot.
+ * In mode COS_FIFO_MODE_OVERWRITE, writing never blocks. If the FIFO is
+ * full, the oldest slot is dropped and replaced by the new data, the
+ * number of dropped slots is counted. Readers always get the most
+ * recent 'maxSlots' items. This mode is meant for streams of sensor
+ * data, where a slow consumer must not stall the producer.
+ * Writers, that are blocked when switching to overwrite mode, are
+ * un-blocked.
+ *
+ * @see
+ * @arg  COS_FifoGetDroppedSlots(), COS_FifoBlockingWriteSingleSlot()
+ *
+ *
+ * @param  q               - IN/OUT, pointer to FIFO struct
+ * @param  mode            - IN, COS_FIFO_MODE_BLOCKING or COS_FIFO_MODE_OVERWRITE
+ *
+ * @retval 0               - no error
+ * @retval negative        - an error occurred
+ *
+ * @par Code example:
+ * @verbatim
+CosFifo_t samples;
+
+int main(void)
+{
+  ...
+  if(0!= COS_FifoCreate(&samples, sizeof(int16_t), 16))
+    serPuts("error creating queue");
+  COS_FifoSetMode(&samples, COS_FIFO_MODE_OVERWRITE);
+  ...
+}
+  @endverbatim
+ ************************************************************************/
+int8_t COS_FifoSetMode(CosFifo_t *q, uint8_t mode)
+{
+  if(q->isInitialized == 0)
+  { DebugCode(_msg("FifoSetMode:not init"););
+    return -1;
+  }
+  if(mode == COS_FIFO_MODE_OVERWRITE)
+  { _qReleaseWriters(q);  /* they will overwrite the oldest slots */
+  }
+  else if(mode == COS_FIFO_MODE_BLOCKING)
+  { q->wSema.count = q->maxSlots - q->usedSlots;  /* free slots */
+  }
+  else
+  { DebugCode(_msg("FifoSetMode:mode!"););
+    return -1;
+  }
+  q->mode = mode;
+  return 0;
+}
+
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * This function returns the number of slots, that have been overwritten
+ * in mode COS_FIFO_MODE_OVERWRITE before a reader could get them.
+ *
+ * @see COS_FifoSetMode()
+ * @arg  -
+ *
+ *
+ * @param  q               - IN/OUT, pointer to FIFO
+ *
+ * @retval number of dropped slots
+ ************************************************************************/
+uint16_t COS_FifoGetDroppedSlots(CosFifo_t *q)
+{
+  return q->droppedSlots;
+}
+
+
+
+
+#if COS_FIFO_STATISTICS
+/*!
+ **********************************************************************
+ * @par Description:
+ * This function copies the statistics of a FIFO. The counters help to
+ * size a FIFO from measurements: 'maxUsedSlots' is the high-water mark
+ * of used slots, 'nWritten' and 'nRead' count all slots passed through
+ * the FIFO. 'nWriterBlocked' and 'nReaderBlocked' count, how often a
+ * task blocked in COS_FifoBlockingWriteSingleSlot() or
+ * COS_FifoBlockingReadSingleSlot(), the blocked ticks sum up the
+ * time all these tasks were waiting, including tasks still blocked.
+ * The function is available, if COS_FIFO_STATISTICS is set in
+ * cos_configure.h.
+ *
+ * @see COS_FifoResetStatistics()
+ * @arg  -
+ *
+ *
+ * @param  q               - IN/OUT, pointer to FIFO
+ * @param  stats           - OUT, pointer to statistics struct
+ *
+ * @retval 0               - no error
+ * @retval negative        - an error occurred
+ *
+ * @par Code example:
+ * @verbatim
+CosFifo_t q01;
+
+void Task_Monitor(CosTask_t *pt)
+{   static CosFifoStats_t s;
+
+    COS_TASK_BEGIN(pt);
+    while(1)
+    {   COS_FifoGetStatistics(&q01, &s);
+        serPuts("\r\nmax used slots:"); serOutUint16Dec(s.maxUsedSlots);
+        serPuts("\r\nwriter blocked:"); serOutUint32Dec(s.nWriterBlocked);
+        COS_TASK_SLEEP(pt,_milliSecToTicks(1000));
+    }
+    COS_TASK_END(pt);
+}
+  @endverbatim
+ ************************************************************************/
+int8_t COS_FifoGetStatistics(CosFifo_t *q, CosFifoStats_t *stats)
+{
+  if(q->isInitialized == 0)
+  { DebugCode(_msg("FifoGetStatistics:not init"););
+    return -1;
+  }
+  _qStatAccumulate(q);  /* include the time of tasks still waiting */
+  *stats = q->stats;
+  return 0;
+}
+
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * This function clears the counters of a FIFO. The high-water mark is
+ * set to the number of slots currently used. Tasks waiting at the FIFO
+ * are still accounted for.
+ *
+ * @see COS_FifoGetStatistics()
+ * @arg  -
+ *
+ *
+ * @param  q               - IN/OUT, pointer to FIFO
+ *
+ * @retval 0               - no error
+ * @retval negative        - an error occurred
+ ************************************************************************/
+int8_t COS_FifoResetStatistics(CosFifo_t *q)
+{
+  if(q->isInitialized == 0)
+  { DebugCode(_msg("FifoResetStatistics:not init"););
+    return -1;
+  }
+  q->stats.maxUsedSlots       = q->usedSlots;
+  q->stats.nWritten           = 0;
+  q->stats.nRead              = 0;
+  q->stats.nWriterBlocked     = 0;
+  q->stats.nReaderBlocked     = 0;
+  q->stats.writerBlockedTicks = 0;
+  q->stats.readerBlockedTicks = 0;
+  q->stats.lastChange_Ticks   = _gettime_Ticks();
+  return 0;
+}
+
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * PLEASE NOTE: This function is for internal use only! It is called by
+ * the blocking FIFO macros right before COS_SEM_WAIT(). If the task is
+ * going to block at semaphore s, the block is counted and the task is
+ * added to the number of waiting tasks.
+ *
+ * @param  q               - IN/OUT, pointer to FIFO
+ * @param  s               - IN, semaphore the task is going to wait at
+ ************************************************************************/
+void _qStatBeforeWait(CosFifo_t *q, CosSema_t *s)
+{
+  if(s->count > 0)
+  { return;  /* task will pass the semaphore */
+  }
+  _qStatAccumulate(q);
+  if(s == &(q->wSema))
+  { q->stats.nWriterBlocked++;
+    q->stats.nWritersWaiting++;
+  }
+  else
+  { q->stats.nReaderBlocked++;
+    q->stats.nReadersWaiting++;
+  }
+}
+#endif
@@ -7,8 +7,9 @@
    @brief  Data-FIFO (queue) for COS. The FIFO uses dynamic memory allocation
           (malloc()). A FIFO is initialized for a data type and can  
           store data of only that type. The maximum number of storage
-          places (slots) is 255 due to 1 byte index variables. A slot 
-          can store a maximum of 256 bytes.
+          places (slots) is 255, a slot can store a maximum of 255
+          bytes. The read and write indexes into the buffer have 16 bit,
+          they cover all of its 255 * 255 bytes.
 
    @par Author    : Ernst Forgber (Fgb)
    @par Company   : Hochschule Hannover - University of Applied Sciences and Arts, Germany
@@ -22,6 +23,10 @@
    0.1     | 17.09. 2013 | Fgb    | nur noch Atmel, deutsche Doku
    0.2     | 08.10. 2015 | Fgb    | Umbau auf renesas controller
    0.3     | 21.11. 2016 | Fgb    | english docu
+   0.4     | 18.10. 2026 | Fgb    | overwrite mode for streams of samples
+   0.5     | 18.10. 2026 | Fgb    | occupancy and blocking statistics
+   0.6     | 18.10. 2026 | Fgb    | overwrite mode: writers released by the next write
+   0.7     | 18.10. 2026 | Fgb    | 16 bit read and write indexes
 
    @endverbatim
 
@@ -44,15 +49,15 @@ This program is free software: you can redistribute it and/or modify
     You should have received a copy of the GNU General Public License
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
-    Dieses Programm ist Freie Software: Sie knnen es unter den Bedingungen
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
     der GNU General Public License, wie von der Free Software Foundation,
     Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
-    verffentlichten Version, weiterverbreiten und/oder modifizieren.
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
 
-    Dieses Programm wird in der Hoffnung, dass es ntzlich sein wird, aber
-    OHNE JEDE GEWHRLEISTUNG, bereitgestellt; sogar ohne die implizite
-    Gewhrleistung der MARKTFHIGKEIT oder EIGNUNG FR EINEN BESTIMMTEN ZWECK.
-    Siehe die GNU General Public License fr weitere Details.
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
 
     Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
     Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
@@ -74,6 +79,41 @@ This program is free software: you can redistribute it and/or modify
 #endif
 
 
+#define COS_FIFO_MODE_BLOCKING   0  /*!< FIFO mode: writers block if FIFO is full */
+#define COS_FIFO_MODE_OVERWRITE  1  /*!< FIFO mode: writers replace the oldest slot */
+
+
+#if COS_FIFO_STATISTICS
+  /*!< insert code for FIFO statistics */
+  #define FifoStatCode( code_fragment ) { code_fragment }
+#else
+  #define FifoStatCode( code_fragment )  /*!< insert code for FIFO statistics */
+#endif
+
+
+/*!
+ ********************************************************************
+  @par Description
+  FIFO statistics, see COS_FifoGetStatistics(). The counters are
+  only available, if COS_FIFO_STATISTICS is set in cos_configure.h.
+  Blocked ticks are summed up over all tasks: two tasks blocked for
+  10 ticks each account for 20 ticks.
+********************************************************************/
+typedef struct                        /*! FIFO statistics */
+{
+        uint8_t  maxUsedSlots;        /*!< high-water mark of used slots */
+        uint32_t nWritten;            /*!< total number of slots written */
+        uint32_t nRead;               /*!< total number of slots read */
+        uint32_t nWriterBlocked;      /*!< how often a writer blocked at wSema */
+        uint32_t nReaderBlocked;      /*!< how often a reader blocked at rSema */
+        uint32_t writerBlockedTicks;  /*!< total ticks writers spent blocked */
+        uint32_t readerBlockedTicks;  /*!< total ticks readers spent blocked */
+        uint8_t  nWritersWaiting;     /*!< internal: writers blocked right now */
+        uint8_t  nReadersWaiting;     /*!< internal: readers blocked right now */
+        CosTicks_t lastChange_Ticks;  /*!< internal: time of last change of waiting tasks */
+} CosFifoStats_t;
+
+
 
 /*!
  ********************************************************************
@@ -85,10 +125,15 @@ typedef struct                 /*! FIFO data structure */
         char *buffer;          /*!< queue Data buffer */
         uint8_t maxSlots;      /*!< total number of slots in the queue  */
         uint8_t slotSize;      /*!< size of a slot in bytes */
-        uint8_t rIndex;        /*!< read index variable of the queue */
-        uint8_t wIndex;        /*!< write index variable of the queue */
+        uint16_t rIndex;       /*!< read index into the buffer, in bytes */
+        uint16_t wIndex;       /*!< write index into the buffer, in bytes */
         uint8_t usedSlots;     /*!< number of used slots */
         uint8_t isInitialized; /*!< 0 if not yet initialized */
+        uint8_t mode;          /*!< COS_FIFO_MODE_BLOCKING or COS_FIFO_MODE_OVERWRITE */
+        uint16_t droppedSlots; /*!< slots overwritten before they were read */
+#if COS_FIFO_STATISTICS
+        CosFifoStats_t stats;  /*!< occupancy and blocking counters */
+#endif
         CosSema_t rSema;       /*!< wait at this semaphore when reading */
         CosSema_t wSema;       /*!< wait at this semaphore when writing */
 } CosFifo_t;
@@ -105,6 +150,15 @@ uint8_t COS_FifoGetUsedSlots(CosFifo_t *q);
 uint8_t COS_FifoGetMaxSlots(CosFifo_t *q);
 uint8_t COS_FifoGetSlotSize(CosFifo_t *q);
 
+int8_t   COS_FifoSetMode(CosFifo_t *q, uint8_t mode);
+uint16_t COS_FifoGetDroppedSlots(CosFifo_t *q);
+
+#if COS_FIFO_STATISTICS
+int8_t COS_FifoGetStatistics(CosFifo_t *q, CosFifoStats_t *stats);
+int8_t COS_FifoResetStatistics(CosFifo_t *q);
+void   _qStatBeforeWait(CosFifo_t *q, CosSema_t *s);
+#endif
+
 int8_t _qWriteSingleSlot(CosFifo_t *q, const char *data);
 int8_t _qReadSingleSlot(CosFifo_t *q, char *data);
 
@@ -118,6 +172,10 @@ int8_t _qReadSingleSlot(CosFifo_t *q, char *data);
  * COS_FifoCreate(). IF there is no free slot, the macro changes the
  * task *pt to state TASK_STATE_BLOCKED. Another task reading from the 
  * FIFO will un-block it again. 
+ * In mode COS_FIFO_MODE_OVERWRITE the macro never waits for a slot, if
+ * the FIFO is full, the oldest slot is replaced, see COS_FifoSetMode().
+ * A writer blocks only until another writer, that passed the macro
+ * before, has written its slot.
  *
  * @see
  * @arg  COS_FifoBlockingReadSingleSlot(), _qWriteSingleSlot()
@@ -179,7 +237,8 @@ int main(void)
 }
   @endverbatim
  ************************************************************************/
-#define COS_FifoBlockingWriteSingleSlot(pt, q,  data)  COS_SEM_WAIT(&((q)->wSema),(pt)); \
+#define COS_FifoBlockingWriteSingleSlot(pt, q,  data)  FifoStatCode(_qStatBeforeWait((q), &((q)->wSema));) \
+                                                       COS_SEM_WAIT(&((q)->wSema),(pt)); \
                                                        _qWriteSingleSlot((q), (char *)(data))
 
 
@@ -208,7 +267,8 @@ int main(void)
  * @verbatim
   @endverbatim
  ************************************************************************/
-#define COS_FifoBlockingReadSingleSlot(pt, q,  data)   COS_SEM_WAIT(&((q)->rSema),(pt)); \
+#define COS_FifoBlockingReadSingleSlot(pt, q,  data)   FifoStatCode(_qStatBeforeWait((q), &((q)->rSema));) \
+                                                       COS_SEM_WAIT(&((q)->rSema),(pt)); \
                                                        _qReadSingleSlot((q), (char *)(data))
 
 #endif
@@ -0,0 +1,552 @@
+/*!
+ ********************************************************************
+   @file            cos_frame.c
+   @par Project   : co-operative scheduler (COS)
+   @par Module    : Binary frames on the serial interface
+
+   @brief  COBS framing with CRC-16, frame sender and non-blocking
+          frame reader, see cos_frame.h.
+
+   @par Author    : Ernst Forgber (Fgb)
+   @par Company   : Hochschule Hannover - University of Applied Sciences and Arts, Germany
+   @par Department: Faculty 1
+ ********************************************************************
+
+   @par History   :
+   @verbatim
+   Version | Date        | Author | Change Description
+   0.0     | 18.10. 2026 | Fgb    | First Version
+   @endverbatim
+
+ ********************************************************************/
+/**************************************************************************
+
+Copyright 2026 Ernst Forgber
+
+
+This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+
+
+
+
+#include <stdlib.h>
+#include "cos_ser.h"
+#include "cos_frame.h"
+#include "cos_memory.h"
+
+
+
+
+/*------------- DEBUGGING ---------------------------------*/
+#define DEBUG_MODULE 0  /*!< 0 for no additional debug code, 1 otherwise */
+
+#if DEBUG_MODULE
+  #define DebugCode( code_fragment ) { code_fragment } /*!< for debugging only: insert some code */
+#else
+  #define DebugCode( code_fragment ) /*!< for debugging only: insert some code */
+#endif
+
+#if DEBUG_MODULE
+static void _msg(char *msg)
+{
+    DebugCode(serPuts(msg););
+}
+#endif
+/*---------------------------------------------------------------*/
+
+
+
+#define TASK_PAYLOAD  35  /*!< largest payload of COS_FRAME_TYPE_TASK */
+
+#if COS_FRAME_MAX_PAYLOAD < TASK_PAYLOAD
+  #error "COS_FRAME_MAX_PAYLOAD too small for COS_FrameSendTaskList()"
+#endif
+#if COS_FRAME_MAX_PAYLOAD > 252
+  #error "COS_FRAME_MAX_PAYLOAD must not exceed 252"
+#endif
+
+/*! CRC-16 CCITT for one nibble, 32 bytes of flash instead of 512 */
+static const uint16_t crcTable_g[16] =
+{   0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+/*! state of the COBS encoder */
+typedef struct
+{   uint8_t  *dst;     /*!< encoded frame */
+    uint16_t code;     /*!< index of the code byte of the current block */
+    uint16_t out;      /*!< next free index */
+} CobsEncoder_t;
+
+
+
+/****************************************************************/
+/* private functions */
+/****************************************************************/
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Adds a byte to a COBS encoded frame. A 0x00 or a block of 254 bytes
+ * closes the current block: its code byte is written, the next block
+ * gets a new code byte.
+ ************************************************************************/
+static void _cobsPut(CobsEncoder_t *e, uint8_t b)
+{
+  if(b != 0)
+  { e->dst[e->out++] = b;
+    if((e->out - e->code) < 0xFF)
+    { return;
+    }
+  }
+  e->dst[e->code] = (uint8_t)(e->out - e->code);
+  e->code = e->out++;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Writes a 16 or 32 bit value, low byte first.
+ ************************************************************************/
+static uint8_t *_put16(uint8_t *p, uint16_t x)
+{
+  p[0] = (uint8_t) x;
+  p[1] = (uint8_t)(x >> 8);
+  return p + 2;
+}
+
+static uint8_t *_put32(uint8_t *p, uint32_t x)
+{
+  p = _put16(p, (uint16_t) x);
+  return _put16(p, (uint16_t)(x >> 16));
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * The reader task takes all bytes serPollc() delivers, then sleeps for
+ * the poll period. pData points to the frame reader.
+ ************************************************************************/
+static void _frameReaderTask(CosTask_t *pt)
+{ CosFrameReader_t *fr = (CosFrameReader_t *) pt->pData;
+  int16_t c;
+
+  COS_TASK_BEGIN(pt);
+  while(1)
+  { while((c = serPollc()) >= 0)
+    { COS_FrameReaderPutc(fr, (uint8_t) c);
+    }
+    COS_TASK_SLEEP(pt, fr->period_Ticks);
+  }
+  COS_TASK_END(pt);
+}
+
+
+
+
+/****************************************************************/
+/* exported module functions */
+/****************************************************************/
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Computes the CRC-16 CCITT (polynomial 0x1021, no reflection) of a
+ * block. Start with COS_CRC16_INIT, a long block may be passed in
+ * several parts. "123456789" gives 0x29B1.
+ *
+ * @param  crc             - IN, COS_CRC16_INIT or CRC of the previous part
+ * @param  data            - IN, bytes
+ * @param  len             - IN, number of bytes
+ *
+ * @retval CRC
+ ************************************************************************/
+uint16_t COS_Crc16(uint16_t crc, const uint8_t *data, uint16_t len)
+{
+  while(len-- > 0)
+  { crc = (uint16_t)(crc << 4) ^ crcTable_g[(crc >> 12) ^ (*data >> 4)];
+    crc = (uint16_t)(crc << 4) ^ crcTable_g[(crc >> 12) ^ (*data & 0x0F)];
+    data++;
+  }
+  return crc;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Encodes a frame: type, payload and CRC, COBS encoded, ending with
+ * 0x00.
+ *
+ * @param  dst             - OUT, encoded frame
+ * @param  dstSize         - IN, size of 'dst', at least COS_FRAME_ENCODED_SIZE(len)
+ * @param  type            - IN, message type
+ * @param  payload         - IN, payload, may be NULL if 'len' is 0
+ * @param  len             - IN, bytes of payload
+ *
+ * @retval length of the encoded frame including the 0x00
+ * @retval -1              - 'dst' too small
+ ************************************************************************/
+int16_t COS_FrameEncode(uint8_t *dst, uint16_t dstSize, uint8_t type,
+                        const uint8_t *payload, uint8_t len)
+{ CobsEncoder_t e;
+  uint16_t crc;
+  uint8_t i;
+
+  if(dstSize < COS_FRAME_ENCODED_SIZE((uint16_t) len))
+  { DebugCode(_msg("FrameEncode:size!"););
+    return -1;
+  }
+  crc = COS_Crc16(COS_CRC16_INIT, &type, 1);
+  crc = COS_Crc16(crc, payload, len);
+  e.dst = dst;
+  e.code = 0;
+  e.out = 1;
+  _cobsPut(&e, type);
+  for(i = 0; i < len; i++)
+  { _cobsPut(&e, payload[i]);
+  }
+  _cobsPut(&e, (uint8_t) crc);
+  _cobsPut(&e, (uint8_t)(crc >> 8));
+  dst[e.code] = (uint8_t)(e.out - e.code);
+  dst[e.out++] = 0;
+  return (int16_t) e.out;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Decodes a received frame in place and checks its CRC. 'buf' holds the
+ * encoded bytes without the terminating 0x00; afterwards it holds the
+ * type and the payload.
+ *
+ * @param  buf             - IN/OUT, frame
+ * @param  len             - IN, bytes in 'buf'
+ *
+ * @retval length of type and payload
+ * @retval -1              - COBS error or frame too short
+ * @retval -2              - CRC error
+ ************************************************************************/
+int16_t COS_FrameDecode(uint8_t *buf, uint16_t len)
+{ uint16_t in = 0, out = 0;
+  uint8_t code, i;
+
+  while(in < len)
+  { code = buf[in++];
+    if(code == 0)
+    { return -1;
+    }
+    for(i = 1; i < code; i++)
+    { if((in >= len) || (buf[in] == 0))
+      { return -1;
+      }
+      buf[out++] = buf[in++];
+    }
+    if((code < 0xFF) && (in < len))
+    { buf[out++] = 0;
+    }
+  }
+  if(out < 3)
+  { return -1;
+  }
+  out -= 2;
+  if(COS_Crc16(COS_CRC16_INIT, buf, out) != (uint16_t)(buf[out] | (buf[out + 1] << 8)))
+  { return -2;
+  }
+  return (int16_t) out;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Encodes a frame and writes it by serWrite(). Without TX buffer, the
+ * function waits until the UART has taken the frame. With TX buffer,
+ * the frame is lost or the function waits when the buffer is full,
+ * see serTxSetPolicy(); a task ensures space by
+ * SER_TX_WAIT(pt, COS_FRAME_ENCODED_SIZE(len)) first.
+ *
+ * @param  type            - IN, message type
+ * @param  payload         - IN, payload, may be NULL if 'len' is 0
+ * @param  len             - IN, bytes of payload, up to COS_FRAME_MAX_PAYLOAD
+ *
+ * @retval 0               - no error
+ * @retval -1              - payload too long
+ ************************************************************************/
+int8_t COS_FrameSend(uint8_t type, const void *payload, uint8_t len)
+{ uint8_t buf[COS_FRAME_ENCODED_SIZE(COS_FRAME_MAX_PAYLOAD)];
+  int16_t n;
+
+  if(len > COS_FRAME_MAX_PAYLOAD)
+  { return -1;
+  }
+  n = COS_FrameEncode(buf, sizeof(buf), type, (const uint8_t *) payload, len);
+  serWrite((const char *) buf, (uint16_t) n);
+  return 0;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Sends the task list, the binary counterpart of COS_PrintTaskList():
+ * one frame of type COS_FRAME_TYPE_TASK per task, all values low byte
+ * first, times in ticks. Bits 0..2 of 'flags' show which of the optional
+ * parts follow.
+ *
+ * @verbatim
+   offset  size  content
+   0       4     task address, identifies the task
+   4       1     state
+   5       1     priority
+   6       2     lineCnt
+   8       1     flags: 0x01 statistics, 0x02 latency, 0x04 budget
+   9       12    statistics: activations, average, max execution time
+   ..      12    latency: p50, p99, max wake-up latency
+   ..      2     budget: overruns
+  @endverbatim
+ ************************************************************************/
+void COS_FrameSendTaskList(void)
+{ Node_t *n = COS_GetTaskListRootPointer();
+  uint8_t buf[TASK_PAYLOAD], *p;
+  CosTask_t *t;
+
+  while(NULL != n)
+  { t = n->task_pt;
+    p = _put32(buf, (uint32_t)(size_t) t);
+    *p++ = t->state;
+    *p++ = t->prio;
+    p = _put16(p, t->lineCnt);
+    buf[8] = (uint8_t)((COS_TASK_STATISTICS ? 0x01 : 0) | (COS_TASK_LATENCY ? 0x02 : 0) |
+                       (COS_TASK_BUDGET ? 0x04 : 0));
+    p++;
+#if COS_TASK_STATISTICS
+    p = _put32(p, t->stats.activations);
+    p = _put32(p, (uint32_t) COS_TaskStatsAverage_Ticks(&t->stats));
+    p = _put32(p, (uint32_t) t->stats.max_Ticks);
+#endif
+#if COS_TASK_LATENCY
+    p = _put32(p, (uint32_t) COS_TaskLatencyPercentile_Ticks(&t->latency, 500));
+    p = _put32(p, (uint32_t) COS_TaskLatencyPercentile_Ticks(&t->latency, 990));
+    p = _put32(p, (uint32_t) t->latency.max_Ticks);
+#endif
+#if COS_TASK_BUDGET
+    p = _put16(p, t->budgetOverruns);
+#endif
+    COS_FrameSend(COS_FRAME_TYPE_TASK, buf, (uint8_t)(p - buf));
+    n = n->next_pt;
+  }
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * This function creates a frame reader for frames with up to
+ * 'maxPayload' bytes of payload and a queue of 'queueSize' bytes for
+ * the decoded frames. Each frame uses its payload plus three bytes of
+ * the queue.
+ *
+ * @see
+ * @arg  COS_FrameReaderDestroy(), COS_FrameReaderStart()
+ *
+ * @param  fr              - IN/OUT, pointer to frame reader struct
+ * @param  maxPayload      - IN, largest payload (1..252)
+ * @param  queueSize       - IN, size of the queue in bytes, at least maxPayload + 3
+ *
+ * @retval 0               - no error
+ * @retval negative        - an error occurrred
+ ************************************************************************/
+int8_t COS_FrameReaderCreate(CosFrameReader_t *fr, uint8_t maxPayload, uint16_t queueSize)
+{ uint16_t size = COS_FRAME_ENCODED_SIZE((uint16_t) maxPayload) - 1;
+
+  fr->isInitialized = 0;
+  if((maxPayload < 1) || (maxPayload > 252) || (queueSize < (uint16_t) maxPayload + 3))
+  { DebugCode(_msg("FrameReaderCreate:param!"););
+    return -1;
+  }
+  fr->buf = (uint8_t *) _memAlloc(size);
+  if(fr->buf == NULL)
+  { DebugCode(_msg("FrameReaderCreate:malloc!"););
+    return -1;
+  }
+  if(0 != COS_MsgQueueCreate(&(fr->frames), queueSize))
+  { _memFree(fr->buf, size);
+    fr->buf = NULL;
+    return -1;
+  }
+  fr->size = size;
+  fr->len = 0;
+  fr->maxPayload = maxPayload;
+  fr->overflow = 0;
+  fr->received = 0;
+  fr->errors = 0;
+  fr->overflows = 0;
+  fr->dropped = 0;
+  fr->period_Ticks = 0;
+  fr->isInitialized = 1;
+  return 0;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * This function releases the memory of a frame reader. A reader task
+ * must have been deleted before.
+ *
+ * @param  fr              - IN/OUT, pointer to frame reader struct
+ *
+ * @retval 0               - no error
+ * @retval negative        - an error occurrred
+ ************************************************************************/
+int8_t COS_FrameReaderDestroy(CosFrameReader_t *fr)
+{
+  if(fr->isInitialized == 0)
+  { DebugCode(_msg("FrameReaderDestroy:not init."););
+    return -1;
+  }
+  _memFree(fr->buf, fr->size);
+  fr->buf = NULL;
+  fr->isInitialized = 0;
+  return COS_MsgQueueDestroy(&(fr->frames));
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Adds a received byte to the current frame. A 0x00 ends the frame: it
+ * is decoded and checked, a valid frame is stored in the queue. Frames
+ * with an error, too long frames and frames that do not fit into the
+ * queue are counted and dropped. The function never blocks; it must not
+ * be called from an interrupt service routine.
+ *
+ * @param  fr              - IN/OUT, pointer to frame reader struct
+ * @param  c               - IN, received byte
+ *
+ * @retval 1               - a valid frame has been stored
+ * @retval 0               - byte stored, or frame dropped
+ * @retval negative        - not initialized
+ ************************************************************************/
+int8_t COS_FrameReaderPutc(CosFrameReader_t *fr, uint8_t c)
+{ int16_t n;
+
+  if(fr->isInitialized == 0)
+  { return -1;
+  }
+  if(c != 0)
+  { if(fr->len < fr->size)
+    { fr->buf[fr->len++] = c;
+    }
+    else
+    { fr->overflow = 1;
+    }
+    return 0;
+  }
+  if(fr->len == 0)
+  { return 0;  /* delimiters between frames */
+  }
+  n = fr->overflow ? 0 : COS_FrameDecode(fr->buf, fr->len);
+  fr->len = 0;
+  if(fr->overflow || (n > (int16_t) fr->maxPayload + 1))
+  { fr->overflow = 0;
+    fr->overflows++;
+    return 0;
+  }
+  if(n < 0)
+  { fr->errors++;
+    return 0;
+  }
+  if(1 != _mqWrite(&(fr->frames), (const char *) fr->buf, (uint8_t) n))
+  { fr->dropped++;  /* queue full */
+    return 0;
+  }
+  fr->received++;
+  return 1;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Creates a task that polls the serial interface with serPollc() every
+ * 'period_Ticks' and feeds the frame reader. Without this task, the
+ * application feeds the frame reader by COS_FrameReaderPutc().
+ *
+ * @param  fr              - IN/OUT, pointer to frame reader struct
+ * @param  prio            - IN, priority of the reader task
+ * @param  period_Ticks    - IN, poll period
+ *
+ * @retval pointer to the reader task, NULL on error
+ ************************************************************************/
+CosTask_t *COS_FrameReaderStart(CosFrameReader_t *fr, uint8_t prio, CosTicks_t period_Ticks)
+{
+  if(fr->isInitialized == 0)
+  { DebugCode(_msg("FrameReaderStart:not init."););
+    return NULL;
+  }
+  fr->period_Ticks = period_Ticks;
+  return COS_CreateTask(prio, fr, _frameReaderTask);
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Reads the oldest frame without waiting, see
+ * COS_FrameReaderBlockingRead().
+ *
+ * @param  fr              - IN/OUT, pointer to frame reader struct
+ * @param  data            - OUT, type and payload
+ * @param  maxLen          - IN, size of the buffer in bytes
+ *
+ * @retval number of bytes read, 0 if there is no frame, negative on error
+ ************************************************************************/
+int16_t COS_FrameReaderTryRead(CosFrameReader_t *fr, uint8_t *data, uint8_t maxLen)
+{
+  if(fr->isInitialized == 0)
+  { return -1;
+  }
+  return COS_MsgQueueTryRead(&(fr->frames), (char *) data, maxLen);
+}
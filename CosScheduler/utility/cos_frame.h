@@ -0,0 +1,225 @@
+/*!
+ ********************************************************************
+   @file            cos_frame.h
+   @par Project   : co-operative scheduler (COS)
+   @par Module    : Binary frames on the serial interface
+
+   @brief  Framed binary protocol on top of cos_ser. The text printers
+          (serOut...(), COS_PrintTaskList()) send a 32 bit value as up to
+          ten digits plus a label, a binary frame sends it as four bytes.
+
+          A frame carries a message type, up to COS_FRAME_MAX_PAYLOAD
+          bytes of payload and a CRC-16 (CCITT, polynomial 0x1021, start
+          value 0xFFFF) over type and payload, low byte first. The frame
+          is COBS encoded (Consistent Overhead Byte Stuffing): the
+          encoded bytes contain no 0x00, a 0x00 ends the frame. A
+          receiver synchronizes at the next 0x00 after a lost byte, a
+          corrupted frame is rejected by the CRC. COBS adds one byte per
+          254 bytes, plus the 0x00. Text output between frames should end
+          with serPutc(0), otherwise the receiver drops the next frame.
+
+   @verbatim
+   | type | payload ... | crc low | crc high |  --COBS-->  | encoded ... | 0x00 |
+   @endverbatim
+
+          COS_FrameSend() encodes a frame and writes it by serWrite().
+          With a TX buffer (COS_SER_TX_BUFFER) this does not wait for the
+          UART, a task waits for space with SER_TX_WAIT().
+          COS_FrameSendTaskList() sends one COS_FRAME_TYPE_TASK frame per
+          task.
+
+          The frame reader decodes received frames without waiting, like
+          the line reader (cos_line_reader.h): a polling task started by
+          COS_FrameReaderStart() takes all bytes serPollc() delivers, or
+          the application feeds them by COS_FrameReaderPutc(). Valid
+          frames are stored in a message queue, type in the first byte,
+          and read by COS_FrameReaderBlockingRead().
+
+          The host tool extras/frametool decodes frames and encodes
+          commands.
+
+   @par Author    : Ernst Forgber (Fgb)
+   @par Company   : Hochschule Hannover - University of Applied Sciences and Arts, Germany
+   @par Department: Faculty 1
+ ********************************************************************
+
+   @par History   :
+   @verbatim
+   Version | Date        | Author | Change Description
+   0.0     | 18.10. 2026 | Fgb    | First Version
+   @endverbatim
+
+ ********************************************************************/
+/**************************************************************************
+
+Copyright 2026 Ernst Forgber
+
+
+This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+
+
+
+#ifndef _cos_frame_h_
+#define _cos_frame_h_
+
+
+#include "cos_configure.h"
+#include "cos_scheduler.h"
+#include "cos_msg_queue.h"
+#include "cos_types.h"
+
+
+/* message types, 0x80..0xFF are free for the application */
+#define COS_FRAME_TYPE_TEXT   0x01 /*!< payload: text without '\0' */
+#define COS_FRAME_TYPE_TASK   0x02 /*!< payload: one task, see COS_FrameSendTaskList() */
+#define COS_FRAME_TYPE_LOG    0x03 /*!< payload: log records, see COS_LogSend() */
+#define COS_FRAME_TYPE_USER   0x80 /*!< first type of the application */
+
+#define COS_CRC16_INIT        0xFFFF /*!< start value of COS_Crc16() */
+
+/*!
+ ********************************************************************
+  @par Description
+  Maximum size of an encoded frame with 'n' bytes of payload, including
+  the terminating 0x00.
+********************************************************************/
+#define COS_FRAME_ENCODED_SIZE(n)  ((n) + 5 + ((n) + 3) / 254)
+
+
+/*!
+ ********************************************************************
+  @par Description
+  Frame reader data structure. 'buf' collects the encoded bytes of the
+  current frame, 'frames' holds the decoded frames.
+********************************************************************/
+typedef struct                 /*! frame reader data structure */
+{
+        uint8_t *buf;          /*!< encoded frame being received */
+        uint16_t size;         /*!< size of 'buf' */
+        uint16_t len;          /*!< bytes in 'buf' */
+        uint8_t maxPayload;    /*!< largest payload accepted */
+        uint8_t overflow;      /*!< 1 if the current frame is too long */
+        uint16_t received;     /*!< valid frames */
+        uint16_t errors;       /*!< frames with COBS or CRC error */
+        uint16_t overflows;    /*!< frames too long */
+        uint16_t dropped;      /*!< valid frames lost, queue full */
+        CosTicks_t period_Ticks; /*!< poll period of the reader task */
+        CosMsgQueue_t frames;  /*!< decoded frames: type, payload */
+        uint8_t isInitialized; /*!< 0 if not yet initialized */
+} CosFrameReader_t;
+
+
+
+uint16_t   COS_Crc16(uint16_t crc, const uint8_t *data, uint16_t len);
+int16_t    COS_FrameEncode(uint8_t *dst, uint16_t dstSize, uint8_t type,
+                           const uint8_t *payload, uint8_t len);
+int16_t    COS_FrameDecode(uint8_t *buf, uint16_t len);
+int8_t     COS_FrameSend(uint8_t type, const void *payload, uint8_t len);
+void       COS_FrameSendTaskList(void);
+
+int8_t     COS_FrameReaderCreate(CosFrameReader_t *fr, uint8_t maxPayload, uint16_t queueSize);
+int8_t     COS_FrameReaderDestroy(CosFrameReader_t *fr);
+int8_t     COS_FrameReaderPutc(CosFrameReader_t *fr, uint8_t c);
+CosTask_t *COS_FrameReaderStart(CosFrameReader_t *fr, uint8_t prio, CosTicks_t period_Ticks);
+int16_t    COS_FrameReaderTryRead(CosFrameReader_t *fr, uint8_t *data, uint8_t maxLen);
+
+
+// blocking Macros
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * This macro reads the oldest received frame: data[0] is the message
+ * type, the payload follows. If there is no frame, the task *pt is
+ * changed to state TASK_STATE_BLOCKED until a valid frame has been
+ * received. A frame longer than 'maxLen' is truncated.
+ *
+ * @see
+ * @arg  COS_FrameReaderStart(), COS_FrameSend()
+ *
+ * @par Macro parameters: (CosTask_t *pt, CosFrameReader_t *fr, uint8_t *data, uint8_t maxLen, int16_t len)
+ *
+ * @param  pt              - IN/OUT, pointer to task struct
+ * @param  fr              - IN/OUT, pointer to frame reader struct
+ * @param  data            - OUT, buffer for type and payload
+ * @param  maxLen          - IN, size of the buffer in bytes
+ * @param  len             - OUT, variable for the number of bytes read
+ * @retval void
+ * @par Example :
+ *    The host sets a speed with frame type 0x80 and a 16 bit value, the
+ *    device answers with its telemetry:
+ * @verbatim
+#define CMD_SPEED   0x80
+#define TELEMETRY   0x81
+
+CosFrameReader_t link;
+
+void Task_Cmd(CosTask_t *pt)
+{   static uint8_t msg[8];
+    static int16_t len;
+
+    COS_TASK_BEGIN(pt);
+    while(1)
+    {   COS_FrameReaderBlockingRead(pt, &link, msg, sizeof(msg), len);
+        if((msg[0] == CMD_SPEED) && (len == 3))
+        {   setSpeed(msg[1] | (msg[2] << 8));
+        }
+    }
+    COS_TASK_END(pt);
+}
+
+void Task_Telemetry(CosTask_t *pt)
+{   uint16_t t[4];
+
+    COS_TASK_BEGIN(pt);
+    while(1)
+    {   SER_TX_WAIT(pt, COS_FRAME_ENCODED_SIZE(sizeof(t)));
+        readSensors(t);
+        COS_FrameSend(TELEMETRY, t, sizeof(t));
+        COS_TASK_SLEEP(pt, _milliSecToTicks(10));
+    }
+    COS_TASK_END(pt);
+}
+
+int main(void)
+{ ...
+  COS_InitTaskList();
+  if(0 != COS_FrameReaderCreate(&link, 16, 64))
+    serPuts("error creating frame reader");
+  COS_FrameReaderStart(&link, 1, _milliSecToTicks(5));
+  COS_CreateTask(2, NULL, Task_Cmd);
+  COS_CreateTask(3, NULL, Task_Telemetry);
+  ...
+}
+  @endverbatim
+ ************************************************************************/
+#define COS_FrameReaderBlockingRead(pt, fr, data, maxLen, len)  COS_MsgQueueBlockingRead((pt), &((fr)->frames), (data), (maxLen), (len))
+
+
+#endif
@@ -0,0 +1,353 @@
+/*!
+ ********************************************************************
+   @file            cos_latency.c
+   @par Project   : co-operative scheduler (COS)
+   @par Module    : Wake-up latency histograms
+
+   @brief  Measures the wake-up latency of tasks, see cos_latency.h.
+
+   Buckets of the histogram, with e = (b - 4) / 4 and s = (b - 4) % 4:
+   @verbatim
+   bucket b    latency in ticks
+   0..3        b
+   4..         (4 + s) << e  ...  ((5 + s) << e) - 1
+   @endverbatim
+
+   @par Author    : Ernst Forgber (Fgb)
+   @par Company   : Hochschule Hannover - University of Applied Sciences and Arts, Germany
+   @par Department: Faculty 1
+ ********************************************************************
+
+   @par History   :
+   @verbatim
+   Version | Date        | Author | Change Description
+   0.0     | 18.10. 2026 | Fgb    | First Version
+   @endverbatim
+
+ ********************************************************************/
+/**************************************************************************
+
+Copyright 2026 Ernst Forgber
+
+
+This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+
+
+
+#include "cos_ser.h"
+#include "cos_scheduler.h"
+#include "cos_latency.h"
+
+#if COS_TASK_LATENCY
+
+#if COS_LATENCY_BUCKETS < 8
+  #error "COS_LATENCY_BUCKETS has to be 8 at least"
+#endif
+
+
+
+/*------------- DEBUGGING ---------------------------------*/
+#define DEBUG_MODULE 0  /*!< 0 for no additional debug code, 1 otherwise */
+
+#if DEBUG_MODULE
+  #define DebugCode( code_fragment ) { code_fragment } /*!< for debugging only: insert some code */
+#else
+  #define DebugCode( code_fragment ) /*!< for debugging only: insert some code */
+#endif
+/*---------------------------------------------------------------*/
+
+
+
+/****************************************************************/
+/* private functions */
+/****************************************************************/
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Returns the histogram bucket of a latency.
+ ************************************************************************/
+static uint8_t _bucket(CosTicks_t x)
+{   uint8_t e = 0;
+
+    if(x < 4)
+    {   return (uint8_t)x;
+    }
+    while(x >= 8)  /* keep the two bits below the leading one */
+    {   x >>= 1;
+        e++;
+    }
+    if(4 * e + x >= COS_LATENCY_BUCKETS - 1)  /* 4 + 4 * e + (x - 4) */
+    {   return COS_LATENCY_BUCKETS - 1;  /* too long, last bucket */
+    }
+    return (uint8_t)(4 * e + x);
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Returns the longest latency counted in bucket b.
+ ************************************************************************/
+static CosTicks_t _bucketUpper(uint8_t b)
+{   if(b < 4)
+    {   return b;
+    }
+    b -= 4;
+    return (CosTicks_t)(((CosTicks_t)(5 + (b & 3)) << (b >> 2)) - 1);
+}
+
+
+
+/****************************************************************/
+/* exported module functions */
+/****************************************************************/
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * PLEASE NOTE: This function is for internal use only! Clears the
+ * histogram. The next call of the task is not measured.
+ *
+ * @param  lat             - OUT, histogram of a task
+ ************************************************************************/
+void _latencyReset(CosTaskLatency_t *lat)
+{   uint8_t b;
+
+    lat->samples = 0;
+    lat->max_Ticks = 0;
+    lat->lastEnd_Ticks = 0;
+    lat->readySince_Ticks = 0;
+    lat->wake = COS_WAKE_NONE;
+    for(b = 0; b < COS_LATENCY_BUCKETS; b++)
+    {   lat->bucket[b] = 0;
+    }
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * PLEASE NOTE: This function is for internal use only! Use the macro
+ * COS_LATENCY_SET_READY(). Notes the time a task is set ready.
+ *
+ * @param  pt              - IN/OUT, task
+ ************************************************************************/
+void _latencySetReady(struct CosTask_t *pt)
+{   if(COS_WAKE_NONE != pt->latency.wake)
+    {   pt->latency.wake = COS_WAKE_SET_READY;
+        pt->latency.readySince_Ticks = _gettime_Ticks();
+    }
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * PLEASE NOTE: This function is for internal use only! Called by the
+ * scheduler before the task function, while lastActivationTime_Ticks
+ * and sleepTime_Ticks still belong to the last call. All times are
+ * taken relative to the last activation, so the tick counter may wrap
+ * around.
+ *
+ * @param  pt              - IN/OUT, task
+ * @param  t_Ticks         - IN, start of the call
+ ************************************************************************/
+void _latencyBeforeCall(struct CosTask_t *pt, CosTicks_t t_Ticks)
+{   CosTaskLatency_t *lat = &pt->latency;
+    CosTicks_t ready, x, latency;
+    uint8_t b, i;
+
+    if(COS_WAKE_NONE == lat->wake)
+    {   return;
+    }
+    ready = pt->sleepTime_Ticks;  /* sleep time elapsed ... */
+    x = (CosTicks_t)(lat->lastEnd_Ticks - pt->lastActivationTime_Ticks);
+    if(x > ready)
+    {   ready = x;  /* ... but not before the last call returned */
+    }
+    if(COS_WAKE_SET_READY == lat->wake)
+    {   x = (CosTicks_t)(lat->readySince_Ticks - pt->lastActivationTime_Ticks);
+        if(x > ready)
+        {   ready = x;
+        }
+    }
+    x = (CosTicks_t)(t_Ticks - pt->lastActivationTime_Ticks);
+    latency = (x > ready) ? (CosTicks_t)(x - ready) : 0;
+
+    b = _bucket(latency);
+    if(0xFFFF == lat->bucket[b])
+    {   for(i = 0; i < COS_LATENCY_BUCKETS; i++)
+        {   lat->bucket[i] >>= 1;  /* counter full: halve all of them */
+        }
+    }
+    lat->bucket[b]++;
+    lat->samples++;
+    if(latency > lat->max_Ticks)
+    {   lat->max_Ticks = latency;
+    }
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * PLEASE NOTE: This function is for internal use only! Called by the
+ * scheduler after the task function, if the task still exists.
+ *
+ * @param  pt              - IN/OUT, task
+ * @param  end_Ticks       - IN, end of the call
+ ************************************************************************/
+void _latencyAfterCall(struct CosTask_t *pt, CosTicks_t end_Ticks)
+{   pt->latency.lastEnd_Ticks = end_Ticks;
+    pt->latency.wake = COS_WAKE_SLEEP;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Copies the latency histogram of a task.
+ *
+ * @see COS_TaskLatencyPercentile_Ticks(), COS_ResetTaskLatency()
+ *
+ * @param  task_pt         - IN, pointer to task
+ * @param  lat             - OUT, copy of the histogram
+ *
+ * @retval 0 for ok, negative if the task is not in the task-list
+ *
+ * @par Code example:
+ * @verbatim
+void monitorTask(CosTask_t *pt)
+{   static CosTaskLatency_t lat;
+
+    COS_TASK_BEGIN(pt);
+    while(1)
+    {   COS_GetTaskLatency(controlTask_pt, &lat);
+        serPuts("p50:"); serOutUint32Dec(COS_TaskLatencyPercentile_Ticks(&lat, 500));
+        serPuts(" p99:"); serOutUint32Dec(COS_TaskLatencyPercentile_Ticks(&lat, 990));
+        serPuts(" max:"); serOutUint32Dec(lat.max_Ticks);
+        COS_TASK_SLEEP(pt,_milliSecToTicks(1000));
+    }
+    COS_TASK_END(pt);
+}
+  @endverbatim
+ ************************************************************************/
+int8_t COS_GetTaskLatency(struct CosTask_t *task_pt, CosTaskLatency_t *lat)
+{   if(NULL == _searchTaskInList(COS_GetTaskListRootPointer(), task_pt))
+    {   DebugCode(_msg("GetTaskLatency:task not found\r\n"););
+        return -1;
+    }
+    *lat = task_pt->latency;
+    return 0;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Clears the latency histogram of a task or, with task_pt == NULL, of
+ * all tasks.
+ *
+ * @param  task_pt         - IN, pointer to task, NULL for all tasks
+ *
+ * @retval 0 for ok, negative if the task is not in the task-list
+ ************************************************************************/
+int8_t COS_ResetTaskLatency(struct CosTask_t *task_pt)
+{   Node_t *pt = COS_GetTaskListRootPointer();
+
+    if(NULL != task_pt)
+    {   pt = _searchTaskInList(pt, task_pt);
+        if(NULL == pt)
+        {   DebugCode(_msg("ResetTaskLatency:task not found\r\n"););
+            return -1;
+        }
+        _latencyReset(&pt->task_pt->latency);
+        return 0;
+    }
+    for(; NULL != pt; pt = pt->next_pt)
+    {   _latencyReset(&pt->task_pt->latency);
+    }
+    return 0;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Returns a percentile of the latency: perMille = 500 gives the median
+ * (p50), 990 the p99 value. The result is the upper limit of the bucket
+ * that holds the percentile, i.e. it is up to 25 % too long, but never
+ * longer than the maximum. perMille >= 1000 returns the maximum.
+ *
+ * @param  lat             - IN, histogram of a task
+ * @param  perMille        - IN, 0..1000
+ *
+ * @retval latency in ticks, 0 if no call has been measured
+ ************************************************************************/
+CosTicks_t COS_TaskLatencyPercentile_Ticks(const CosTaskLatency_t *lat, uint16_t perMille)
+{   uint32_t total = 0, rank, sum = 0;
+    uint8_t b;
+    CosTicks_t upper;
+
+    for(b = 0; b < COS_LATENCY_BUCKETS; b++)
+    {   total += lat->bucket[b];
+    }
+    if(0 == total)
+    {   return 0;
+    }
+    if(perMille >= 1000)
+    {   return lat->max_Ticks;
+    }
+    rank = (uint32_t)(((uint64_t)total * perMille + 999) / 1000);
+    if(0 == rank)
+    {   rank = 1;
+    }
+    for(b = 0; b < COS_LATENCY_BUCKETS - 1; b++)
+    {   sum += lat->bucket[b];
+        if(sum >= rank)
+        {   break;
+        }
+    }
+    if(COS_LATENCY_BUCKETS - 1 == b)
+    {   return lat->max_Ticks;  /* last bucket has no upper limit */
+    }
+    upper = _bucketUpper(b);
+    return (upper < lat->max_Ticks) ? upper : lat->max_Ticks;
+}
+
+
+#endif // COS_TASK_LATENCY
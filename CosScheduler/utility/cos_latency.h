@@ -0,0 +1,139 @@
+/*!
+ ********************************************************************
+   @file            cos_latency.h
+   @par Project   : co-operative scheduler (COS)
+   @par Module    : Wake-up latency histograms
+
+   @brief  Optional measurement of the wake-up latency of every task:
+          the time between the moment a task becomes ready to run and
+          the start of its task function. A task becomes ready, when
+          its sleep time (COS_TASK_SLEEP(), COS_TASK_SCHEDULE()) has
+          elapsed, but not before its last call has returned, or when
+          COS_SEM_SIGNAL() or COS_ResumeTask() sets it ready. The first
+          call after COS_CreateTask() is not measured.
+
+          The latency shows how long ready tasks wait for the scheduler
+          to find them, e.g. behind tasks of higher priority or behind
+          a long task function. It grows with the number of tasks in the
+          list, so it tells whether a task set meets the timing of its
+          control loops.
+
+          Every task has a histogram of COS_LATENCY_BUCKETS counters with
+          logarithmic buckets: latencies of 0..3 ticks are counted
+          exactly, longer ones in four buckets per power of two, i.e.
+          with a resolution of 25 % or better. Latencies beyond the last
+          bucket are counted in the last bucket; the maximum is always
+          exact. When a counter is full, all counters of the task are
+          halved, so the histogram keeps its shape and gives more weight
+          to recent calls.
+
+          With COS_TASK_LATENCY set to 0 in cos_configure.h, the macros
+          expand to nothing and the measurement costs neither RAM nor
+          time.
+
+   @par Author    : Ernst Forgber (Fgb)
+   @par Company   : Hochschule Hannover - University of Applied Sciences and Arts, Germany
+   @par Department: Faculty 1
+ ********************************************************************
+
+   @par History   :
+   @verbatim
+   Version | Date        | Author | Change Description
+   0.0     | 18.10. 2026 | Fgb    | First Version
+   @endverbatim
+
+ ********************************************************************/
+/**************************************************************************
+
+Copyright 2026 Ernst Forgber
+
+
+This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+
+
+#ifndef _cos_latency_h_
+#define _cos_latency_h_
+
+
+#include "cos_configure.h"
+#include "cos_types.h"
+
+struct CosTask_t;
+
+
+#if COS_TASK_LATENCY
+
+/* how the task became ready, CosTaskLatency_t.wake */
+#define COS_WAKE_NONE       0  /*!< not measured: first call after creation */
+#define COS_WAKE_SLEEP      1  /*!< sleep time elapsed */
+#define COS_WAKE_SET_READY  2  /*!< set ready by COS_SEM_SIGNAL() or COS_ResumeTask() */
+
+
+/*!
+ ********************************************************************
+  @par Description
+  Wake-up latency histogram of a task. bucket[] counts the latencies,
+  see COS_TaskLatencyPercentile_Ticks().
+********************************************************************/
+typedef struct                  /*! wake-up latency histogram of a task */
+{   uint32_t   samples;         /*!< number of measured calls */
+    CosTicks_t max_Ticks;       /*!< longest latency */
+    CosTicks_t lastEnd_Ticks;   /*!< end of the last call */
+    CosTicks_t readySince_Ticks;/*!< time of COS_WAKE_SET_READY */
+    uint8_t    wake;            /*!< COS_WAKE_xxx, reason of the next call */
+    uint16_t   bucket[COS_LATENCY_BUCKETS]; /*!< counters, logarithmic */
+} CosTaskLatency_t;
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Notes that a task has been set ready, e.g. by a semaphore.
+ *
+ * @par Macro parameters: (CosTask_t *pt)
+ ************************************************************************/
+#define COS_LATENCY_SET_READY(pt)  _latencySetReady(pt)
+
+void       _latencyReset(CosTaskLatency_t *lat);
+void       _latencySetReady(struct CosTask_t *pt);
+void       _latencyBeforeCall(struct CosTask_t *pt, CosTicks_t t_Ticks);
+void       _latencyAfterCall(struct CosTask_t *pt, CosTicks_t end_Ticks);
+
+int8_t     COS_GetTaskLatency(struct CosTask_t *task_pt, CosTaskLatency_t *lat);
+int8_t     COS_ResetTaskLatency(struct CosTask_t *task_pt);
+CosTicks_t COS_TaskLatencyPercentile_Ticks(const CosTaskLatency_t *lat, uint16_t perMille);
+
+#else
+
+#define COS_LATENCY_SET_READY(pt)
+
+#endif // COS_TASK_LATENCY
+
+
+#endif
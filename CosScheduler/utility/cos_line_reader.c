@@ -0,0 +1,510 @@
+/*!
+ ********************************************************************
+   @file            cos_line_reader.c
+   @par Project   : co-operative scheduler (COS)
+   @par Module    : Non-blocking line input
+
+   @brief  Line reader for COS. Received bytes are collected into lines
+          without waiting, complete lines are passed to the consumers by
+          a message queue, see cos_line_reader.h.
+
+   @par Author    : Ernst Forgber (Fgb)
+   @par Company   : Hochschule Hannover - University of Applied Sciences and Arts, Germany
+   @par Department: Faculty 1
+ ********************************************************************
+
+   @par History   :
+   @verbatim
+   Version | Date        | Author | Change Description
+   0.0     | 18.10. 2026 | Fgb    | First Version
+   @endverbatim
+
+ ********************************************************************/
+/**************************************************************************
+
+Copyright 2026 Ernst Forgber
+
+
+This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+
+
+
+
+#include <stdlib.h>
+#include "cos_ser.h"
+#include "cos_line_reader.h"
+#include "cos_memory.h"
+
+
+
+
+/*------------- DEBUGGING ---------------------------------*/
+#define DEBUG_MODULE 0  /*!< 0 for no additional debug code, 1 otherwise */
+
+#if DEBUG_MODULE
+  #define DebugCode( code_fragment ) { code_fragment } /*!< for debugging only: insert some code */
+#else
+  #define DebugCode( code_fragment ) /*!< for debugging only: insert some code */
+#endif
+
+#if DEBUG_MODULE
+static void _msg(char *msg)
+{
+    DebugCode(serPuts(msg););
+}
+#endif
+/*---------------------------------------------------------------*/
+
+
+
+/****************************************************************/
+/* private functions */
+/****************************************************************/
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Stores the current line with its '\0' in the queue and starts a new
+ * line. A line that does not fit is dropped, the reader must not block.
+ ************************************************************************/
+static void _endOfLine(CosLineReader_t *lr)
+{
+  lr->line[lr->len] = '\0';
+  if(lr->truncated)
+  { lr->overflows++;
+  }
+  if(1 != _mqWrite(&(lr->lines), lr->line, (uint8_t)(lr->len + 1)))
+  { lr->dropped++;  /* queue full */
+  }
+  lr->len = 0;
+  lr->truncated = 0;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * The reader task takes all bytes serPollc() delivers, then sleeps for
+ * the poll period. pData points to the line reader.
+ ************************************************************************/
+static void _lineReaderTask(CosTask_t *pt)
+{ CosLineReader_t *lr = (CosLineReader_t *) pt->pData;
+  int16_t c;
+
+  COS_TASK_BEGIN(pt);
+  while(1)
+  { while((c = serPollc()) >= 0)
+    { COS_LineReaderPutc(lr, (char) c);
+    }
+    COS_TASK_SLEEP(pt, lr->period_Ticks);
+  }
+  COS_TASK_END(pt);
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Skips blanks and tabs.
+ ************************************************************************/
+static const char *_skipBlanks(const char *s)
+{
+  while((*s == ' ') || (*s == '\t'))
+  { s++;
+  }
+  return s;
+}
+
+
+
+
+/****************************************************************/
+/* exported module functions */
+/****************************************************************/
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * This function creates a line reader for lines of up to 'lineSize'-1
+ * bytes and a queue of 'queueSize' bytes for complete lines. Each line
+ * uses its length plus two bytes of the queue.
+ *
+ * @see
+ * @arg  COS_LineReaderDestroy(), COS_LineReaderStart()
+ *
+ *
+ * @param  lr              - IN/OUT, pointer to line reader struct
+ * @param  lineSize        - IN, size of the line buffer (2..255)
+ * @param  queueSize       - IN, size of the queue in bytes, at least lineSize + 1
+ *
+ * @retval 0               - no error
+ * @retval negative        - an error occurrred
+ *
+ * @par Code example:
+ * @verbatim
+CosLineReader_t console;
+
+int main(void)
+{
+  ...
+  if(0 != COS_LineReaderCreate(&console, 40, 128))
+    serPuts("error creating line reader");
+  ...
+}
+  @endverbatim
+ ************************************************************************/
+int8_t COS_LineReaderCreate(CosLineReader_t *lr, uint8_t lineSize, uint16_t queueSize)
+{
+  lr->isInitialized = 0;
+  if((lineSize < 2) || (queueSize < (uint16_t) lineSize + 1))
+  { DebugCode(_msg("LineReaderCreate:param!"););
+    return -1;
+  }
+  lr->line = (char *) _memAlloc(lineSize * sizeof(char));
+  if(lr->line == NULL)
+  { DebugCode(_msg("LineReaderCreate:malloc!"););
+    return -1;
+  }
+  if(0 != COS_MsgQueueCreate(&(lr->lines), queueSize))
+  { _memFree(lr->line, lineSize * sizeof(char));
+    lr->line = NULL;
+    return -1;
+  }
+  lr->size = lineSize;
+  lr->len = 0;
+  lr->truncated = 0;
+  lr->lastByte = 0;
+  lr->overflows = 0;
+  lr->dropped = 0;
+  lr->period_Ticks = 0;
+  lr->isInitialized = 1;
+  return 0;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * This function releases the memory of a line reader. A reader task
+ * must have been deleted before.
+ *
+ * @param  lr              - IN/OUT, pointer to line reader struct
+ *
+ * @retval 0               - no error
+ * @retval negative        - an error occurrred
+ ************************************************************************/
+int8_t COS_LineReaderDestroy(CosLineReader_t *lr)
+{
+  if(lr->isInitialized == 0)
+  { DebugCode(_msg("LineReaderDestroy:not init."););
+    return -1;
+  }
+  _memFree(lr->line, lr->size * sizeof(char));
+  lr->line = NULL;
+  lr->isInitialized = 0;
+  return COS_MsgQueueDestroy(&(lr->lines));
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Adds a received byte to the current line. CR or LF end the line, the
+ * LF of CR LF is skipped. Backspace (0x08) and DEL (0x7F) remove the
+ * last byte. Other control characters are ignored. Bytes that do not
+ * fit into the line buffer are discarded, the line is counted as
+ * overflow. The function never blocks; it must not be called from an
+ * interrupt service routine.
+ *
+ * @param  lr              - IN/OUT, pointer to line reader struct
+ * @param  c               - IN, received byte
+ *
+ * @retval 1               - a line has been completed
+ * @retval 0               - byte stored or ignored
+ * @retval negative        - not initialized
+ ************************************************************************/
+int8_t COS_LineReaderPutc(CosLineReader_t *lr, char c)
+{ char last = lr->lastByte;
+
+  if(lr->isInitialized == 0)
+  { return -1;
+  }
+  lr->lastByte = c;
+  if((c == '\r') || (c == '\n'))
+  { if((c == '\n') && (last == '\r'))
+    { return 0;  /* LF of CR LF */
+    }
+    _endOfLine(lr);
+    return 1;
+  }
+  if((c == 0x08) || (c == 0x7F))
+  { if(lr->len > 0)
+    { lr->len--;
+    }
+    return 0;
+  }
+  if((uint8_t) c < ' ')
+  { return 0;
+  }
+  if(lr->len < lr->size - 1)
+  { lr->line[lr->len++] = c;
+  }
+  else
+  { lr->truncated = 1;
+  }
+  return 0;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Creates a task that polls the serial interface with serPollc() every
+ * 'period_Ticks' and feeds the line reader. The period should be
+ * shorter than the time to fill the receive buffer of the serial
+ * driver. Without this task, the application feeds the line reader by
+ * COS_LineReaderPutc().
+ *
+ * @param  lr              - IN/OUT, pointer to line reader struct
+ * @param  prio            - IN, priority of the reader task
+ * @param  period_Ticks    - IN, poll period
+ *
+ * @retval pointer to the reader task, NULL on error
+ ************************************************************************/
+CosTask_t *COS_LineReaderStart(CosLineReader_t *lr, uint8_t prio, CosTicks_t period_Ticks)
+{
+  if(lr->isInitialized == 0)
+  { DebugCode(_msg("LineReaderStart:not init."););
+    return NULL;
+  }
+  lr->period_Ticks = period_Ticks;
+  return COS_CreateTask(prio, lr, _lineReaderTask);
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Reads the oldest complete line without waiting, see
+ * COS_LineReaderBlockingRead().
+ *
+ * @param  lr              - IN/OUT, pointer to line reader struct
+ * @param  data            - OUT, buffer for the line
+ * @param  maxLen          - IN, size of the buffer in bytes
+ *
+ * @retval number of bytes read including '\0', 0 if there is no line,
+ *         negative on error
+ ************************************************************************/
+int16_t COS_LineReaderTryRead(CosLineReader_t *lr, char *data, uint8_t maxLen)
+{ int16_t len;
+
+  if(lr->isInitialized == 0)
+  { return -1;
+  }
+  len = COS_MsgQueueTryRead(&(lr->lines), data, maxLen);
+  _lrTerminate(data, maxLen, len);
+  return len;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * PLEASE NOTE: This function is for internal use only! Terminates a
+ * line that has been truncated to the buffer size.
+ ************************************************************************/
+void _lrTerminate(char *data, uint8_t maxLen, int16_t len)
+{
+  if((len > 0) && (maxLen > 0))
+  { data[len - 1] = '\0';
+  }
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Reads an unsigned decimal number from a line. Leading blanks are
+ * skipped, the number ends at the first byte that is not a digit.
+ * *s is moved behind the number, so a line with several numbers is
+ * parsed by repeated calls.
+ *
+ * @param  s               - IN/OUT, position in the line
+ * @param  x               - OUT, value
+ *
+ * @retval 0               - ok
+ * @retval 1               - overflow, *x unchanged
+ * @retval -1              - no digit, *s unchanged
+ ************************************************************************/
+int8_t COS_LineParseUint16Dec(const char **s, uint16_t *x)
+{ const char *pt = _skipBlanks(*s);
+  uint32_t value = 0;
+  uint8_t err = 0;
+
+  if((*pt < '0') || (*pt > '9'))
+  { return -1;
+  }
+  while((*pt >= '0') && (*pt <= '9'))
+  { value = value * 10 + (uint32_t)(*pt - '0');
+    if(value > 65535)
+    { value = 65536;  /* stays too large */
+      err = 1;
+    }
+    pt++;
+  }
+  *s = pt;
+  if(err)
+  { return 1;
+  }
+  *x = (uint16_t) value;
+  return 0;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Reads a signed decimal number with optional sign from a line, see
+ * COS_LineParseUint16Dec().
+ *
+ * @param  s               - IN/OUT, position in the line
+ * @param  x               - OUT, value
+ *
+ * @retval 0               - ok
+ * @retval 1               - overflow or underflow, *x unchanged
+ * @retval -1              - no number, *s unchanged
+ ************************************************************************/
+int8_t COS_LineParseInt16Dec(const char **s, int16_t *x)
+{ const char *pt = _skipBlanks(*s);
+  uint16_t u;
+  uint8_t neg = 0;
+  int8_t ret;
+
+  if((*pt == '-') || (*pt == '+'))
+  { neg = (*pt == '-');
+    pt++;
+  }
+  if((*pt < '0') || (*pt > '9'))
+  { return -1;
+  }
+  ret = COS_LineParseUint16Dec(&pt, &u);
+  *s = pt;
+  if((ret != 0) || (u > (neg ? 32768U : 32767U)))
+  { return 1;
+  }
+  *x = neg ? (int16_t)(0 - (int32_t) u) : (int16_t) u;
+  return 0;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Reads a hex number with prefix 0x or 0X from a line, see
+ * COS_LineParseUint16Dec().
+ *
+ * @param  s               - IN/OUT, position in the line
+ * @param  x               - OUT, value
+ *
+ * @retval 0               - ok
+ * @retval 1               - overflow, *x unchanged
+ * @retval -1              - no hex number, *s unchanged
+ ************************************************************************/
+int8_t COS_LineParseUint16Hex(const char **s, uint16_t *x)
+{ const char *pt = _skipBlanks(*s);
+  uint32_t value = 0;
+  uint8_t n = 0, err = 0, d;
+
+  if((pt[0] != '0') || ((pt[1] != 'x') && (pt[1] != 'X')))
+  { return -1;
+  }
+  pt += 2;
+  while(1)
+  { if((*pt >= '0') && (*pt <= '9'))      d = (uint8_t)(*pt - '0');
+    else if((*pt >= 'A') && (*pt <= 'F')) d = (uint8_t)(*pt - 'A' + 10);
+    else if((*pt >= 'a') && (*pt <= 'f')) d = (uint8_t)(*pt - 'a' + 10);
+    else break;
+    value = (value << 4) + d;
+    if(value > 0xFFFF)
+    { value = 0x10000;
+      err = 1;
+    }
+    n++;
+    pt++;
+  }
+  if(n == 0)
+  { return -1;
+  }
+  *s = pt;
+  if(err)
+  { return 1;
+  }
+  *x = (uint16_t) value;
+  return 0;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Copies the next word of a line, e.g. a command, up to the next blank.
+ * A word longer than maxLen-1 bytes is truncated, *s is moved behind
+ * the whole word.
+ *
+ * @param  s               - IN/OUT, position in the line
+ * @param  word            - OUT, the word with '\0'
+ * @param  maxLen          - IN, size of 'word' in bytes, at least 1
+ *
+ * @retval length of the word, 0 at the end of the line
+ ************************************************************************/
+int8_t COS_LineParseWord(const char **s, char *word, uint8_t maxLen)
+{ const char *pt = _skipBlanks(*s);
+  uint8_t n = 0;
+
+  while((*pt != '\0') && (*pt != ' ') && (*pt != '\t'))
+  { if(n + 1 < maxLen)
+    { word[n++] = *pt;
+    }
+    pt++;
+  }
+  word[n] = '\0';
+  *s = pt;
+  return (int8_t) n;
+}
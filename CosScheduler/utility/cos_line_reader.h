@@ -0,0 +1,183 @@
+/*!
+ ********************************************************************
+   @file            cos_line_reader.h
+   @par Project   : co-operative scheduler (COS)
+   @par Module    : Non-blocking line input
+
+   @brief  Line reader for command input. serGets() and the serIn...()
+          functions wait in serGetc() until a line is complete, all
+          tasks stand still meanwhile. The line reader collects the
+          received bytes without waiting: a polling task started by
+          COS_LineReaderStart() takes all bytes serPollc() delivers, or
+          a task of the application feeds them by COS_LineReaderPutc().
+          On RX63N, serPollc() reads the buffer of the RX interrupt of
+          the board support package, no byte is lost while other tasks
+          run.
+
+          A line ends with CR, LF or CR LF. Backspace and DEL remove the
+          last byte. A complete line is stored in a message queue with a
+          terminating '\0', consumers wait for it with
+          COS_LineReaderBlockingRead() and parse it with the
+          COS_LineParse...() functions. A line longer than the line
+          buffer is truncated, a line that does not fit into the queue
+          is dropped; both are counted.
+
+          The line reader uses dynamic memory allocation (_memAlloc()).
+
+   @par Author    : Ernst Forgber (Fgb)
+   @par Company   : Hochschule Hannover - University of Applied Sciences and Arts, Germany
+   @par Department: Faculty 1
+ ********************************************************************
+
+   @par History   :
+   @verbatim
+   Version | Date        | Author | Change Description
+   0.0     | 18.10. 2026 | Fgb    | First Version
+   @endverbatim
+
+ ********************************************************************/
+/**************************************************************************
+
+Copyright 2026 Ernst Forgber
+
+
+This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+
+
+
+#ifndef _cos_line_reader_h_
+#define _cos_line_reader_h_
+
+
+#include "cos_configure.h"
+#include "cos_scheduler.h"
+#include "cos_msg_queue.h"
+#include "cos_types.h"
+
+
+/*!
+ ********************************************************************
+  @par Description
+  Line reader data structure. 'line' collects the bytes of the current
+  line, 'lines' holds the complete lines.
+********************************************************************/
+typedef struct                 /*! line reader data structure */
+{
+        char *line;            /*!< line being received */
+        uint8_t size;          /*!< size of 'line', including '\0' */
+        uint8_t len;           /*!< bytes in 'line' */
+        uint8_t truncated;     /*!< 1 if the current line is too long */
+        char lastByte;         /*!< to skip the LF of CR LF */
+        uint16_t overflows;    /*!< lines truncated */
+        uint16_t dropped;      /*!< lines lost, queue full */
+        CosTicks_t period_Ticks; /*!< poll period of the reader task */
+        CosMsgQueue_t lines;   /*!< complete lines with '\0' */
+        uint8_t isInitialized; /*!< 0 if not yet initialized */
+} CosLineReader_t;
+
+
+
+int8_t     COS_LineReaderCreate(CosLineReader_t *lr, uint8_t lineSize, uint16_t queueSize);
+int8_t     COS_LineReaderDestroy(CosLineReader_t *lr);
+int8_t     COS_LineReaderPutc(CosLineReader_t *lr, char c);
+CosTask_t *COS_LineReaderStart(CosLineReader_t *lr, uint8_t prio, CosTicks_t period_Ticks);
+int16_t    COS_LineReaderTryRead(CosLineReader_t *lr, char *data, uint8_t maxLen);
+
+int8_t     COS_LineParseUint16Dec(const char **s, uint16_t *x);
+int8_t     COS_LineParseInt16Dec(const char **s, int16_t *x);
+int8_t     COS_LineParseUint16Hex(const char **s, uint16_t *x);
+int8_t     COS_LineParseWord(const char **s, char *word, uint8_t maxLen);
+
+
+// blocking Macros
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * This macro reads the oldest complete line. If there is none, the
+ * task *pt is changed to state TASK_STATE_BLOCKED until a line is
+ * complete. The line is terminated by '\0', 'len' counts the '\0'.
+ * A line longer than 'maxLen' - 1 is truncated.
+ *
+ * @see
+ * @arg  COS_LineReaderStart(), COS_LineParseUint16Dec()
+ *
+ * @par Macro parameters: (CosTask_t *pt, CosLineReader_t *lr, char *data, uint8_t maxLen, int16_t len)
+ *
+ * @param  pt              - IN/OUT, pointer to task struct
+ * @param  lr              - IN/OUT, pointer to line reader struct
+ * @param  data            - OUT, buffer for the line
+ * @param  maxLen          - IN, size of the buffer in bytes
+ * @param  len             - OUT, variable for the number of bytes read
+ * @retval void
+ * @par Example :
+ *    A command task reads commands like "speed 120" while the control
+ *    tasks go on running:
+ * @verbatim
+CosLineReader_t console;
+
+void Task_Cmd(CosTask_t *pt)
+{   static char cmd[40];
+    static int16_t len;
+    char word[8];
+    const char *s;
+    uint16_t x;
+
+    COS_TASK_BEGIN(pt);
+    while(1)
+    {   COS_LineReaderBlockingRead(pt, &console, cmd, sizeof(cmd), len);
+        s = cmd;
+        if((COS_LineParseWord(&s, word, sizeof(word)) > 0) &&
+           (0 == strcmp(word, "speed")) && (0 == COS_LineParseUint16Dec(&s, &x)))
+        {   setSpeed(x);
+        }
+        else
+        {   serPuts("?\r\n");
+        }
+    }
+    COS_TASK_END(pt);
+}
+
+int main(void)
+{ ...
+  COS_InitTaskList();
+  if(0 != COS_LineReaderCreate(&console, 40, 128))
+    serPuts("error creating line reader");
+  COS_LineReaderStart(&console, 1, _milliSecToTicks(10));
+  COS_CreateTask(2, NULL, Task_Cmd);
+  ...
+}
+  @endverbatim
+ ************************************************************************/
+#define COS_LineReaderBlockingRead(pt, lr, data, maxLen, len)  COS_MsgQueueBlockingRead((pt), &((lr)->lines), (data), (maxLen), (len)); \
+                                                  _lrTerminate((char *)(data), (maxLen), (len))
+
+void _lrTerminate(char *data, uint8_t maxLen, int16_t len);
+
+#endif
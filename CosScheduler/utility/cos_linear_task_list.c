@@ -19,6 +19,13 @@
    0.1     | 17.09. 2013 | Fgb           | nur noch Atmel, deutsche Doku
    0.2     | 08.10. 2015 | Fgb           | umgeschrieben fuer renesas
    0.3     | 20.11.2016  | Fgb           | english docu
+   0.4     | 18.10.2026  | Fgb           | task statistics, trace id
+   0.5     | 18.10.2026  | Fgb           | wake-up latency histogram
+   0.6     | 18.10.2026  | Fgb           | nodes and tasks from _memAlloc()
+   0.7     | 18.10.2026  | Fgb           | execution budget
+   0.8     | 18.10.2026  | Fgb           | user data in the block of the task
+   0.9     | 18.10.2026  | Fgb           | _setTaskReady()
+   0.10    | 18.10.2026  | Fgb           | budget suspend of a blocked task
    @endverbatim
 
 Routines for linear list management
@@ -60,15 +67,15 @@ This program is free software: you can redistribute it and/or modify
     You should have received a copy of the GNU General Public License
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
-    Dieses Programm ist Freie Software: Sie knnen es unter den Bedingungen
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
     der GNU General Public License, wie von der Free Software Foundation,
     Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
-    verffentlichten Version, weiterverbreiten und/oder modifizieren.
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
 
-    Dieses Programm wird in der Hoffnung, dass es ntzlich sein wird, aber
-    OHNE JEDE GEWHRLEISTUNG, bereitgestellt; sogar ohne die implizite
-    Gewhrleistung der MARKTFHIGKEIT oder EIGNUNG FR EINEN BESTIMMTEN ZWECK.
-    Siehe die GNU General Public License fr weitere Details.
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
 
     Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
     Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
@@ -77,12 +84,15 @@ This program is free software: you can redistribute it and/or modify
 
 
 #include <stdlib.h>
+#include <string.h>  // for memset()
 //#include <avr/io.h>
 //#include <stdint.h>
 #include "cos_ser.h"
 #include <stdio.h>  // for degugging on serial terminal
 
 #include "cos_linear_task_list.h"
+#include "cos_trace.h"
+#include "cos_memory.h"
 
 
 
@@ -200,7 +210,7 @@ int main(void)
     /* is it the first node in the list? root_pt has to be changed... */
     if(pt == root_pt)
     {   pt = pt->next_pt; /* second node in list */
-        free(root_pt); /* free the first node, don't touch the task! */
+        _memFree(root_pt, sizeof(Node_t)); /* free the first node, don't touch the task! */
         return pt;    /* the old second element now is the first */
     }
     /* node exists, is not the first list element, should have a predecessor... */
@@ -211,7 +221,7 @@ int main(void)
     }
     /* task node and its predecessor have been found. Unlink task node: */
     predecessor_pt->next_pt = pt->next_pt;
-    free(pt); /* free the node, don't touch the task! */
+    _memFree(pt, sizeof(Node_t)); /* free the node, don't touch the task! */
     return root_pt; /* old first list element still is the first */
 }
 
@@ -356,7 +366,7 @@ int main(void)
 ********************************************************************/
 Node_t *_newNode(CosTask_t *task_pt)
 {   Node_t *pt;
-    pt = (Node_t *) malloc(sizeof(Node_t));
+    pt = (Node_t *) _memAlloc(sizeof(Node_t));
     if(pt!=NULL)
     {   pt->task_pt = task_pt;
         pt->next_pt = NULL;
@@ -376,6 +386,8 @@ Node_t *_newNode(CosTask_t *task_pt)
 
 @param  prio - IN priority of the task (min) 1..254 (max)
 @param  pData -IN pointer to private user data of the task
+@param  dataSize -IN bytes of user data to allocate behind the task
+                   struct, cleared to 0; pData is ignored if > 0
 @param  func  -IN name of task callback-function
 
 
@@ -396,9 +408,9 @@ int main(void)
 }
 @endverbatim
 ********************************************************************/
-CosTask_t *_newTask(uint8_t prio, void * pData, void (*func) (CosTask_t *))
+CosTask_t *_newTask(uint8_t prio, void * pData, uint16_t dataSize, void (*func) (CosTask_t *))
 {  CosTask_t *pt;
-   pt = (CosTask_t *)malloc(sizeof(CosTask_t));
+   pt = (CosTask_t *)_memAlloc(_TASK_BLOCK_SIZE(dataSize));
 
    if(pt!=NULL)
    {  pt->lastActivationTime_Ticks  = _gettime_Ticks();
@@ -406,12 +418,78 @@ CosTask_t *_newTask(uint8_t prio, void * pData, void (*func) (CosTask_t *))
       pt->state                     = TASK_STATE_READY;
       pt->prio                      = prio;
       pt->lineCnt                   = 0;    /* re-entry at start of function */
+      pt->dataSize                  = dataSize;
+      if(dataSize > 0)
+      {  pData = (char *)pt + COS_TASK_DATA_OFFSET;
+         memset(pData, 0, dataSize);
+      }
       pt->pData                     = pData;
       pt->func                      = func;
+#if COS_TASK_STATISTICS
+      _resetTaskStats(&pt->stats);
+#endif
+#if COS_TRACE
+      pt->traceId = _traceNewTaskId();
+#endif
+#if COS_TASK_LATENCY
+      _latencyReset(&pt->latency);
+#endif
+#if COS_TASK_BUDGET
+      pt->budget_Ticks   = 0;  /* no limit */
+      pt->budgetOverruns = 0;
+      pt->budgetAction   = 0;  /* COS_BUDGET_REPORT */
+      pt->budgetSuspend  = 0;
+#endif
    }
    return pt;
 }
 
+/*---------------------------------------------------------------*/
+/*!
+********************************************************************
+  @par Description
+  Sets a task to state TASK_STATE_READY. Every module that wakes up a
+  task calls this function: a blocked task is traced as unblocked, and
+  the time is noted for the wake-up latency. Without it, the latency
+  would include the whole time the task waited. A task, that has
+  violated its budget with COS_BUDGET_SUSPEND while it was blocked, is
+  suspended instead.
+
+@param task_pt - IN/OUT, pointer to task struct
+********************************************************************/
+void _setTaskReady(CosTask_t *task_pt)
+{  if(TASK_STATE_BLOCKED == task_pt->state)
+   {  COS_TRACE_EVENT(COS_TRACE_UNBLOCK, task_pt, 0);
+   }
+#if COS_TASK_BUDGET
+   if(task_pt->budgetSuspend)
+   {  task_pt->budgetSuspend = 0;
+      task_pt->state = TASK_STATE_SUSPENDED;
+      return;
+   }
+#endif
+   task_pt->state = TASK_STATE_READY;
+   COS_LATENCY_SET_READY(task_pt);
+}
+
+/*---------------------------------------------------------------*/
+#if COS_TASK_STATISTICS
+/*!
+********************************************************************
+  @par Description
+  Clears the execution statistics of a task.
+
+@param stats - OUT, pointer to statistics of a task
+********************************************************************/
+void _resetTaskStats(CosTaskStats_t *stats)
+{  stats->activations = 0;
+   stats->total_Ticks = 0;
+   stats->min_Ticks   = (CosTicks_t)(-1);  /* any call will be shorter */
+   stats->max_Ticks   = 0;
+   stats->last_Ticks  = 0;
+}
+#endif
+
 /*---------------------------------------------------------------*/
 
 
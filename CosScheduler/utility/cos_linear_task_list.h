@@ -20,6 +20,14 @@
    0.1     | 17.09. 2013 | Fgb           | nur noch Atmel, deutsche Doku.
    0.2     | 09.10.2015  | Fgb           | umgestiegen auf renesas controller
    0.3     | 20.11.2016  | Fgb           | english docu
+   0.4     | 18.10.2026  | Fgb           | time in CosTicks_t
+   0.5     | 18.10.2026  | Fgb           | task statistics
+   0.6     | 18.10.2026  | Fgb           | trace id
+   0.7     | 18.10.2026  | Fgb           | wake-up latency histogram
+   0.8     | 18.10.2026  | Fgb           | execution budget
+   0.9     | 18.10.2026  | Fgb           | user data in the block of the task
+   0.10    | 18.10.2026  | Fgb           | _setTaskReady()
+   0.11    | 18.10.2026  | Fgb           | budget suspend of a blocked task
    @endverbatim
 
    Routines for linear list management
@@ -62,15 +70,15 @@ This program is free software: you can redistribute it and/or modify
     You should have received a copy of the GNU General Public License
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
-    Dieses Programm ist Freie Software: Sie knnen es unter den Bedingungen
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
     der GNU General Public License, wie von der Free Software Foundation,
     Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
-    verffentlichten Version, weiterverbreiten und/oder modifizieren.
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
 
-    Dieses Programm wird in der Hoffnung, dass es ntzlich sein wird, aber
-    OHNE JEDE GEWHRLEISTUNG, bereitgestellt; sogar ohne die implizite
-    Gewhrleistung der MARKTFHIGKEIT oder EIGNUNG FR EINEN BESTIMMTEN ZWECK.
-    Siehe die GNU General Public License fr weitere Details.
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
 
     Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
     Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
@@ -83,6 +91,7 @@ This program is free software: you can redistribute it and/or modify
 
 #include "cos_configure.h"
 #include "cos_systime.h"
+#include "cos_latency.h"
 #include <stdlib.h>
 
 
@@ -128,6 +137,8 @@ This program is free software: you can redistribute it and/or modify
 * the task callback-variable.
 * The pointer 'pData'may be used to point to a user data struct, storing 
 * data private to the individual task.
+* COS_CreateTaskWithData() allocates this struct together with the task
+* struct in one block, 'dataSize' bytes behind it (COS_TASK_DATA_OFFSET).
 * 
 
 
@@ -135,21 +146,57 @@ This program is free software: you can redistribute it and/or modify
 
   @see
  ********************************************************************/
+#if COS_TASK_STATISTICS
+typedef struct                 /*! execution statistics of a task */
+{   uint32_t   activations;    /*!< number of calls of the task function */
+    uint64_t   total_Ticks;    /*!< sum of all execution times */
+    CosTicks_t min_Ticks;      /*!< shortest execution time */
+    CosTicks_t max_Ticks;      /*!< longest execution time */
+    CosTicks_t last_Ticks;     /*!< execution time of the last call */
+} CosTaskStats_t;
+#endif
+
 typedef struct CosTask_t CosTask_t;
 struct CosTask_t                       /*! task struct */
-{   uint16_t lastActivationTime_Ticks; /*!< last activation time in ticks */
-    uint16_t sleepTime_Ticks;          /*!< will cause the task to block.
+{   CosTicks_t lastActivationTime_Ticks; /*!< last activation time in ticks */
+    CosTicks_t sleepTime_Ticks;        /*!< will cause the task to block.
                                             0 == sleepTime_Ticks means:
                                             start asap */
     uint8_t  state;     /*!< task states:  TASK_STATE_READY,
                              TASK_STATE_SUSPENDED, TASK_STATE_BLOCKED */
     uint8_t  prio;      /*!< priority, 1 ist minimum, 254 ist maximum. 0 and 255 reserved */
     uint16_t lineCnt;   /*!< stores code line number for re-entry */
+    uint16_t dataSize;  /*!< bytes of user data in the block of the task, 
+                             see COS_CreateTaskWithData() */
     void * pData;       /*!< pointer to user-data, opportunity to store 
                              locale task-variables */
     void (*func)(CosTask_t*); /*!< name of the task callback-function */
+#if COS_TASK_STATISTICS
+    CosTaskStats_t stats;     /*!< updated by the scheduler after every call */
+#endif
+#if COS_TRACE
+    uint16_t traceId;         /*!< identifies the task in trace records */
+#endif
+#if COS_TASK_LATENCY
+    CosTaskLatency_t latency; /*!< updated by the scheduler before and after every call */
+#endif
+#if COS_TASK_BUDGET
+    CosTicks_t budget_Ticks;  /*!< longest call allowed, 0: no limit */
+    uint16_t budgetOverruns;  /*!< calls longer than budget_Ticks */
+    uint8_t  budgetAction;    /*!< COS_BUDGET_REPORT or COS_BUDGET_SUSPEND */
+    uint8_t  budgetSuspend;   /*!< suspend instead of ready when unblocked */
+#endif
 };
 
+/*! alignment of the user data behind the task struct, see COS_CreateTaskWithData() */
+#define COS_TASK_DATA_ALIGN   8
+
+/*! offset of the user data in the block of the task */
+#define COS_TASK_DATA_OFFSET  ((sizeof(CosTask_t) + COS_TASK_DATA_ALIGN - 1) / COS_TASK_DATA_ALIGN * COS_TASK_DATA_ALIGN)
+
+/*! size of the block of a task, as passed to _memAlloc() */
+#define _TASK_BLOCK_SIZE(dataSize)  (((dataSize) > 0) ? COS_TASK_DATA_OFFSET + (dataSize) : sizeof(CosTask_t))
+
 
 /*!
  ********************************************************************
@@ -171,7 +218,11 @@ Node_t *_searchTaskInList(Node_t *root_pt, CosTask_t *task_pt);
 Node_t *_searchPredecessorTaskInList(Node_t *root_pt, CosTask_t *task_pt);
 Node_t *_newNode(CosTask_t *task_pt);
 void _sortLinearListPrio(Node_t *root_pt);
-CosTask_t *_newTask(uint8_t prio, void * pData, void (*func) (CosTask_t *));
+CosTask_t *_newTask(uint8_t prio, void * pData, uint16_t dataSize, void (*func) (CosTask_t *));
+void _setTaskReady(CosTask_t *task_pt);
+#if COS_TASK_STATISTICS
+void _resetTaskStats(CosTaskStats_t *stats);
+#endif
 
 
 
@@ -0,0 +1,272 @@
+/*!
+ ********************************************************************
+   @file            cos_log.c
+   @par Project   : co-operative scheduler (COS)
+   @par Module    : Deferred-format logging
+
+   @brief  Ring buffer of log records and their transmission in binary
+          frames, see cos_log.h.
+
+          A record is a sequence of 32 bit words: time stamp
+          (_gettime_Ticks()), header (_LOG_HEADER()) and the arguments.
+          COS_LogSend() packs whole records into frames of type
+          COS_FRAME_TYPE_LOG, all values low byte first:
+
+   @verbatim
+   offset  size  content
+   0       2     COS_MICROSEC_PER_TICK
+   2       1     bits of the time stamp, 16 or 32
+   3       1     records lost since the previous frame, up to 255
+   4       ..    records
+   @endverbatim
+
+   @par Author    : Ernst Forgber (Fgb)
+   @par Company   : Hochschule Hannover - University of Applied Sciences and Arts, Germany
+   @par Department: Faculty 1
+ ********************************************************************
+
+   @par History   :
+   @verbatim
+   Version | Date        | Author | Change Description
+   0.0     | 18.10. 2026 | Fgb    | First Version
+   @endverbatim
+
+ ********************************************************************/
+/**************************************************************************
+
+Copyright 2026 Ernst Forgber
+
+
+This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+
+
+
+
+#include "cos_systime.h"
+#include "cos_frame.h"
+#include "cos_log.h"
+
+#if COS_LOG
+
+#if (COS_LOG_BUFFER_WORDS & (COS_LOG_BUFFER_WORDS - 1)) != 0
+  #error "COS_LOG_BUFFER_WORDS has to be a power of two"
+#endif
+
+
+
+/*------------- DEBUGGING ---------------------------------*/
+#define DEBUG_MODULE 0  /*!< 0 for no additional debug code, 1 otherwise */
+
+#if DEBUG_MODULE
+  #define DebugCode( code_fragment ) { code_fragment } /*!< for debugging only: insert some code */
+#else
+  #define DebugCode( code_fragment ) /*!< for debugging only: insert some code */
+#endif
+/*---------------------------------------------------------------*/
+
+
+/*! wraps indices of the ring buffer */
+#define LOG_INDEX_MASK   (COS_LOG_BUFFER_WORDS - 1)
+
+/*! words of the record starting at index i */
+#define RECORD_WORDS(i)  (2 + (buffer_g[((i) + 1) & LOG_INDEX_MASK] >> 28))
+
+#define FRAME_HEADER     4  /*!< bytes in front of the records of a frame */
+
+
+/****************************************************************/
+/* private module variables */
+/****************************************************************/
+static uint32_t buffer_g[COS_LOG_BUFFER_WORDS]; /*!< ring buffer */
+static uint16_t head_g = 0;        /*!< next word to write */
+static uint16_t used_g = 0;        /*!< words in buffer */
+static uint32_t lost_g = 0;        /*!< overwritten records */
+static uint32_t lostSent_g = 0;    /*!< lost_g reported by COS_LogSend() */
+static uint8_t  enabled_g = 1;     /*!< 0: logging stopped */
+
+
+
+/****************************************************************/
+/* exported module functions */
+/****************************************************************/
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * PLEASE NOTE: This function is for internal use only! Use the macros
+ * COS_LOG0() ... COS_LOG4(), that expand to nothing without COS_LOG.
+ * Stores a record in the ring buffer, the oldest records are
+ * overwritten if the buffer is full.
+ *
+ * @param  header          - IN, arguments, file and line, see _LOG_HEADER()
+ * @param  args            - IN, arguments
+ ************************************************************************/
+void _logWrite(uint32_t header, const uint32_t *args)
+{   uint8_t n = (uint8_t)(header >> 28);
+    uint16_t h, w;
+
+    if(!enabled_g)
+    {   return;
+    }
+    while((uint16_t)(COS_LOG_BUFFER_WORDS - used_g) < n + 2)
+    {   w = (uint16_t) RECORD_WORDS((head_g - used_g) & LOG_INDEX_MASK);
+        used_g -= w;  /* oldest record overwritten */
+        lost_g++;
+    }
+    h = head_g;
+    buffer_g[h] = (uint32_t) _gettime_Ticks();
+    h = (h + 1) & LOG_INDEX_MASK;
+    buffer_g[h] = header;
+    while(n-- > 0)
+    {   h = (h + 1) & LOG_INDEX_MASK;
+        buffer_g[h] = *args++;
+    }
+    head_g = (h + 1) & LOG_INDEX_MASK;
+    used_g += (uint16_t)(2 + (header >> 28));
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Starts or stops logging, see COS_TraceEnable().
+ *
+ * @param  on              - IN, 1 to write records, 0 to stop
+ ************************************************************************/
+void COS_LogEnable(uint8_t on)
+{   enabled_g = (0 != on);
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Removes all records from the buffer and clears the lost counter.
+ ************************************************************************/
+void COS_LogClear(void)
+{   head_g = 0;
+    used_g = 0;
+    lost_g = 0;
+    lostSent_g = 0;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Returns the number of words in the buffer, 0 if all records have
+ * been sent.
+ ************************************************************************/
+uint16_t COS_LogGetUsedWords(void)
+{   return used_g;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Returns the number of records, that have been overwritten since the
+ * last COS_LogClear().
+ ************************************************************************/
+uint32_t COS_LogGetLost(void)
+{   return lost_g;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Sends the oldest records in up to 'maxFrames' frames of type
+ * COS_FRAME_TYPE_LOG and removes them from the buffer. Each frame takes
+ * as many whole records as fit into COS_FRAME_MAX_PAYLOAD bytes.
+ * The frames are written by COS_FrameSend(); with a TX buffer, a task
+ * sends one frame per SER_TX_WAIT(), so it never waits for the UART.
+ *
+ * @param  maxFrames       - IN, maximum number of frames to send
+ *
+ * @retval number of frames sent
+ *
+ * @par Code example:
+ * @verbatim
+void logTask(CosTask_t *pt)
+{   COS_TASK_BEGIN(pt);
+    while(1)
+    {   while(COS_LogGetUsedWords() > 0)
+        {   SER_TX_WAIT(pt, COS_FRAME_ENCODED_SIZE(COS_FRAME_MAX_PAYLOAD));
+            COS_LogSend(1);
+        }
+        COS_TASK_SLEEP(pt,_milliSecToTicks(20));
+    }
+    COS_TASK_END(pt);
+}
+  @endverbatim
+ ************************************************************************/
+uint8_t COS_LogSend(uint8_t maxFrames)
+{   uint8_t buf[COS_FRAME_MAX_PAYLOAD];
+    uint8_t frames = 0, len;
+    uint16_t tail, w;
+    uint32_t x, lost;
+
+    while((frames < maxFrames) && (used_g > 0))
+    {   lost = lost_g - lostSent_g;
+        lostSent_g = lost_g;
+        buf[0] = (uint8_t) COS_MICROSEC_PER_TICK;
+        buf[1] = (uint8_t)(COS_MICROSEC_PER_TICK >> 8);
+        buf[2] = (uint8_t)(8 * sizeof(CosTicks_t));
+        buf[3] = (uint8_t)((lost > 255) ? 255 : lost);
+        len = FRAME_HEADER;
+        tail = (head_g - used_g) & LOG_INDEX_MASK;
+        while(used_g > 0)
+        {   w = (uint16_t) RECORD_WORDS(tail);
+            if(len + 4 * w > COS_FRAME_MAX_PAYLOAD)
+            {   break;
+            }
+            used_g -= w;
+            while(w-- > 0)
+            {   x = buffer_g[tail];
+                tail = (tail + 1) & LOG_INDEX_MASK;
+                buf[len++] = (uint8_t) x;
+                buf[len++] = (uint8_t)(x >> 8);
+                buf[len++] = (uint8_t)(x >> 16);
+                buf[len++] = (uint8_t)(x >> 24);
+            }
+        }
+        COS_FrameSend(COS_FRAME_TYPE_LOG, buf, len);
+        frames++;
+    }
+    return frames;
+}
+
+
+#endif // COS_LOG
@@ -0,0 +1,152 @@
+/*!
+ ********************************************************************
+   @file            cos_log.h
+   @par Project   : co-operative scheduler (COS)
+   @par Module    : Deferred-format logging
+
+   @brief  Optional log with formatting on the host. With COS_LOG set to
+          1 in cos_configure.h, a log statement like
+
+   @verbatim
+   COS_LOG2("speed %u -> %u", old, speed);
+   @endverbatim
+
+          does not format any text. It stores a time stamp, the number of
+          the source file, the line and the raw arguments as 32 bit
+          words in a RAM ring buffer of COS_LOG_BUFFER_WORDS words; the
+          format string is not even compiled into the program. A record
+          takes 8 bytes plus 4 bytes per argument, when the buffer is
+          full the oldest records are overwritten. The cost of a log
+          statement is about that of a trace event, it may stay in
+          production code.
+
+          COS_LogSend() sends the records in binary frames (cos_frame.h,
+          type COS_FRAME_TYPE_LOG). The host tool in extras/log2txt reads
+          the source files, takes the format string of every COS_LOGn()
+          statement as string table and prints the records as text.
+          The source files are numbered by the application: define
+          COS_LOG_FILE before including cos_log.h, files without
+          COS_LOG_FILE have number 0.
+
+   @verbatim
+   motor.c:      #define COS_LOG_FILE 1
+                 #include "cos_log.h"
+   host:         ./build/cos_log2txt 0=main.c 1=motor.c < /dev/ttyUSB0
+   @endverbatim
+
+          Rules for the format string: put it on the line of COS_LOGn(),
+          as a single string literal, and use one log statement per line.
+          Supported are %d %i %u %x %X %o %c with flags and width; %s is
+          not possible, the string does not exist on the target.
+
+          With COS_LOG set to 0, the macros expand to nothing and their
+          arguments are not evaluated. Records must not be written from
+          interrupt service routines.
+
+   @par Author    : Ernst Forgber (Fgb)
+   @par Company   : Hochschule Hannover - University of Applied Sciences and Arts, Germany
+   @par Department: Faculty 1
+ ********************************************************************
+
+   @par History   :
+   @verbatim
+   Version | Date        | Author | Change Description
+   0.0     | 18.10. 2026 | Fgb    | First Version
+   @endverbatim
+
+ ********************************************************************/
+/**************************************************************************
+
+Copyright 2026 Ernst Forgber
+
+
+This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+
+
+
+#ifndef _cos_log_h_
+#define _cos_log_h_
+
+
+#include "cos_configure.h"
+#include "cos_types.h"
+
+#ifndef COS_LOG_FILE
+#define COS_LOG_FILE  0 /*!< number of the source file, 0..4095 */
+#endif
+
+
+#if COS_LOG
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Header word of a record: number of arguments (bits 28..31), file
+ * (bits 16..27) and line (bits 0..15).
+ ************************************************************************/
+#define _LOG_HEADER(n)  (((uint32_t)(n) << 28) | ((uint32_t)(COS_LOG_FILE) << 16) | (uint16_t)__LINE__)
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Write a log record with 0..4 arguments. The arguments are converted
+ * to uint32_t, signed values are restored by %d on the host.
+ *
+ * @par Macro parameters: (const char *fmt, a, b, c, d)
+ ************************************************************************/
+#define COS_LOG0(fmt)              _logWrite(_LOG_HEADER(0), (const uint32_t *)0)
+#define COS_LOG1(fmt, a)           do { uint32_t _logArgs[1] = {(uint32_t)(a)}; \
+                                        _logWrite(_LOG_HEADER(1), _logArgs); } while(0)
+#define COS_LOG2(fmt, a, b)        do { uint32_t _logArgs[2] = {(uint32_t)(a), (uint32_t)(b)}; \
+                                        _logWrite(_LOG_HEADER(2), _logArgs); } while(0)
+#define COS_LOG3(fmt, a, b, c)     do { uint32_t _logArgs[3] = {(uint32_t)(a), (uint32_t)(b), (uint32_t)(c)}; \
+                                        _logWrite(_LOG_HEADER(3), _logArgs); } while(0)
+#define COS_LOG4(fmt, a, b, c, d)  do { uint32_t _logArgs[4] = {(uint32_t)(a), (uint32_t)(b), (uint32_t)(c), (uint32_t)(d)}; \
+                                        _logWrite(_LOG_HEADER(4), _logArgs); } while(0)
+
+void     _logWrite(uint32_t header, const uint32_t *args);
+
+void     COS_LogEnable(uint8_t on);
+void     COS_LogClear(void);
+uint16_t COS_LogGetUsedWords(void);
+uint32_t COS_LogGetLost(void);
+uint8_t  COS_LogSend(uint8_t maxFrames);
+
+#else
+
+#define COS_LOG0(fmt)
+#define COS_LOG1(fmt, a)
+#define COS_LOG2(fmt, a, b)
+#define COS_LOG3(fmt, a, b, c)
+#define COS_LOG4(fmt, a, b, c, d)
+
+#endif // COS_LOG
+
+
+#endif
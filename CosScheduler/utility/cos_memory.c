@@ -0,0 +1,210 @@
+/*!
+ ********************************************************************
+   @file            cos_memory.c
+   @par Project   : co-operative scheduler (COS)
+   @par Module    : Heap allocations of COS
+
+   @brief  Allocation layer with counters, see cos_memory.h.
+
+   @par Author    : Ernst Forgber (Fgb)
+   @par Company   : Hochschule Hannover - University of Applied Sciences and Arts, Germany
+   @par Department: Faculty 1
+ ********************************************************************
+
+   @par History   :
+   @verbatim
+   Version | Date        | Author | Change Description
+   0.0     | 18.10. 2026 | Fgb    | First Version
+   0.1     | 18.10. 2026 | Fgb    | statistics not truncated by a full TX buffer
+   @endverbatim
+
+ ********************************************************************/
+/**************************************************************************
+
+Copyright 2026 Ernst Forgber
+
+
+This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+
+
+
+#include "cos_ser.h"
+#include "cos_memory.h"
+
+
+
+/*------------- DEBUGGING ---------------------------------*/
+#define DEBUG_MODULE 0  /*!< 0 for no additional debug code, 1 otherwise */
+
+#if DEBUG_MODULE
+  #define DebugCode( code_fragment ) { code_fragment } /*!< for debugging only: insert some code */
+#else
+  #define DebugCode( code_fragment ) /*!< for debugging only: insert some code */
+#endif
+/*---------------------------------------------------------------*/
+
+
+
+/****************************************************************/
+/* private module variables */
+/****************************************************************/
+#if COS_MEMORY_STATISTICS
+static CosMemStats_t stats_g = {0, 0, 0, 0, 0, 0}; /*!< heap counters */
+#endif
+
+
+
+/****************************************************************/
+/* exported module functions */
+/****************************************************************/
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * PLEASE NOTE: This function is for internal use only! Allocates a
+ * block of heap memory for COS and counts it.
+ *
+ * @param  size            - IN, size of the block in bytes
+ *
+ * @retval pointer to the block, NULL if the heap is exhausted
+ ************************************************************************/
+void *_memAlloc(size_t size)
+{   void *p = malloc(size);
+
+#if COS_MEMORY_STATISTICS
+    if(NULL == p)
+    {   DebugCode(_msg("memAlloc:malloc!\r\n"););
+        stats_g.failed++;
+        stats_g.lastFailedSize = (uint32_t)size;
+        return NULL;
+    }
+    stats_g.allocations++;
+    stats_g.currentBytes += (uint32_t)size;
+    if(stats_g.currentBytes > stats_g.peakBytes)
+    {   stats_g.peakBytes = stats_g.currentBytes;
+    }
+#endif
+    return p;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * PLEASE NOTE: This function is for internal use only! Releases a
+ * block allocated by _memAlloc(). NULL is ignored.
+ *
+ * @param  p               - IN, pointer to the block or NULL
+ * @param  size            - IN, size of the block, as passed to _memAlloc()
+ ************************************************************************/
+void _memFree(void *p, size_t size)
+{
+    if(NULL == p)
+    {   return;
+    }
+    free(p);
+#if COS_MEMORY_STATISTICS
+    stats_g.frees++;
+    stats_g.currentBytes -= (uint32_t)size;
+#else
+    (void)size;
+#endif
+}
+
+
+
+#if COS_MEMORY_STATISTICS
+/*!
+ **********************************************************************
+ * @par Description:
+ * Copies the heap counters of COS.
+ *
+ * @see COS_ResetMemoryPeak(), COS_PrintMemoryStatistics()
+ *
+ * @param  stats           - OUT, copy of the counters
+ *
+ * @retval 0               - no error
+ *
+ * @par Code example:
+ * @verbatim
+void monitorTask(CosTask_t *pt)
+{   static CosMemStats_t m;
+
+    COS_TASK_BEGIN(pt);
+    while(1)
+    {   COS_GetMemoryStatistics(&m);
+        if(m.failed > 0)
+        {   serPuts("heap exhausted!\r\n");
+        }
+        COS_TASK_SLEEP(pt,_milliSecToTicks(1000));
+    }
+    COS_TASK_END(pt);
+}
+  @endverbatim
+ ************************************************************************/
+int8_t COS_GetMemoryStatistics(CosMemStats_t *stats)
+{   *stats = stats_g;
+    return 0;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Sets the peak to the bytes in use right now, e.g. after the start
+ * up of the application, to watch the peak of the running system.
+ ************************************************************************/
+void COS_ResetMemoryPeak(void)
+{   stats_g.peakBytes = stats_g.currentBytes;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Prints the heap counters to the serial interface.
+ ************************************************************************/
+void COS_PrintMemoryStatistics(void)
+{
+#if (COS_PLATFORM == PLATFORM_RENESAS_RX63N) || (COS_PLATFORM == PLATFORM_POSIX)
+    SER_TX_BULK_BEGIN();
+    serPuts("\r\nHeap bytes:"); serOutUint32Dec(stats_g.currentBytes);
+    serPuts(" peak:");          serOutUint32Dec(stats_g.peakBytes);
+    serPuts("\r\nAllocs:");     serOutUint32Dec(stats_g.allocations);
+    serPuts(" frees:");         serOutUint32Dec(stats_g.frees);
+    serPuts(" failed:");        serOutUint32Dec(stats_g.failed);
+    serPuts("\r\n");
+    SER_TX_BULK_END();
+#endif // COS_PLATFORM
+    // not implemented on Arduino and openCM, use CosPrintMemoryStatistics() instead
+}
+#endif
@@ -0,0 +1,103 @@
+/*!
+ ********************************************************************
+   @file            cos_memory.h
+   @par Project   : co-operative scheduler (COS)
+   @par Module    : Heap allocations of COS
+
+   @brief  All modules of COS allocate heap memory by _memAlloc() and
+          release it by _memFree(): task structs, nodes of the task list
+          and of the semaphore waiting lists (one per COS_SEM_WAIT() that
+          blocks), buffers of FIFOs, message queues and stream buffers,
+          and software timers. With COS_MEMORY_STATISTICS set to 1 in
+          cos_configure.h, the layer counts the bytes in use, their peak,
+          the number of allocations and frees and the failed
+          allocations, see COS_GetMemoryStatistics().
+
+          The caller passes the size of the block to _memFree(), so no
+          header per block is needed. Memory allocated by the
+          application itself is not counted.
+
+   @par Author    : Ernst Forgber (Fgb)
+   @par Company   : Hochschule Hannover - University of Applied Sciences and Arts, Germany
+   @par Department: Faculty 1
+ ********************************************************************
+
+   @par History   :
+   @verbatim
+   Version | Date        | Author | Change Description
+   0.0     | 18.10. 2026 | Fgb    | First Version
+   @endverbatim
+
+ ********************************************************************/
+/**************************************************************************
+
+Copyright 2026 Ernst Forgber
+
+
+This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+
+
+#ifndef _cos_memory_h_
+#define _cos_memory_h_
+
+
+#include <stdlib.h>
+#include "cos_configure.h"
+#include "cos_types.h"
+
+
+/*!
+ ********************************************************************
+  @par Description
+  Counters of the heap memory used by COS, see COS_GetMemoryStatistics().
+  allocations - frees is the number of blocks in use. A steady rise of
+  currentBytes in a long run points to a leak, a high rate of
+  allocations to fragmentation pressure on the heap.
+********************************************************************/
+typedef struct                 /*! heap statistics of COS */
+{   uint32_t currentBytes;     /*!< bytes in use */
+    uint32_t peakBytes;        /*!< high-water mark of currentBytes */
+    uint32_t allocations;      /*!< successful allocations */
+    uint32_t frees;            /*!< released blocks */
+    uint32_t failed;           /*!< allocations that returned NULL */
+    uint32_t lastFailedSize;   /*!< size of the last failed allocation */
+} CosMemStats_t;
+
+
+void  *_memAlloc(size_t size);
+void   _memFree(void *p, size_t size);
+
+#if COS_MEMORY_STATISTICS
+int8_t COS_GetMemoryStatistics(CosMemStats_t *stats);
+void   COS_ResetMemoryPeak(void);
+void   COS_PrintMemoryStatistics(void);
+#endif
+
+
+#endif
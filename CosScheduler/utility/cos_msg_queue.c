@@ -0,0 +1,510 @@
+/*!
+ ********************************************************************
+   @file            cos_msg_queue.c
+   @par Project   : co-operative scheduler (COS)
+   @par Module    : Message queue for messages of variable length
+
+   @brief  Message queue for COS.
+
+
+   @par Author    : Ernst Forgber (Fgb)
+   @par Company   : Hochschule Hannover - University of Applied Sciences and Arts, Germany
+   @par Department: Faculty 1
+
+
+   @par Description
+   This module implements a queue for messages of variable length. All
+   messages share a single ring buffer of bytes, each message is
+   preceded by its length:
+
+   @verbatim
+
+                  rIndex                      wIndex
+                    |                           |
+                    v                           v
+   buffer: ... | 2 | O K | 5 | h e l l o | ...  free  ...
+                 len msg   len msg
+   @endverbatim
+
+   A message may wrap around at the end of the buffer. Readers wait at
+   a semaphore counting the messages. Writers wait for free space at a
+   second list of tasks, that is emptied by every read: the writers
+   will then try again, since the space needed depends on the length
+   of their message.
+ ********************************************************************
+
+   @par History   :
+   @verbatim
+   Version | Date        | Author        | Change Description
+   0.0     | 18.10. 2026 | Fgb           | First Version
+   0.1     | 18.10. 2026 | Fgb           | buffer from _memAlloc()
+   0.2     | 18.10. 2026 | Fgb           | writers woken by _setTaskReady()
+   @endverbatim
+
+ ********************************************************************/
+/**************************************************************************
+
+Copyright 2026 Ernst Forgber
+
+
+This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+
+
+#include <stdlib.h>
+#include <string.h>  // for memcpy()
+#include "cos_ser.h"
+#include "cos_msg_queue.h"
+#include "cos_memory.h"
+
+
+
+
+/*------------- DEBUGGING ---------------------------------*/
+#define DEBUG_MODULE 0  /*!< 0 for no additional debug code, 1 otherwise */
+
+#if DEBUG_MODULE
+  #define DebugCode( code_fragment ) { code_fragment } /*!< for debugging only: insert some code */
+#else
+  #define DebugCode( code_fragment ) /*!< for debugging only: insert some code */
+#endif
+
+#if DEBUG_MODULE
+static void _msg(char *msg)
+{
+    DebugCode(serPuts(msg););
+}
+#endif
+/*---------------------------------------------------------------*/
+
+
+
+/****************************************************************/
+/* private functions */
+/****************************************************************/
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Copies n bytes into the ring buffer, starting at index 'start'.
+ * The data may wrap around at the end of the buffer.
+ *
+ * @retval index following the last byte written
+ ************************************************************************/
+static uint16_t _copyToRing(CosMsgQueue_t *q, uint16_t start, const char *data, uint16_t n)
+{ uint16_t first = q->size - start;   /* bytes up to the end of the buffer */
+
+  if(n <= first)
+  { memcpy(&(q->buffer[start]), data, n);
+  }
+  else
+  { memcpy(&(q->buffer[start]), data, first);
+    memcpy(q->buffer, data + first, n - first);  /* wrap around */
+  }
+  start += n;
+  if(start >= q->size) start -= q->size;
+  return start;
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Copies n bytes out of the ring buffer, starting at index 'start'.
+ * If data is NULL, the bytes are skipped.
+ *
+ * @retval index following the last byte read
+ ************************************************************************/
+static uint16_t _copyFromRing(CosMsgQueue_t *q, uint16_t start, char *data, uint16_t n)
+{ uint16_t first = q->size - start;   /* bytes up to the end of the buffer */
+
+  if(data != NULL)
+  { if(n <= first)
+    { memcpy(data, &(q->buffer[start]), n);
+    }
+    else
+    { memcpy(data, &(q->buffer[start]), first);
+      memcpy(data + first, q->buffer, n - first);  /* wrap around */
+    }
+  }
+  start += n;
+  if(start >= q->size) start -= q->size;
+  return start;
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Sets all tasks waiting for free space to state TASK_STATE_READY and
+ * empties the list of waiting writers. Each writer will check again,
+ * if its message fits.
+ ************************************************************************/
+static void _wakeUpWriters(CosMsgQueue_t *q)
+{ CosTask_t *task_pt = NULL;
+
+  while(q->wSema.root_pt != NULL)
+  { task_pt = q->wSema.root_pt->task_pt;
+    _setTaskReady(task_pt);
+    q->wSema.root_pt = _unlinkTaskFromTaskList(q->wSema.root_pt, task_pt);
+  }
+}
+
+
+
+
+/****************************************************************/
+/* exported module functions */
+/****************************************************************/
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * This function creates a message queue with a buffer of 'size' bytes.
+ * Each message uses its length plus one byte of the buffer.
+ *
+ * @see
+ * @arg  COS_MsgQueueDestroy()
+ *
+ *
+ * @param  q               - IN/OUT, pointer to queue struct
+ * @param  size            - IN, size of buffer in bytes (2..65535)
+ *
+ * @retval 0               - no error
+ * @retval negative        - an error occurrred
+ *
+ * @par Code example:
+ * @verbatim
+CosMsgQueue_t cmdQueue;
+
+int main(void)
+{
+  ...
+  if(0!= COS_MsgQueueCreate(&cmdQueue, 128))
+    serPuts("error creating queue");
+  ...
+  COS_MsgQueueDestroy(&cmdQueue);
+  ...
+  return 0;
+}
+  @endverbatim
+ ************************************************************************/
+int8_t COS_MsgQueueCreate(CosMsgQueue_t *q, uint16_t size)
+{
+  if(size < 2)
+  { DebugCode(_msg("MsgQueueCreate:size!"););
+    return -1;
+  }
+  q->buffer = (char *) _memAlloc(size * sizeof(char));
+  if(NULL == q->buffer)
+  { DebugCode(_msg("MsgQueueCreate:malloc!"););
+    return -1;
+  }
+  q->size      = size;
+  q->rIndex    = 0;         /* empty queue */
+  q->wIndex    = 0;
+  q->usedBytes = 0;
+  q->nMessages = 0;
+  COS_SemCreate(&(q->rSema), 0);  // no message to read yet
+  COS_SemCreate(&(q->wSema), 0);  // list of writers waiting for space
+  q->isInitialized = 1;
+  return 0;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * This function deletes a message queue and frees its memory.
+ *
+ * @see
+ * @arg  COS_MsgQueueCreate()
+ *
+ *
+ * @param  q               - IN/OUT, pointer to queue struct
+ *
+ * @retval 0               - no error
+ * @retval negative        - an error occurred
+ ************************************************************************/
+int8_t COS_MsgQueueDestroy(CosMsgQueue_t *q)
+{
+  if(q->isInitialized == 0)
+  { DebugCode(_msg("MsgQueueDestroy:not init."););
+    return -1;
+  }
+  if(q->buffer != NULL)
+  { _memFree(q->buffer, q->size * sizeof(char));
+    q->buffer = NULL;
+  }
+  q->isInitialized = 0;
+  COS_SemDestroy(&(q->rSema));
+  COS_SemDestroy(&(q->wSema));
+  return 0;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * This function checks if a message queue is empty.
+ *
+ * @param  q               - IN/OUT, pointer to queue struct
+ *
+ * @retval 0               - queue not empty
+ * @retval 1               - queue empty
+ * @retval negative        - error
+ ************************************************************************/
+int8_t COS_MsgQueueIsEmpty(CosMsgQueue_t *q)
+{
+  if(q->isInitialized == 0)
+  { DebugCode(_msg("MsgQueueIsEmpty:not init"););
+    return -1;
+  }
+  return (q->nMessages == 0) ? 1 : 0;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * This function returns the number of messages in the queue.
+ *
+ * @param  q               - IN/OUT, pointer to queue struct
+ *
+ * @retval number of messages
+ ************************************************************************/
+uint8_t COS_MsgQueueGetMessageCount(CosMsgQueue_t *q)
+{   return q->nMessages;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * This function returns the number of bytes in use, including one
+ * length byte per message.
+ *
+ * @see COS_MsgQueueGetFreeBytes()
+ *
+ * @param  q               - IN/OUT, pointer to queue struct
+ *
+ * @retval number of used bytes
+ ************************************************************************/
+uint16_t COS_MsgQueueGetUsedBytes(CosMsgQueue_t *q)
+{   return q->usedBytes;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * This function returns the number of free bytes. A message of n bytes
+ * needs n+1 free bytes.
+ *
+ * @see COS_MsgQueueGetUsedBytes()
+ *
+ * @param  q               - IN/OUT, pointer to queue struct
+ *
+ * @retval number of free bytes
+ ************************************************************************/
+uint16_t COS_MsgQueueGetFreeBytes(CosMsgQueue_t *q)
+{   return q->size - q->usedBytes;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * This function returns the length of the oldest message in the queue
+ * without removing it.
+ *
+ * @param  q               - IN/OUT, pointer to queue struct
+ *
+ * @retval length of the next message in bytes
+ * @retval 0               - queue is empty
+ * @retval -1              - error
+ ************************************************************************/
+int16_t COS_MsgQueueGetNextLength(CosMsgQueue_t *q)
+{
+  if(q->isInitialized == 0)
+  { DebugCode(_msg("MsgQueueGetNextLength:not init"););
+    return -1;
+  }
+  if(q->nMessages == 0)
+  { return 0;
+  }
+  return (uint8_t) q->buffer[q->rIndex];
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * This function reads the oldest message without blocking. The read
+ * semaphore is updated as if the task had passed
+ * COS_MsgQueueBlockingRead(). A message longer than 'maxLen' is
+ * truncated.
+ *
+ * @see
+ * @arg  COS_MsgQueueBlockingRead()
+ *
+ * @param  q               - IN/OUT, pointer to queue struct
+ * @param  data            - OUT, pointer to message buffer
+ * @param  maxLen          - IN, size of message buffer
+ *
+ * @retval number of bytes read, 0 if no message is available
+ * @retval -1              - error
+ ************************************************************************/
+int16_t COS_MsgQueueTryRead(CosMsgQueue_t *q, char *data, uint8_t maxLen)
+{
+  if(q->isInitialized == 0)
+  { DebugCode(_msg("MsgQueueTryRead:not init"););
+    return -1;
+  }
+  if(q->rSema.count <= 0)  // empty, or message promised to a woken reader
+  { return 0;
+  }
+  (q->rSema.count)--;      // same as passing COS_SEM_WAIT()
+  return _mqRead(q, data, maxLen);
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * PLEASE NOTE: This function is for internal use only!
+ * The normal application should
+ * use the macro COS_MsgQueueBlockingWrite() instead!
+ * The function writes the length byte and the message to the queue, if
+ * there is enough free space. Otherwise nothing is written.
+ *
+ * @see
+ * @arg  _mqRead(), COS_MsgQueueBlockingWrite()
+ *
+ *
+ * @param  q               - IN/OUT, pointer to queue struct
+ * @param  data            - IN, pointer to message
+ * @param  len             - IN, length of message (1..255)
+ *
+ * @retval 1               - message written
+ * @retval 0               - not enough space, nothing written
+ * @retval -1              - error, message will never fit
+ ************************************************************************/
+int8_t _mqWrite(CosMsgQueue_t *q, const char *data, uint8_t len)
+{ char lenByte = (char) len;
+
+  if(q->isInitialized == 0)
+  { DebugCode(_msg("_mqWrite:not init"););
+    return -1;
+  }
+  if((len == 0) || ((uint16_t) len + 1 > q->size))
+  { DebugCode(_msg("_mqWrite:len!"););
+    return -1;
+  }
+  if(((uint16_t) len + 1 > q->size - q->usedBytes) ||
+     (q->nMessages >= COS_MSGQ_MAX_MESSAGES))
+  { return 0;  /* queue is full, don't write */
+  }
+  q->wIndex = _copyToRing(q, q->wIndex, &lenByte, 1);
+  q->wIndex = _copyToRing(q, q->wIndex, data, len);
+  q->usedBytes += len + 1;
+  q->nMessages++;
+  COS_SEM_SIGNAL(&(q->rSema));  // unblock a task that waits for reading
+  return 1;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * PLEASE NOTE: This function is for internal use only!
+ * The normal application should
+ * use the macro COS_MsgQueueBlockingRead() instead!
+ * The function removes the oldest message from the queue and copies
+ * up to 'maxLen' bytes of it. All tasks waiting for free space are
+ * un-blocked.
+ *
+ * @see
+ * @arg  _mqWrite(), COS_MsgQueueBlockingRead()
+ *
+ *
+ * @param  q               - IN/OUT, pointer to queue struct
+ * @param  data            - OUT, pointer to message buffer
+ * @param  maxLen          - IN, size of message buffer
+ *
+ * @retval number of bytes copied, 0 if the queue is empty
+ * @retval -1              - error
+ ************************************************************************/
+int16_t _mqRead(CosMsgQueue_t *q, char *data, uint8_t maxLen)
+{ char lenByte;
+  uint8_t len, nCopy;
+
+  if(q->isInitialized == 0)
+  { DebugCode(_msg("_mqRead:not init"););
+    return -1;
+  }
+  if(q->nMessages == 0)
+  { return 0;
+  }
+  q->rIndex = _copyFromRing(q, q->rIndex, &lenByte, 1);
+  len = (uint8_t) lenByte;
+  nCopy = (len < maxLen) ? len : maxLen;
+  q->rIndex = _copyFromRing(q, q->rIndex, data, nCopy);
+  q->rIndex = _copyFromRing(q, q->rIndex, NULL, len - nCopy);  /* truncated */
+  q->usedBytes -= len + 1;
+  q->nMessages--;
+  _wakeUpWriters(q);  // space has been freed, writers try again
+  return nCopy;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * PLEASE NOTE: This function is for internal use only! It is called
+ * by COS_MsgQueueBlockingWrite(), if the message doesn't fit. The task
+ * is blocked and added to the list of writers waiting for space.
+ *
+ * @param  q               - IN/OUT, pointer to queue struct
+ * @param  pt              - IN/OUT, pointer to task struct
+ ************************************************************************/
+void _mqWaitForSpace(CosMsgQueue_t *q, CosTask_t *pt)
+{
+  pt->state = TASK_STATE_BLOCKED;
+  q->wSema.root_pt = _addTaskAtBeginningOfTaskList(q->wSema.root_pt, pt);
+}
@@ -0,0 +1,206 @@
+/*!
+ ********************************************************************
+   @file            cos_msg_queue.h
+   @par Project   : co-operative scheduler (COS)
+   @par Module    : Message queue for messages of variable length
+
+   @brief  Message queue for COS. Other than the data-FIFO, messages
+          of different length share one byte buffer. Every message is
+          stored with a length prefix of one byte and uses only as many
+          bytes of the buffer as it actually needs. A message may have
+          1..255 bytes, the buffer may have up to 65535 bytes. The queue
+          uses dynamic memory allocation (malloc()).
+
+   @par Author    : Ernst Forgber (Fgb)
+   @par Company   : Hochschule Hannover - University of Applied Sciences and Arts, Germany
+   @par Department: Faculty 1
+ ********************************************************************
+
+   @par History   :
+   @verbatim
+   Version | Date        | Author | Change Description
+   0.0     | 18.10. 2026 | Fgb    | First Version
+   @endverbatim
+
+ ********************************************************************/
+/**************************************************************************
+
+Copyright 2026 Ernst Forgber
+
+
+This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+
+#ifndef _cos_msg_queue_h_
+#define _cos_msg_queue_h_
+
+
+#include "cos_configure.h"
+#include "cos_semaphore.h"
+#include "cos_types.h"
+
+#ifndef NULL
+    #define NULL 0  /*!< the null pointer value */
+#endif
+
+
+/*! maximum number of messages in a queue, limited by the semaphore counter */
+#define COS_MSGQ_MAX_MESSAGES   127
+
+
+/*!
+ ********************************************************************
+  @par Description
+  Message queue data structure. The buffer is used as ring buffer of
+  bytes. Each message is stored as one length byte followed by the
+  message bytes.
+********************************************************************/
+typedef struct                 /*! message queue data structure */
+{
+        char *buffer;          /*!< ring buffer of bytes */
+        uint16_t size;         /*!< size of buffer in bytes */
+        uint16_t rIndex;       /*!< read index of the next message */
+        uint16_t wIndex;       /*!< write index of the next message */
+        uint16_t usedBytes;    /*!< bytes in use, including length prefixes */
+        uint8_t nMessages;     /*!< number of messages in the queue */
+        uint8_t isInitialized; /*!< 0 if not yet initialized */
+        CosSema_t rSema;       /*!< counts messages, readers wait here */
+        CosSema_t wSema;       /*!< writers wait here for free space */
+} CosMsgQueue_t;
+
+
+
+int8_t   COS_MsgQueueCreate(CosMsgQueue_t *q, uint16_t size);
+int8_t   COS_MsgQueueDestroy(CosMsgQueue_t *q);
+int8_t   COS_MsgQueueIsEmpty(CosMsgQueue_t *q);
+uint8_t  COS_MsgQueueGetMessageCount(CosMsgQueue_t *q);
+uint16_t COS_MsgQueueGetUsedBytes(CosMsgQueue_t *q);
+uint16_t COS_MsgQueueGetFreeBytes(CosMsgQueue_t *q);
+int16_t  COS_MsgQueueGetNextLength(CosMsgQueue_t *q);
+int16_t  COS_MsgQueueTryRead(CosMsgQueue_t *q, char *data, uint8_t maxLen);
+
+int8_t  _mqWrite(CosMsgQueue_t *q, const char *data, uint8_t len);
+int16_t _mqRead(CosMsgQueue_t *q, char *data, uint8_t maxLen);
+void    _mqWaitForSpace(CosMsgQueue_t *q, CosTask_t *pt);
+
+
+// blocking Macros
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * This macro stores a message of 'len' bytes in the queue. If there is
+ * not enough free space in the buffer, the task *pt is changed to state
+ * TASK_STATE_BLOCKED. Every read from the queue un-blocks the waiting
+ * writers, which will try again. A message, that can never fit into
+ * the queue (len==0 or len+1 > size) is not written and the task does
+ * not block.
+ *
+ * @see
+ * @arg  COS_MsgQueueBlockingRead(), _mqWrite()
+ *
+ * @par Macro parameters: (CosTask_t *pt, CosMsgQueue_t *q, char *data, uint8_t len)
+ *
+ * @param  pt              - IN/OUT, pointer to task struct
+ * @param  q               - IN/OUT, pointer to queue struct
+ * @param  data            - IN, pointer to message
+ * @param  len             - IN, length of message in bytes (1..255)
+ * @retval void
+ * @par Example :
+ *    A command queue of 128 bytes carries short acknowledges and long
+ *    configuration messages:
+ * @verbatim
+CosMsgQueue_t cmdQueue;
+
+void Task_A(CosTask_t *pt)
+{   static char ack[2] = {'O','K'};
+    static char config[60];
+
+    COS_TASK_BEGIN(pt);
+    ...
+    COS_MsgQueueBlockingWrite(pt, &cmdQueue, ack, sizeof(ack));
+    COS_MsgQueueBlockingWrite(pt, &cmdQueue, config, sizeof(config));
+    ...
+    COS_TASK_END(pt);
+}
+
+void Task_B(CosTask_t *pt)
+{   static char msg[64];
+    static int16_t len;
+
+    COS_TASK_BEGIN(pt);
+    ...
+    COS_MsgQueueBlockingRead(pt, &cmdQueue, msg, sizeof(msg), len);
+    ...
+    COS_TASK_END(pt);
+}
+
+int main(void)
+{ ...
+  COS_InitTaskList();
+  if(0!= COS_MsgQueueCreate(&cmdQueue, 128))
+    serPuts("error creating queue");
+  ...
+}
+  @endverbatim
+ ************************************************************************/
+#define COS_MsgQueueBlockingWrite(pt, q, data, len) (pt)->lineCnt=__LINE__;\
+                            case __LINE__:\
+                            if(0 == _mqWrite((q), (const char *)(data), (len))) { \
+                              _mqWaitForSpace((q), (pt)); \
+                              return; \
+                            }
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * This macro reads the oldest message from the queue. If the queue is
+ * empty, the task *pt is changed to state TASK_STATE_BLOCKED. Another
+ * task writing to the queue will un-block it again. A message longer
+ * than 'maxLen' is truncated, the rest of it is discarded.
+ *
+ * @see
+ * @arg  COS_MsgQueueBlockingWrite(), _mqRead()
+ *
+ * @par Macro parameters: (CosTask_t *pt, CosMsgQueue_t *q, char *data, uint8_t maxLen, int16_t len)
+ *
+ * @param  pt              - IN/OUT, pointer to task struct
+ * @param  q               - IN/OUT, pointer to queue struct
+ * @param  data            - OUT, pointer to message buffer
+ * @param  maxLen          - IN, size of message buffer in bytes
+ * @param  len             - OUT, variable for the number of bytes read
+ * @retval void
+ * @par Example :
+ *   see COS_MsgQueueBlockingWrite()
+ ************************************************************************/
+#define COS_MsgQueueBlockingRead(pt, q, data, maxLen, len)  COS_SEM_WAIT(&((q)->rSema),(pt)); \
+                                                  (len) = _mqRead((q), (char *)(data), (maxLen))
+
+#endif
@@ -24,6 +24,23 @@
    0.3     | 22.10.2015 | Fgb           | Bugfix: Sleep-Zeit im Scheduler auf 0
                                         | zureuckgesetzt, siehe dort
    0.4     | 19.11.2016 | Fgb           | openCM, english docu 
+   0.5     | 18.10.2026 | Fgb           | CosTicks_t, one scheduler for all platforms
+   0.6     | 18.10.2026 | Fgb           | POSIX host platform
+   0.7     | 18.10.2026 | Fgb           | virtual time, COS_StopScheduler()
+   0.8     | 18.10.2026 | Fgb           | task statistics, _dispatch()
+   0.9     | 18.10.2026 | Fgb           | CPU load measured by _dispatch(),
+                                          no idle- and cpu-load-task
+   0.10    | 18.10.2026 | Fgb           | trace events
+   0.11    | 18.10.2026 | Fgb           | wake-up latency measured by _dispatch()
+   0.12    | 18.10.2026 | Fgb           | task struct freed by _memFree()
+   0.13    | 18.10.2026 | Fgb           | execution budget, watchdog kick
+   0.14    | 18.10.2026 | Fgb           | counters of the scheduler loop
+   0.15    | 18.10.2026 | Fgb           | COS_CreateTaskWithData()
+   0.16    | 18.10.2026 | Fgb           | virtual time goes on with polling tasks
+   0.17    | 18.10.2026 | Fgb           | COS_ResumeTask() uses _setTaskReady()
+   0.18    | 18.10.2026 | Fgb           | budget suspend of a blocked task when it is unblocked
+   0.19    | 18.10.2026 | Fgb           | COS_PrintTaskList() not truncated by a full TX buffer
+   0.20    | 18.10.2026 | Fgb           | cpu load window of 50 ms, if 100 ms exceed 16 bit ticks
    @endverbatim
 
  ********************************************************************/
@@ -45,15 +62,15 @@ This program is free software: you can redistribute it and/or modify
     You should have received a copy of the GNU General Public License
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
-    Dieses Programm ist Freie Software: Sie knnen es unter den Bedingungen
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
     der GNU General Public License, wie von der Free Software Foundation,
     Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
-    verffentlichten Version, weiterverbreiten und/oder modifizieren.
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
 
-    Dieses Programm wird in der Hoffnung, dass es ntzlich sein wird, aber
-    OHNE JEDE GEWHRLEISTUNG, bereitgestellt; sogar ohne die implizite
-    Gewhrleistung der MARKTFHIGKEIT oder EIGNUNG FR EINEN BESTIMMTEN ZWECK.
-    Siehe die GNU General Public License fr weitere Details.
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
 
     Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
     Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.*****************************************************************************/
@@ -122,9 +139,6 @@ Before the task-function is called, the scheduler will set the
 sleep-time (sleepTime_Ticks) of the task to 0. The task-function has to 
 specify its sleep-time each time it is activated, see examples below.
 
-The task-list is never empty, there is at least the idle-task with 
-its callback-function static void idleTask(CosTask_t *task_pt);
-
 All task callback-functions return nothing an have a single parameter 
 CosTask_t*.
 
@@ -132,26 +146,18 @@ The scheduler runs in an endless loop. The task-list will never be
 deleted and there is no end of program.
 
 Before running the scheduler, the function int COS_InitTaskList(void);
-has to be called. It will initialize the task-list and register the 
-idle-task.
+has to be called. It will initialize the empty task-list.
 
 The scheduler may run in one of two modes: priority based of round-robin
 scheduling.
 
 Priority based scheduling requires the task-list to be sorted due to
-priority. In this mode, a coarse estimation of CPU-load may be achieved
-by means of two tasks: The cpu-load-task has maximum priority and will
-reset a counter to 100. The idle-task with lowest priority decrements
-that counter. The task periods have to be adjusted to run the 
-idle-task 100 times, while the cpu-load-task runs once, provided there are
-no other tasks running. The counter value is an estimate of
-cpu-load: With growing cpu-load, the idle-task may be suppressed  and will
-not be able to decrement the counter to 0 any more. At maximum load,
-idle will be totally suppressed by other tasks and the counter value 
-will remain 100, meaning 100% cpu-load. 
-
-In round-robin mode, the cpu-load estimation won't work, but will do no
-harm either.
+priority.
+
+CPU-load is measured in both modes: the scheduler adds up the execution
+times of all task-function calls (busy time). Every 100 ms, the busy
+time is related to the elapsed time. The result and its moving averages
+over about 1 s and 10 s are available by COS_GetCPULoadPerMille().
 
   @verbatim
   list of tasks:
@@ -174,20 +180,37 @@ harm either.
 #include "cos_scheduler.h"
 #include <stdlib.h>
 #include "cos_ser.h"
+#include "cos_memory.h"
 
 
 
 /*! 0 for round-robin tasking, 1 for prio-based scheduler */
 #define PRIO_BASED_SCHEDULING 1
 
-/*! idle task period, don't edit this */
-#define IDLE_TASK_PERIOD_TICKS      _milliSecToTicks(10)
-/*! idle task priority, don't edit this */
-#define IDLE_TASK_PRIO              0   
-/*! cpu load estimation task period, don't edit this */
-#define LOAD_MEASURE_TASK_PERIOD_TICKS (100*IDLE_TASK_PERIOD_TICKS)
-/*! cpu load estimation task priority, don't edit this */
-#define LOAD_MEASURE_TASK_PRIO      255
+/* cpu load measurement window, don't edit this: 100 ms, unless 100 ms
+   do not fit into 16 bit ticks, e.g. ticks of 1 microsecond */
+#if (COS_TICKS_32BIT == 0) && (100000UL / COS_MICROSEC_PER_TICK > 0xFFFFUL)
+  #define LOAD_WINDOW_MS            50
+#else
+  #define LOAD_WINDOW_MS            100
+#endif
+#if (COS_TICKS_32BIT == 0) && (1000UL * LOAD_WINDOW_MS / COS_MICROSEC_PER_TICK > 0xFFFFUL)
+  #error "cpu load window does not fit into 16 bit ticks, set COS_TICKS_32BIT or a longer COS_MICROSEC_PER_TICK"
+#endif
+/*! cpu load measurement window in ticks */
+#define LOAD_WINDOW_TICKS           _milliSecToTicks(LOAD_WINDOW_MS)
+/*! windows per time constant of the 1 s and 10 s averages */
+#define LOAD_WINDOWS_1S             (1000 / LOAD_WINDOW_MS)
+#define LOAD_WINDOWS_10S            (10000 / LOAD_WINDOW_MS)
+/*! fixed point scaling of the cpu load: 1 << LOAD_SHIFT is 100% */
+#define LOAD_SHIFT                  24
+
+#if COS_SCHEDULER_COUNTERS
+  /*! increments a counter of the scheduler loop */
+  #define COUNT(counter)            (counters_g.counter++)
+#else
+  #define COUNT(counter)
+#endif
 
 
 
@@ -235,18 +258,38 @@ static void _toggle_PD(uint8_t bit)
 /* private module variables */
 /****************************************************************/
 static Node_t *root_g=NULL;           /*! root pointer of task-list */
-static uint8_t cpuLoadPerCent_g=100;  /*! for CPU-load estimation */
-static uint8_t cpuLoadCounter_g=100;  /*! for CPU-load estimation  */
+static CosTicks_t loadWindowStart_g=0; /*! start of current load window */
+static uint32_t loadBusy_Ticks_g=0;    /*! busy time in current load window */
+static uint32_t load_g[COS_LOAD_WINDOWS]={0}; /*! cpu load, fixed point */
+static volatile uint8_t stopScheduler_g=0; /*! set by COS_StopScheduler() */
+static CosTask_t *runningTask_g=NULL; /*! task function called by _dispatch() */
+#if COS_TASK_BUDGET
+static CosBudgetHook_t budgetHook_g=NULL;  /*! called on a budget violation */
+static CosBudgetViolation_t lastViolation_g; /*! last budget violation */
+static uint32_t nViolations_g=0;           /*! number of budget violations */
+static void (*watchdogKick_g)(void)=NULL;  /*! kicks a hardware watchdog */
+static CosTicks_t lastKick_g=0;            /*! time of the last kick */
+#endif
+#if COS_SCHEDULER_COUNTERS
+static CosSchedCounters_t counters_g;      /*! counters of the scheduler loop */
+#endif
+#if COS_VIRTUAL_TIME
+static uint16_t pollRuns_g=0;              /*! calls of tasks with sleep time 0 in a row */
+#endif
 /****************************************************************/
 
 /****************************************************************/
 /* private function prototypes */
 /****************************************************************/
 
-static void _idleTask(CosTask_t *pt);
-static void _cpuLoadMeasureTask(CosTask_t *pt);
-static CosTask_t *_idleTask_pt_g = NULL;
-static CosTask_t *_cpuLoadMeasureTask_pt_g = NULL;
+static uint8_t _dispatch(CosTask_t *task_pt, CosTicks_t t_Ticks);
+static void _accountLoad(CosTicks_t t_Ticks);
+static CosTask_t* _createTask(uint8_t prio, void * pData, uint16_t dataSize, void (*func) (CosTask_t *));
+#if COS_TASK_BUDGET
+static void _checkBudget(CosTask_t *task_pt, uint16_t startLine,
+                         CosTicks_t used_Ticks, CosTicks_t end_Ticks);
+static void _kickWatchdog(CosTicks_t t_Ticks);
+#endif
 
 
 /****************************************************************/
@@ -263,57 +306,248 @@ static CosTask_t *_cpuLoadMeasureTask_pt_g = NULL;
 /*!
  ********************************************************************
   @par Description
-       The task-list contains at least the idle-task, wich has lowest
-       priority. The idle-task decrements a counter for cpu-load
-       estimation. Without any additional load, it runs 100 times
-       before the cpu-load-task can reset the counter to 100. 
+       Calls the task function of a task, that is ready to run. Both
+       versions of the scheduler use this function. With
+       COS_TASK_STATISTICS, the execution time of the call is added
+       to the statistics of the task. A task that has run to its
+       end has been deleted by COS_DeleteTask(), its statistics are
+       gone. The execution time always counts as busy time for the
+       cpu load. With COS_TASK_LATENCY, the time the task has waited
+       since it became ready is added to its latency histogram. With
+       COS_TASK_BUDGET, the execution time is checked against the
+       budget of the task and the watchdog is kicked.
+
+  @param  task_pt - IN/OUT, pointer to task
+  @param  t_Ticks - IN, current time, becomes the activation time
+  @retval 1 if the task still exists, 0 if it has deleted itself
+ ********************************************************************/
+static uint8_t _dispatch(CosTask_t *task_pt, CosTicks_t t_Ticks)
+{   CosTicks_t end_Ticks, used_Ticks;
+    uint8_t exists;
+#if COS_TASK_STATISTICS
+    CosTaskStats_t *s;
+#endif
+#if COS_TASK_BUDGET
+    uint16_t startLine = task_pt->lineCnt;  /* resume point of this call */
+#endif
 
-  @see
-  @arg _cpuLoadMeasureTask()
+#if COS_TASK_LATENCY
+    _latencyBeforeCall(task_pt, t_Ticks);  /* needs the times of the last call */
+#endif
+    task_pt->lastActivationTime_Ticks = t_Ticks;
+    task_pt->sleepTime_Ticks = 0;  // Bugfix 22.10.2015: must be specified by task!
+    runningTask_g = task_pt;
+    COUNT(dispatches);
+    COS_TRACE_EVENT(COS_TRACE_DISPATCH_START, task_pt, 0);
+    task_pt->func(task_pt);  /* call task function, must not block! */
+    COS_TRACE_EVENT(COS_TRACE_DISPATCH_END, NULL, 0);  /* task_pt may be gone */
+    end_Ticks = _gettime_Ticks();
+    used_Ticks = (CosTicks_t)(end_Ticks - t_Ticks);
+    loadBusy_Ticks_g += used_Ticks;
+    exists = (NULL != runningTask_g);  /* NULL: task has been deleted */
+#if COS_TASK_LATENCY
+    if(exists)
+    {   _latencyAfterCall(task_pt, end_Ticks);
+    }
+#endif
+#if COS_TASK_STATISTICS
+    if(exists)
+    {   s = &task_pt->stats;
+        s->activations++;
+        s->total_Ticks += used_Ticks;
+        s->last_Ticks = used_Ticks;
+        if(used_Ticks < s->min_Ticks)
+        {   s->min_Ticks = used_Ticks;
+        }
+        if(used_Ticks > s->max_Ticks)
+        {   s->max_Ticks = used_Ticks;
+        }
+    }
+#endif
+#if COS_TASK_BUDGET
+    if(exists && (task_pt->budget_Ticks > 0) && (used_Ticks > task_pt->budget_Ticks))
+    {   _checkBudget(task_pt, startLine, used_Ticks, end_Ticks);
+    }
+    _kickWatchdog(end_Ticks);
+#endif
+    runningTask_g = NULL;
+    _accountLoad(end_Ticks);
+    return exists;
+}
+/*---------------------------------------------------------------*/
+/*!
+ ********************************************************************
+  @par Description
+       Closes the current cpu load window, if it is at least
+       LOAD_WINDOW_TICKS long. The load of the window is the busy time
+       divided by the elapsed time. It is stored as the 100 ms value
+       and updates the moving averages: with 1 s resp. 10 s of windows
+       per time constant (10 and 100 windows of 100 ms, 20 and 200 of
+       50 ms), they follow the load over about 1 s and 10 s.
+       If the scheduler did not look at the time for several windows,
+       all of them get the load of the whole elapsed time.
+
+  @param  t_Ticks - IN, current time
+ ********************************************************************/
+static void _accountLoad(CosTicks_t t_Ticks)
+{   CosTicks_t elapsed_Ticks = (CosTicks_t)(t_Ticks - loadWindowStart_g);
+    uint32_t n, load;
 
-  @param  pt - IN, pointer to task
+    if(elapsed_Ticks < LOAD_WINDOW_TICKS)
+    {   return;
+    }
+    if(loadBusy_Ticks_g > elapsed_Ticks)
+    {   loadBusy_Ticks_g = elapsed_Ticks;  /* rounding of the tick counter */
+    }
+    load = (uint32_t)(((uint64_t)loadBusy_Ticks_g << LOAD_SHIFT) / elapsed_Ticks);
+    load_g[COS_LOAD_100MS] = load;
+    n = elapsed_Ticks / LOAD_WINDOW_TICKS;
+    if(n > 1000)
+    {   n = 1000;  /* long pause, older load has no influence any more */
+    }
+    for(; n > 0; n--)
+    {   load_g[COS_LOAD_1S]  += ((int32_t)(load - load_g[COS_LOAD_1S]))  / LOAD_WINDOWS_1S;
+        load_g[COS_LOAD_10S] += ((int32_t)(load - load_g[COS_LOAD_10S])) / LOAD_WINDOWS_10S;
+    }
+    loadWindowStart_g = t_Ticks;
+    loadBusy_Ticks_g = 0;
+}
+/*---------------------------------------------------------------*/
+#if COS_VIRTUAL_TIME
+/*!
+ ********************************************************************
+  @par Description
+       Virtual time only: no task was ready to run at time t_Ticks.
+       The virtual clock jumps to the earliest activation time of all
+       tasks in state TASK_STATE_READY.
+       With 'skipDue' set, tasks that are due already are ignored: the
+       clock jumps to the next activation of a sleeping task, or one
+       tick ahead if there is none. See _virtualPoll().
+
+  @param  t_Ticks - IN, current virtual time
+  @param  skipDue - IN, 1: ignore tasks that may run at t_Ticks
+  @retval 0 for ok, negative if no task will ever be ready
+ ********************************************************************/
+static int8_t _advanceVirtualTime(CosTicks_t t_Ticks, uint8_t skipDue)
+{   Node_t *pt=NULL;
+    CosTicks_t elapsed, wait, minWait=0;
+    uint8_t found=0;
+
+    pollRuns_g = 0;
+    for(pt=root_g; NULL!=pt; pt=pt->next_pt)
+    {   if(pt->task_pt->state != TASK_STATE_READY)
+        {   continue;
+        }
+        elapsed = (CosTicks_t)(t_Ticks - pt->task_pt->lastActivationTime_Ticks);
+        wait = (elapsed >= pt->task_pt->sleepTime_Ticks) ? 0 :
+               (CosTicks_t)(pt->task_pt->sleepTime_Ticks - elapsed);
+        if(skipDue && (0 == wait))
+        {   continue;
+        }
+        if((!found) || (wait < minWait))
+        {   minWait = wait;
+            found = 1;
+        }
+    }
+    if(!found)
+    {   if(skipDue)
+        {   minWait = 1;  /* only polling tasks: let time pass anyway */
+        }
+        else
+        {   DebugCode(_msg("virtual time: no task ready\r\n"););
+            return -1;  /* nothing can wake up a task */
+        }
+    }
+    _setVirtualTime_Ticks(t_Ticks + minWait);
+    return 0;
+}
+/*---------------------------------------------------------------*/
+/*!
+ ********************************************************************
+  @par Description
+       Virtual time only: called before a task function. A task with
+       sleep time 0 (COS_TASK_SCHEDULE(), a polling task) is always
+       ready, so the scheduler never finds the list idle and the clock
+       would stand still: every sleeping task would starve. After
+       COS_VIRTUAL_POLL_RUNS calls of such tasks in a row, the clock
+       jumps to the next activation of a sleeping task.
+
+  @param  task_pt - IN, task to be called
+  @param  t_Ticks - IN, current virtual time
  ********************************************************************/
-static void _idleTask(CosTask_t *pt)
+static void _virtualPoll(CosTask_t *task_pt, CosTicks_t t_Ticks)
 {
-    COS_TASK_BEGIN(pt);
-    while(1)
-    {     if(cpuLoadCounter_g > 0)
-          {   cpuLoadCounter_g--;
-          }
-          //DebugCode(_toggle_PD(5););
-          COS_TASK_SLEEP(pt,IDLE_TASK_PERIOD_TICKS);
+    if(task_pt->sleepTime_Ticks > 0)
+    {   pollRuns_g = 0;  /* time driven work: the clock is not stuck */
+    }
+    else if(++pollRuns_g >= COS_VIRTUAL_POLL_RUNS)
+    {   (void) _advanceVirtualTime(t_Ticks, 1);
     }
-    COS_TASK_END(pt);
 }
+#endif
 /*---------------------------------------------------------------*/
+#if COS_TASK_BUDGET
 /*!
  ********************************************************************
   @par Description
-       This task is optional. It has the maximum priority and resets 
-       a counter to 100. The counter is decremented by the idle-task.
-       If cpu-load is low, idle may be able to decrement the counter
-       to 0. If cpu-load is 100%, idle will not be activated any
-       more, since the are always tasks with higher priority ready to
-       run. Therefore the counter value will remain 100, indicating 
-       100% cpu-load.
-
-  @see  _idleTask(), COS_GetCPULoadInPercent()
-  @arg
-
-  @param  keine
+       A call of a task function has taken longer than the budget of
+       the task: the violation is counted and stored, the budget hook
+       is called and, with COS_BUDGET_SUSPEND, the task is suspended.
+       A task, that has blocked in this call, is still in the wait list
+       of a semaphore; it is suspended when it is unblocked, see
+       _setTaskReady(). A task suspended by itself or by the hook stays
+       as it is.
+
+  @param  task_pt    - IN/OUT, offending task
+  @param  startLine  - IN, lineCnt at the start of the call
+  @param  used_Ticks - IN, duration of the call
+  @param  end_Ticks  - IN, end of the call
+ ********************************************************************/
+static void _checkBudget(CosTask_t *task_pt, uint16_t startLine,
+                         CosTicks_t used_Ticks, CosTicks_t end_Ticks)
+{
+    task_pt->budgetOverruns++;
+    nViolations_g++;
+    lastViolation_g.task_pt      = task_pt;
+    lastViolation_g.startLine    = startLine;
+    lastViolation_g.endLine      = task_pt->lineCnt;
+    lastViolation_g.used_Ticks   = used_Ticks;
+    lastViolation_g.budget_Ticks = task_pt->budget_Ticks;
+    lastViolation_g.time_Ticks   = end_Ticks;
+    COS_TRACE_EVENT(COS_TRACE_BUDGET, task_pt, 0);
+    if(NULL != budgetHook_g)
+    {   budgetHook_g(&lastViolation_g);
+    }
+    if(COS_BUDGET_SUSPEND == task_pt->budgetAction)
+    {   if(TASK_STATE_READY == task_pt->state)
+        {   task_pt->state = TASK_STATE_SUSPENDED;
+        }
+        else if(TASK_STATE_BLOCKED == task_pt->state)
+        {   task_pt->budgetSuspend = 1;  /* applied by _setTaskReady() */
+        }
+    }
+}
+/*---------------------------------------------------------------*/
+/*!
+ ********************************************************************
+  @par Description
+       Calls the watchdog kick function, at most once per millisecond.
+       The scheduler calls this function whenever it has control, i.e.
+       after every task function call and at the end of each scan of
+       the task-list. A task function that never returns stops the
+       kicks, so the hardware watchdog resets the controller.
 
-  @retval keine
+  @param  t_Ticks - IN, current time
  ********************************************************************/
-static void _cpuLoadMeasureTask(CosTask_t *pt)
+static void _kickWatchdog(CosTicks_t t_Ticks)
 {
-    COS_TASK_BEGIN(pt);
-    while(1)
-    {     cpuLoadPerCent_g = cpuLoadCounter_g;  // remains constant for the period
-          cpuLoadCounter_g = 100;
-          COS_TASK_SLEEP(pt,LOAD_MEASURE_TASK_PERIOD_TICKS);
+    if((NULL != watchdogKick_g) &&
+       ((CosTicks_t)(t_Ticks - lastKick_g) >= _milliSecToTicks(1)))
+    {   lastKick_g = t_Ticks;
+        watchdogKick_g();
     }
-    COS_TASK_END(pt);
 }
+#endif
 /*---------------------------------------------------------------*/
 
 
@@ -329,7 +563,7 @@ static void _cpuLoadMeasureTask(CosTask_t *pt)
  ********************************************************************
   @par Description
        Initializes the task-list. Tasks are organized in a linear list,
-       containing at least the idle-task. The list is sorted due to
+       that is empty at first. The list is sorted due to
        task priority. The task with highest priority is first in the 
        list.
 
@@ -356,16 +590,6 @@ int8_t COS_InitTaskList(void)
 {
     //DebugCode(_msg("InitTaskList\r\n"););
     root_g = NULL;  /* empty task list */
-    /* task functions are kept in a linear list, that always has at least
-       one element: the idle task.
-    */
-
-    _idleTask_pt_g = COS_CreateTask(IDLE_TASK_PRIO, NULL, _idleTask);
-
-    /* add optional cpu load estimation task to list */
-    _cpuLoadMeasureTask_pt_g = COS_CreateTask(LOAD_MEASURE_TASK_PRIO, NULL, _cpuLoadMeasureTask);
-
-    _sortLinearListPrio(root_g);
     return 0;
 }
 
@@ -442,13 +666,80 @@ int main(void)
   @endverbatim
  ********************************************************************/
 CosTask_t* COS_CreateTask(uint8_t prio, void * pData, void (*func) (CosTask_t *))
+{
+    return _createTask(prio, pData, 0, func);
+}
+/*---------------------------------------------------------------*/
+
+
+
+/*!
+ ********************************************************************
+  @par Description
+       Creates a task like COS_CreateTask(), with a user data struct of
+       'dataSize' bytes in the same memory block as the task struct.
+       pData of the task points to the struct, which is cleared to 0.
+       Every task gets its own struct, so one task function may run as
+       several tasks without static variables. The struct is released
+       with the task by COS_DeleteTask() or COS_TASK_END(), one
+       allocation less than with a separate struct.
+       The struct is aligned to COS_TASK_DATA_ALIGN bytes.
+
+  @see
+  @arg COS_CreateTask(), CosCreateTask<Ctx>() in CosTaskContext.h
+
+  @param  prio     - IN, task priority. 1 is minimum, 254 ist maximum,
+                      0 and 255 reserved
+  @param  dataSize - IN, size of the user data struct in bytes
+  @param  func       IN, name of task-function
+
+  @retval pointer to task struct or NULL on error
+
+  @par Code example:
+  @verbatim
+typedef struct
+{   uint8_t  pin;
+    uint16_t period_ms;
+} Blink_t;
+
+void blinkTask(CosTask_t *pt)
+{   Blink_t *b = (Blink_t *) pt->pData;
+
+    COS_TASK_BEGIN(pt);
+    while(1)
+    {   toggle(b->pin);
+        COS_TASK_SLEEP(pt, _milliSecToTicks(b->period_ms));
+    }
+    COS_TASK_END(pt);
+}
+
+    pt = COS_CreateTaskWithData(2, sizeof(Blink_t), blinkTask);
+    ((Blink_t *) pt->pData)->pin = 6;
+    ((Blink_t *) pt->pData)->period_ms = 500;
+  @endverbatim
+ ********************************************************************/
+CosTask_t* COS_CreateTaskWithData(uint8_t prio, uint16_t dataSize, void (*func) (CosTask_t *))
+{
+    return _createTask(prio, NULL, dataSize, func);
+}
+/*---------------------------------------------------------------*/
+
+
+
+/*!
+ ********************************************************************
+  @par Description
+       PLEASE NOTE: This function is for internal use only! Allocates
+       a task and adds it to the task list.
+ ********************************************************************/
+static CosTask_t* _createTask(uint8_t prio, void * pData, uint16_t dataSize, void (*func) (CosTask_t *))
 {
     CosTask_t *t_pt= NULL;
 
     //DebugCode(_msg("CreateTask\r\n"););
 
     /* allocate and init task struct */
-    t_pt = _newTask(prio, pData, func);
+    t_pt = _newTask(prio, pData, dataSize, func);
     if(t_pt==NULL)
     {   DebugCode(_msg("CreateTask:_newTask!\r\n"););
         return NULL;
@@ -456,6 +747,7 @@ CosTask_t* COS_CreateTask(uint8_t prio, void * pData, void (*func) (CosTask_t *)
 
     root_g = _addTaskAtBeginningOfTaskList(root_g, t_pt);
     _sortLinearListPrio(root_g);
+    COS_TRACE_EVENT(COS_TRACE_TASK_CREATE, t_pt, prio);
 
     return t_pt;  /* pointer to task struct */
 }
@@ -470,8 +762,7 @@ CosTask_t* COS_CreateTask(uint8_t prio, void * pData, void (*func) (CosTask_t *)
  ********************************************************************
   @par Description
        Deletes a task from the task-list and frees corresponding 
-       memory. The task-list stores at least one task, the idle-task
-       must not be deleted.
+       memory.
 
   @see 
   @arg COS_CreateTask()
@@ -484,10 +775,14 @@ int8_t COS_DeleteTask(CosTask_t* task_pt)
 {
     /* remove from list, i.e. free the corresponding node,
        task struct will not be freed here */
+    COS_TRACE_EVENT(COS_TRACE_TASK_DELETE, task_pt, 0);
     root_g = _unlinkTaskFromTaskList(root_g, task_pt);
+    if(runningTask_g == task_pt)
+    {   runningTask_g = NULL;  /* task has deleted itself, e.g. by COS_TASK_END() */
+    }
 
-    /* free memory of task struct */
-    free(task_pt);
+    /* free memory of task struct and user data behind it */
+    _memFree(task_pt, _TASK_BLOCK_SIZE(task_pt->dataSize));
     return 0;
 }
 
@@ -547,7 +842,10 @@ int8_t COS_ResumeTask(CosTask_t* task_pt)
     {   DebugCode(_msg("Resume:task not found\r\n"););
         return -1;
     }
-    pt->task_pt->state = TASK_STATE_READY;
+#if COS_TASK_BUDGET
+    pt->task_pt->budgetSuspend = 0;  /* resumed on purpose */
+#endif
+    _setTaskReady(pt->task_pt);
     return 0;
 }
 /*---------------------------------------------------------------*/
@@ -574,6 +872,7 @@ int8_t COS_SetTaskPrio(CosTask_t* task_pt,uint8_t taskPrio)
     }
     pt->task_pt->prio = taskPrio;
     _sortLinearListPrio(root_g);
+    COS_TRACE_EVENT(COS_TRACE_PRIO_CHANGE, task_pt, taskPrio);
     return 0;
 }
 /*---------------------------------------------------------------*/
@@ -603,10 +902,15 @@ int8_t COS_SetTaskPrio(CosTask_t* task_pt,uint8_t taskPrio)
        due to priority, the scheduler will run the first task in the 
        list, whos state is TASK_STATE_READY and with: 
        timeNow-timeLastActivation > sleepTime_Ticks.
-       The scheduler runs in an endless loop.
+       The scheduler runs in an endless loop, until COS_StopScheduler()
+       is called.
+       With COS_VIRTUAL_TIME, the virtual clock jumps to the next
+       activation time, whenever no task is ready to run, or after
+       COS_VIRTUAL_POLL_RUNS calls of tasks with sleep time 0.
 
 
-  @retval 0 for ok, negative on error (although it should never return...)
+  @retval 0 after COS_StopScheduler(), negative on error (e.g. virtual
+          time, but no task will ever be ready)
   @par Code example
 
   @verbatim
@@ -627,42 +931,53 @@ int main(void)
  ********************************************************************/
 int8_t COS_RunScheduler(void)
 {
-
-#if COS_PLATFORM == PLATFORM_RENESAS_RX63N
-
     Node_t *pt=NULL;
-    uint16_t t_Ticks;
+    CosTicks_t t_Ticks;
 
     //DebugCode(_msg("RunScheduler,prio based\r\n"););
 
+    stopScheduler_g = 0;
+    loadWindowStart_g = _gettime_Ticks();
+    loadBusy_Ticks_g = 0;
     pt = root_g; /* first task, highest prio */
-    while(1) /* loop forever */
-    {   /* time to run? */
-        t_Ticks = _gettime_Ticks();
+    while(!stopScheduler_g) /* loop until COS_StopScheduler() */
+    {   t_Ticks = _gettime_Ticks();
+        COUNT(loops);
+        if(NULL==pt)  /* whole list checked (or empty), no task ready */
+        {   pt = root_g;  /* treat linear list as ring list */
+            COUNT(idleScans);  /* a dispatch restarts the scan at root_g */
+            _accountLoad(t_Ticks);
+            #if COS_TASK_BUDGET
+              _kickWatchdog(t_Ticks);
+            #endif
+            #if COS_VIRTUAL_TIME
+              /* jump ahead to the next activation */
+              if(0 != _advanceVirtualTime(t_Ticks, 0))
+              {   return -1;
+              }
+            #endif
+            continue;
+        }
+        COUNT(checks);
+        /* time to run? */
         /* time wrap around is ok, time difference will be right... */
-        if(((uint16_t)(t_Ticks - pt->task_pt->lastActivationTime_Ticks) >=
+        if(((CosTicks_t)(t_Ticks - pt->task_pt->lastActivationTime_Ticks) >=
              pt->task_pt->sleepTime_Ticks)&&
             (pt->task_pt->state == TASK_STATE_READY))
-        {  pt->task_pt->lastActivationTime_Ticks = t_Ticks;
-           /*  when the task function runs to its very end, the task will be deleted:
+        {  /*  when the task function runs to its very end, the task will be deleted:
                it will be removed from the list, and the task struct will be freed,
                i.e. pt->task_pt is no longer valid.
            */
-           pt->task_pt->sleepTime_Ticks = 0;  // Bugfix 22.10.2015: must be specified by task!
-           pt->task_pt->func(pt->task_pt);  /* call task function, must not block! */
+           #if COS_VIRTUAL_TIME
+             _virtualPoll(pt->task_pt, t_Ticks);
+           #endif
+           _dispatch(pt->task_pt, t_Ticks);  /* call task function, must not block! */
            pt = root_g; /* next: check task with highest prio */
         }
         else
         {  pt = pt->next_pt;  /* check next task in list */
-           if(NULL==pt)
-           {  pt = root_g;  /* treat linear list as ring list */
-           }
         }
     }
-#endif // COS_PLATFORM
-
-    // not implemented on Arduino and openCM, use CosRunScheduler() instead
-
     return 0;
 
 }
@@ -675,10 +990,15 @@ int8_t COS_RunScheduler(void)
        One after another, every task is scheduled, that is in state 
        TASK_STATE_READY and has: 
        timeNow-timeLastActivation > sleepTime_Ticks.
-       The scheduler runs in an endless loop.
+       The scheduler runs in an endless loop, until COS_StopScheduler()
+       is called.
+       With COS_VIRTUAL_TIME, the virtual clock jumps to the next
+       activation time, whenever no task is ready to run, or after
+       COS_VIRTUAL_POLL_RUNS calls of tasks with sleep time 0.
 
 
-  @retval 0 for ok, negative on error (although it should never return...)
+  @retval 0 after COS_StopScheduler(), negative on error (e.g. virtual
+          time, but no task will ever be ready)
   @par Code eample:
 
   @verbatim
@@ -699,41 +1019,70 @@ int main(void)
  ********************************************************************/
 int8_t COS_RunScheduler(void)
 {
-
-#if COS_PLATFORM == PLATFORM_RENESAS_RX63N
-
     Node_t *pt=NULL;
-    uint16_t t_Ticks;
+    CosTicks_t t_Ticks;
+#if COS_VIRTUAL_TIME || COS_SCHEDULER_COUNTERS
+    uint8_t idleScan=1;  /* no task has run in this round */
+#endif
 
     //DebugCode(_msg("RunScheduler, round robin\r\n"););
 
+
+    stopScheduler_g = 0;
+    loadWindowStart_g = _gettime_Ticks();
+    loadBusy_Ticks_g = 0;
     pt = root_g; /* first task */
-    while(1) /* run forever */
-    {   /* time to run? */
-        #if COS_PLATFORM == PLATFORM_RENESAS_RX63N
-            t_Ticks = _gettime_Ticks();
-        #endif // COS_PLATFORM
-        #if COS_PLATFORM == PLATFORM_OPEN_CM_9_04
-            t_Ticks = millis();
-        #endif // COS_PLATFORM
-        if(((uint16_t)(t_Ticks - pt->task_pt->lastActivationTime_Ticks) >=
+    while(!stopScheduler_g) /* run until COS_StopScheduler() */
+    {   t_Ticks = _gettime_Ticks();
+        COUNT(loops);
+        if(NULL==pt)  /* end of list (or empty list) */
+        {   pt = root_g;  /* use task list as ring list */
+            _accountLoad(t_Ticks);
+            #if COS_TASK_BUDGET
+              _kickWatchdog(t_Ticks);
+            #endif
+            #if COS_SCHEDULER_COUNTERS
+              if(idleScan)
+              {   COUNT(idleScans);
+              }
+            #endif
+            #if COS_VIRTUAL_TIME
+              /* a whole round without any task ready: jump ahead */
+              if(idleScan && (0 != _advanceVirtualTime(t_Ticks, 0)))
+              {   return -1;
+              }
+            #endif
+            #if COS_VIRTUAL_TIME || COS_SCHEDULER_COUNTERS
+              idleScan = 1;
+            #endif
+            continue;
+        }
+        COUNT(checks);
+        /* time to run? */
+        if(((CosTicks_t)(t_Ticks - pt->task_pt->lastActivationTime_Ticks) >=
              pt->task_pt->sleepTime_Ticks)&&
             (pt->task_pt->state == TASK_STATE_READY))
-        {  pt->task_pt->lastActivationTime_Ticks = t_Ticks;
-           /*  when the task function runs to its very end, the task will be deleted:
+        {  /*  when the task function runs to its very end, the task will be deleted:
                it will be removed from the list, and the task struct will be freed,
                i.e. pt->task_pt is no longer valid.
            */
-           pt->task_pt->sleepTime_Ticks = 0;  // Bugfix 22.10.2015: must be specified by task!
-           pt->task_pt->func(pt->task_pt);  /* call task function, must not block! */
+           #if COS_VIRTUAL_TIME
+             _virtualPoll(pt->task_pt, t_Ticks);
+           #endif
+           if(_dispatch(pt->task_pt, t_Ticks))  /* call task function, must not block! */
+           {   pt = pt->next_pt;  /* next task in list */
+           }
+           else
+           {   pt = NULL;  /* node has been freed: start a new round */
+           }
+           #if COS_VIRTUAL_TIME || COS_SCHEDULER_COUNTERS
+             idleScan = 0;
+           #endif
         }
-        pt = pt->next_pt;  /* next task in list */
-        if(NULL==pt)
-        {   pt = root_g;  /* use task list as ring list */
+        else
+        {   pt = pt->next_pt;  /* next task in list */
         }
     }
-#endif // COS_PLATFORM
-
     return 0;
 }
 #endif
@@ -741,6 +1090,37 @@ int8_t COS_RunScheduler(void)
 
 
 
+/*!
+ ********************************************************************
+  @par Description
+       Makes COS_RunScheduler() return after the current task function
+       has returned. May be called by a task, e.g. to end a simulation
+       with virtual time after a given time.
+
+  @see COS_RunScheduler()
+
+  @par Code example
+  @verbatim
+void endOfSimulation(void *arg)
+{   COS_StopScheduler();
+}
+
+int main(void)
+{   ...
+    COS_TimerCreate(_milliSecToTicks(600000UL), 1, endOfSimulation, NULL);
+    COS_RunScheduler();  // returns after ten minutes of virtual time
+    ...
+}
+  @endverbatim
+ ********************************************************************/
+void COS_StopScheduler(void)
+{
+    stopScheduler_g = 1;
+}
+/*---------------------------------------------------------------*/
+
+
+
 /*!
  ********************************************************************
   @par Description
@@ -749,15 +1129,30 @@ int8_t COS_RunScheduler(void)
  ********************************************************************/
 void COS_PrintTaskList(void)
 {
-#if COS_PLATFORM == PLATFORM_RENESAS_RX63N
+#if (COS_PLATFORM == PLATFORM_RENESAS_RX63N) || (COS_PLATFORM == PLATFORM_POSIX)
     Node_t *pt=root_g;
 
+    SER_TX_BULK_BEGIN();
     while(NULL != pt)
-    {   serPuts("\r\ntask:");  serOutUint32Hex((uint32_t) pt->task_pt);
+    {   serPuts("\r\ntask:");  serOutUint32Hex((uint32_t)(size_t) pt->task_pt);
         serPuts("\r\nState:"); serOutUint8Hex(pt->task_pt->state);
         serPuts("\r\nPrio:");  serOutUint8Hex(pt->task_pt->prio);
+#if COS_TASK_STATISTICS
+        serPuts("\r\nRuns:");  serOutUint32Dec(pt->task_pt->stats.activations);
+        serPuts("\r\nAvg:");   serOutUint32Dec(COS_TaskStatsAverage_Ticks(&pt->task_pt->stats));
+        serPuts("\r\nMax:");   serOutUint32Dec(pt->task_pt->stats.max_Ticks);
+#endif
+#if COS_TASK_LATENCY
+        serPuts("\r\nLat p50:"); serOutUint32Dec(COS_TaskLatencyPercentile_Ticks(&pt->task_pt->latency, 500));
+        serPuts(" p99:");         serOutUint32Dec(COS_TaskLatencyPercentile_Ticks(&pt->task_pt->latency, 990));
+        serPuts(" max:");         serOutUint32Dec(pt->task_pt->latency.max_Ticks);
+#endif
+#if COS_TASK_BUDGET
+        serPuts("\r\nOverruns:"); serOutUint16Dec(pt->task_pt->budgetOverruns);
+#endif
         pt = pt->next_pt;
     }
+    SER_TX_BULK_END();
     return;
 #endif // COS_PLATFORM
     // not implemented on Arduino and openCM, use CosPrintTaskList() instead
@@ -766,21 +1161,387 @@ void COS_PrintTaskList(void)
 /*!
  ********************************************************************
   @par Description
-       A simple cpu-load estimation uses two tasks, that are created
-       by COS_InitTaskList(). The task _cpuLoadMeasureTask()
-       has maximum priority and sets a counter to 100. The counter is
-       decremented by the idle-task. The counter value may indicate 
-       the cpu-load. 
-       
+       CPU-load averaged over about one second, see
+       COS_GetCPULoadPerMille().
+
   @retval cpu-load in percent
  ********************************************************************/
 int8_t COS_GetCPULoadInPercent(void)
-{   return cpuLoadPerCent_g;
+{   return (int8_t)((COS_GetCPULoadPerMille(COS_LOAD_1S) + 5) / 10);
 }
 /*---------------------------------------------------------------*/
 
 
 
+/*!
+ ********************************************************************
+  @par Description
+       Returns the cpu-load, i.e. the share of time spent in task
+       functions. The scheduler measures the execution time of every
+       task-function call, the rest of the time is idle time (checking
+       the task-list, waiting for the next activation). This works for
+       priority based and round-robin scheduling. Interrupts count as
+       busy time, if they occur during a task-function call.
+
+       Every 100 ms, the busy time is related to the elapsed time.
+       The 1 s and 10 s values are exponential moving averages of the
+       100 ms values. All values are updated by the scheduler, they
+       are 0 before COS_RunScheduler() has run for 100 ms. With 16 bit
+       ticks too short for 100 ms, e.g. of 1 microsecond, the window is
+       50 ms, COS_LOAD_100MS gives the load of the last 50 ms.
+
+  @param  window - IN, COS_LOAD_100MS, COS_LOAD_1S or COS_LOAD_10S
+
+  @retval cpu-load in 1/1000, 0 for an invalid window
+
+  @par Code example
+  @verbatim
+void monitorTask(CosTask_t *pt)
+{   COS_TASK_BEGIN(pt);
+    while(1)
+    {   serPuts("load 1s [1/1000]:");
+        serOutUint16Dec(COS_GetCPULoadPerMille(COS_LOAD_1S));
+        COS_TASK_SLEEP(pt,_milliSecToTicks(1000));
+    }
+    COS_TASK_END(pt);
+}
+  @endverbatim
+ ********************************************************************/
+uint16_t COS_GetCPULoadPerMille(uint8_t window)
+{
+    if(window >= COS_LOAD_WINDOWS)
+    {   return 0;
+    }
+    return (uint16_t)(((uint64_t)load_g[window] * 1000UL
+                       + (1UL << (LOAD_SHIFT - 1))) >> LOAD_SHIFT);
+}
+/*---------------------------------------------------------------*/
+
+
+
+#if COS_TASK_STATISTICS
+/*!
+ ********************************************************************
+  @par Description
+       Copies the execution statistics of a task. The scheduler
+       measures every call of the task function with _gettime_Ticks(),
+       i.e. with a resolution of COS_MICROSEC_PER_TICK. The time
+       includes interrupts that occur during the call.
+
+  @see COS_ResetTaskStatistics(), COS_TaskStatsAverage_Ticks()
+
+  @param  task_pt - IN, pointer to task
+  @param  stats   - OUT, copy of the statistics
+
+  @retval 0 for ok, negative if the task is not in the task-list
+
+  @par Code example
+  @verbatim
+void monitorTask(CosTask_t *pt)
+{   static CosTaskStats_t s;
+
+    COS_TASK_BEGIN(pt);
+    while(1)
+    {   COS_GetTaskStatistics(controlTask_pt, &s);
+        serPuts("max:"); serOutUint32Dec(s.max_Ticks);
+        serPuts(" avg:"); serOutUint32Dec(COS_TaskStatsAverage_Ticks(&s));
+        COS_TASK_SLEEP(pt,_milliSecToTicks(1000));
+    }
+    COS_TASK_END(pt);
+}
+  @endverbatim
+ ********************************************************************/
+int8_t COS_GetTaskStatistics(CosTask_t *task_pt, CosTaskStats_t *stats)
+{
+    if(NULL == _searchTaskInList(root_g, task_pt))
+    {   DebugCode(_msg("GetTaskStatistics:task not found\r\n"););
+        return -1;
+    }
+    *stats = task_pt->stats;
+    return 0;
+}
+/*---------------------------------------------------------------*/
+
+
+
+/*!
+ ********************************************************************
+  @par Description
+       Clears the execution statistics of a task or, with task_pt ==
+       NULL, of all tasks.
+
+  @param  task_pt - IN, pointer to task, NULL for all tasks
+
+  @retval 0 for ok, negative if the task is not in the task-list
+ ********************************************************************/
+int8_t COS_ResetTaskStatistics(CosTask_t *task_pt)
+{
+    Node_t *pt=NULL;
+
+    if(NULL != task_pt)
+    {   pt = _searchTaskInList(root_g, task_pt);
+        if(NULL == pt)
+        {   DebugCode(_msg("ResetTaskStatistics:task not found\r\n"););
+            return -1;
+        }
+        _resetTaskStats(&pt->task_pt->stats);
+        return 0;
+    }
+    for(pt=root_g; NULL!=pt; pt=pt->next_pt)
+    {   _resetTaskStats(&pt->task_pt->stats);
+    }
+    return 0;
+}
+/*---------------------------------------------------------------*/
+
+
+
+/*!
+ ********************************************************************
+  @par Description
+       Average execution time of a task function.
+
+  @param  stats - IN, statistics of a task
+
+  @retval average execution time in ticks, 0 if the task has not run
+ ********************************************************************/
+CosTicks_t COS_TaskStatsAverage_Ticks(const CosTaskStats_t *stats)
+{
+    if(0 == stats->activations)
+    {   return 0;
+    }
+    return (CosTicks_t)(stats->total_Ticks / stats->activations);
+}
+/*---------------------------------------------------------------*/
+#endif
+
+
+
+#if COS_TASK_BUDGET
+/*!
+ ********************************************************************
+  @par Description
+       Sets the execution budget of a task: the longest time a single
+       call of its task function may take, i.e. the longest time
+       between two scheduling macros. A co-operative task that does
+       not yield in time delays all other tasks. The scheduler measures
+       every call; a longer call is a budget violation: it is counted
+       in the task struct (budgetOverruns), stored for
+       COS_GetBudgetViolations(), the hook set by COS_SetBudgetHook()
+       is called, and with action COS_BUDGET_SUSPEND the task is
+       suspended, a blocked task when it is unblocked. The scheduler cannot interrupt a task function, so a
+       task that never returns is only caught by a hardware watchdog,
+       see COS_SetWatchdogKick().
+
+  @param  task_pt      - IN/OUT, pointer to task
+  @param  budget_Ticks - IN, longest call allowed, 0 for no limit
+  @param  action       - IN, COS_BUDGET_REPORT or COS_BUDGET_SUSPEND
+
+  @retval 0 for ok, negative if the task is not in the task-list or the
+          action is unknown
+
+  @par Code example
+  @verbatim
+void budgetHook(const CosBudgetViolation_t *v)
+{   serPuts("budget: task"); serOutUint32Hex((uint32_t)(size_t)v->task_pt);
+    serPuts(" line"); serOutUint16Dec(v->startLine);
+    serPuts(" used"); serOutUint32Dec(v->used_Ticks);
+    serPuts("\r\n");
+}
+
+int main(void)
+{   ...
+    controlTask_pt = COS_CreateTask(10, NULL, controlTask);
+    COS_SetTaskBudget(controlTask_pt, _milliSecToTicks(2), COS_BUDGET_SUSPEND);
+    COS_SetBudgetHook(budgetHook);
+    ...
+}
+  @endverbatim
+ ********************************************************************/
+int8_t COS_SetTaskBudget(CosTask_t *task_pt, CosTicks_t budget_Ticks, uint8_t action)
+{
+    if(action > COS_BUDGET_SUSPEND)
+    {   DebugCode(_msg("SetTaskBudget:action\r\n"););
+        return -1;
+    }
+    if(NULL == _searchTaskInList(root_g, task_pt))
+    {   DebugCode(_msg("SetTaskBudget:task not found\r\n"););
+        return -1;
+    }
+    task_pt->budget_Ticks = budget_Ticks;
+    task_pt->budgetAction = action;
+    return 0;
+}
+/*---------------------------------------------------------------*/
+
+
+
+/*!
+ ********************************************************************
+  @par Description
+       Sets the function, that the scheduler calls on every budget
+       violation, e.g. to log it or to stop the trace recorder. The hook
+       runs in the scheduler, right after the offending call. It must
+       not delete the offending task.
+
+  @param  hook - IN, hook function, NULL for none
+ ********************************************************************/
+void COS_SetBudgetHook(CosBudgetHook_t hook)
+{
+    budgetHook_g = hook;
+}
+/*---------------------------------------------------------------*/
+
+
+
+/*!
+ ********************************************************************
+  @par Description
+       Number of budget violations of all tasks since start up.
+
+  @param  last - OUT, copy of the last violation, may be NULL. Not
+                 changed if there has been no violation. The task
+                 pointer may be stale, if the task has been deleted.
+
+  @retval number of violations
+ ********************************************************************/
+uint32_t COS_GetBudgetViolations(CosBudgetViolation_t *last)
+{
+    if((NULL != last) && (nViolations_g > 0))
+    {   *last = lastViolation_g;
+    }
+    return nViolations_g;
+}
+/*---------------------------------------------------------------*/
+
+
+
+/*!
+ ********************************************************************
+  @par Description
+       Sets the function that kicks (triggers) a hardware watchdog. The
+       scheduler calls it at most once per millisecond, whenever it has
+       control: after a task function call and after each scan of the
+       task-list. As long as the scheduler makes progress, the watchdog
+       is kicked; a task function that hangs stops the kicks and the
+       watchdog resets the controller. The watchdog period must be
+       longer than the longest budget.
+
+  @param  kick - IN, kick function, NULL for none
+
+  @par Code example
+  @verbatim
+void kick(void)
+{   IWDG->KR = 0xAAAA;  // reload the independent watchdog of an STM32
+}
+...
+    COS_SetWatchdogKick(kick);
+    COS_RunScheduler();
+  @endverbatim
+ ********************************************************************/
+void COS_SetWatchdogKick(void (*kick)(void))
+{
+    lastKick_g = _gettime_Ticks();
+    watchdogKick_g = kick;
+}
+/*---------------------------------------------------------------*/
+#endif
+
+
+
+#if COS_SCHEDULER_COUNTERS
+/*!
+ ********************************************************************
+  @par Description
+       Samples the counters of the scheduler loop and the number of
+       reads of the system time, see CosSchedCounters_t. The function
+       is cheap, it copies a few words. Rates are computed from two
+       samples with COS_SchedulerRatePerSec(). Dispatches per second
+       and checks per dispatch show how much time the scan of the
+       task-list costs in a given task set; time reads per loop show
+       the cost of the clock, e.g. of micros() on Arduino.
+
+  @param  c - OUT, copy of the counters, with the time of the sample
+
+  @retval 0
+
+  @par Code example
+  @verbatim
+void monitorTask(CosTask_t *pt)
+{   static CosSchedCounters_t before, now;
+
+    COS_TASK_BEGIN(pt);
+    COS_GetSchedulerCounters(&before);
+    while(1)
+    {   COS_TASK_SLEEP(pt,_milliSecToTicks(1000));
+        COS_GetSchedulerCounters(&now);
+        serPuts("dispatches/s:");
+        serOutUint32Dec(COS_SchedulerRatePerSec(now.dispatches, before.dispatches,
+                                                now.time_Ticks, before.time_Ticks));
+        serPuts(" checks/s:");
+        serOutUint32Dec(COS_SchedulerRatePerSec(now.checks, before.checks,
+                                                now.time_Ticks, before.time_Ticks));
+        before = now;
+    }
+    COS_TASK_END(pt);
+}
+  @endverbatim
+ ********************************************************************/
+int8_t COS_GetSchedulerCounters(CosSchedCounters_t *c)
+{
+    counters_g.timeReads = _getTimeReads();
+    counters_g.time_Ticks = _gettime_Ticks();
+    *c = counters_g;
+    return 0;
+}
+/*---------------------------------------------------------------*/
+
+
+
+/*!
+ ********************************************************************
+  @par Description
+       Sets the counters of the scheduler loop to 0. The reads of the
+       system time are counted since start-up, they are not reset.
+ ********************************************************************/
+void COS_ResetSchedulerCounters(void)
+{
+    counters_g.loops = 0;
+    counters_g.checks = 0;
+    counters_g.dispatches = 0;
+    counters_g.idleScans = 0;
+}
+/*---------------------------------------------------------------*/
+
+
+
+/*!
+ ********************************************************************
+  @par Description
+       Returns the rate of a counter between two samples of
+       COS_GetSchedulerCounters(), in events per second.
+
+  @param  count         - IN, counter of the later sample
+  @param  countBefore   - IN, counter of the earlier sample
+  @param  t_Ticks       - IN, time of the later sample
+  @param  tBefore_Ticks - IN, time of the earlier sample
+
+  @retval events per second, 0 if no time has passed
+ ********************************************************************/
+uint32_t COS_SchedulerRatePerSec(uint32_t count, uint32_t countBefore,
+                                 CosTicks_t t_Ticks, CosTicks_t tBefore_Ticks)
+{   uint64_t dt_us = (uint64_t)(CosTicks_t)(t_Ticks - tBefore_Ticks) * COS_MICROSEC_PER_TICK;
+
+    if(0 == dt_us)
+    {   return 0;
+    }
+    return (uint32_t)((uint64_t)(uint32_t)(count - countBefore) * 1000000ULL / dt_us);
+}
+/*---------------------------------------------------------------*/
+#endif
+
+
+
 
 
 
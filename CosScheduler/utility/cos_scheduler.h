@@ -23,6 +23,15 @@
    0.2     | 17.09. 2013 | Fgb             | nur noch Atmel, deutsche Doku.
    0.3     | 08.10. 2015 | Fgb             | change to renesas controller
    0.4     | 19.11. 2016 | Fgb             | change to openCM, english docu
+   0.5     | 18.10. 2026 | Fgb             | COS_StopScheduler()
+   0.6     | 18.10. 2026 | Fgb             | task statistics
+   0.7     | 18.10. 2026 | Fgb             | COS_GetCPULoadPerMille()
+   0.8     | 18.10. 2026 | Fgb             | trace recorder
+   0.9     | 18.10. 2026 | Fgb             | wake-up latency histograms
+   0.10    | 18.10. 2026 | Fgb             | heap statistics
+   0.11    | 18.10. 2026 | Fgb             | execution budget, watchdog kick
+   0.12    | 18.10. 2026 | Fgb             | counters of the scheduler loop
+   0.13    | 18.10. 2026 | Fgb             | COS_CreateTaskWithData()
 
    @endverbatim
 
@@ -45,15 +54,15 @@ This program is free software: you can redistribute it and/or modify
     You should have received a copy of the GNU General Public License
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
-    Dieses Programm ist Freie Software: Sie knnen es unter den Bedingungen
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
     der GNU General Public License, wie von der Free Software Foundation,
     Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
-    verffentlichten Version, weiterverbreiten und/oder modifizieren.
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
 
-    Dieses Programm wird in der Hoffnung, dass es ntzlich sein wird, aber
-    OHNE JEDE GEWHRLEISTUNG, bereitgestellt; sogar ohne die implizite
-    Gewhrleistung der MARKTFHIGKEIT oder EIGNUNG FR EINEN BESTIMMTEN ZWECK.
-    Siehe die GNU General Public License fr weitere Details.
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
 
     Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
     Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
@@ -67,19 +76,92 @@ This program is free software: you can redistribute it and/or modify
 #include "cos_configure.h"
 #include "cos_systime.h"
 #include "cos_linear_task_list.h"
+#include "cos_trace.h"
+#include "cos_latency.h"
+#include "cos_memory.h"
 
 
 int8_t COS_InitTaskList(void);
 CosTask_t* COS_CreateTask(uint8_t prio, void * pData, void (*func) (CosTask_t *));
+CosTask_t* COS_CreateTaskWithData(uint8_t prio, uint16_t dataSize, void (*func) (CosTask_t *));
 int8_t COS_DeleteTask(CosTask_t* task_pt);
 int8_t COS_SuspendTask(CosTask_t* task_pt);
 int8_t COS_ResumeTask(CosTask_t* task_pt);
 int8_t COS_SetTaskPrio(CosTask_t* task_pt,uint8_t taskPrio);
 int8_t COS_RunScheduler(void);
+void   COS_StopScheduler(void);
 
 
 void   COS_PrintTaskList(void);
+/* averaging windows of COS_GetCPULoadPerMille() */
+#define COS_LOAD_100MS   0  /*!< load of the last 100 ms (50 ms with 16 bit ticks of 1 us) */
+#define COS_LOAD_1S      1  /*!< moving average over about 1 s */
+#define COS_LOAD_10S     2  /*!< moving average over about 10 s */
+#define COS_LOAD_WINDOWS 3  /*!< number of averaging windows */
+
 int8_t COS_GetCPULoadInPercent(void);
+uint16_t COS_GetCPULoadPerMille(uint8_t window);
+
+#if COS_TASK_STATISTICS
+int8_t     COS_GetTaskStatistics(CosTask_t *task_pt, CosTaskStats_t *stats);
+int8_t     COS_ResetTaskStatistics(CosTask_t *task_pt);
+CosTicks_t COS_TaskStatsAverage_Ticks(const CosTaskStats_t *stats);
+#endif
+
+#if COS_TASK_BUDGET
+/* reaction of the scheduler to a call longer than the budget */
+#define COS_BUDGET_REPORT   0  /*!< count it and call the budget hook */
+#define COS_BUDGET_SUSPEND  1  /*!< as COS_BUDGET_REPORT, then suspend the task */
+
+/*!
+ ********************************************************************
+  @par Description
+  A task function call that took longer than the budget of the task,
+  see COS_SetTaskBudget(). startLine is the resume point (lineCnt) the
+  call started at, i.e. the code after that scheduling macro did not
+  yield in time. endLine is the resume point the call returned with.
+********************************************************************/
+typedef struct                   /*! budget violation */
+{   CosTask_t  *task_pt;         /*!< offending task */
+    uint16_t    startLine;       /*!< lineCnt at the start of the call */
+    uint16_t    endLine;         /*!< lineCnt at the end of the call */
+    CosTicks_t  used_Ticks;      /*!< duration of the call */
+    CosTicks_t  budget_Ticks;    /*!< budget of the task */
+    CosTicks_t  time_Ticks;      /*!< end of the call */
+} CosBudgetViolation_t;
+
+typedef void (*CosBudgetHook_t)(const CosBudgetViolation_t *v); /*!< called on a violation */
+
+int8_t   COS_SetTaskBudget(CosTask_t *task_pt, CosTicks_t budget_Ticks, uint8_t action);
+void     COS_SetBudgetHook(CosBudgetHook_t hook);
+uint32_t COS_GetBudgetViolations(CosBudgetViolation_t *last);
+void     COS_SetWatchdogKick(void (*kick)(void));
+#endif
+
+#if COS_SCHEDULER_COUNTERS
+/*!
+ ********************************************************************
+  @par Description
+  Counters of the scheduler loop, see COS_GetSchedulerCounters(). All
+  counters wrap around; the difference of two samples is right, as long
+  as less than 2^32 events lie between them.
+  checks - dispatches is the number of tasks checked in vain, checks
+  per dispatch the average length of the scan for a ready task.
+********************************************************************/
+typedef struct                   /*! counters of the scheduler loop */
+{   uint32_t   loops;            /*!< iterations of the scheduler loop */
+    uint32_t   checks;           /*!< tasks checked for being ready */
+    uint32_t   dispatches;       /*!< task function calls */
+    uint32_t   idleScans;        /*!< scans of the whole list without a dispatch */
+    uint32_t   timeReads;        /*!< calls of _gettime_Ticks() */
+    CosTicks_t time_Ticks;       /*!< time of the sample */
+} CosSchedCounters_t;
+
+int8_t   COS_GetSchedulerCounters(CosSchedCounters_t *c);
+void     COS_ResetSchedulerCounters(void);
+uint32_t COS_SchedulerRatePerSec(uint32_t count, uint32_t countBefore,
+                                 CosTicks_t t_Ticks, CosTicks_t tBefore_Ticks);
+#endif
 
 Node_t* COS_GetTaskListRootPointer(void);
 
@@ -19,6 +19,10 @@
    0.0     | 29.04. 2011 | Fgb           | First Version, Linux
    0.1     | 17.09. 2013 | Fgb           | nur noch Atmel, deutsche Doku.
    0.2     | 08.10. 2015 | Fgb           | renesas controller
+   0.3     | 18.10. 2026 | Fgb           | trace event in COS_SEM_SIGNAL()
+   0.4     | 18.10. 2026 | Fgb           | wake-up latency in COS_SEM_SIGNAL()
+   0.5     | 18.10. 2026 | Fgb           | nodes freed by _memFree()
+   0.6     | 18.10. 2026 | Fgb           | _setTaskReady()
    @endverbatim
 
 
@@ -60,15 +64,15 @@ This program is free software: you can redistribute it and/or modify
     You should have received a copy of the GNU General Public License
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
-    Dieses Programm ist Freie Software: Sie knnen es unter den Bedingungen
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
     der GNU General Public License, wie von der Free Software Foundation,
     Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
-    verffentlichten Version, weiterverbreiten und/oder modifizieren.
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
 
-    Dieses Programm wird in der Hoffnung, dass es ntzlich sein wird, aber
-    OHNE JEDE GEWHRLEISTUNG, bereitgestellt; sogar ohne die implizite
-    Gewhrleistung der MARKTFHIGKEIT oder EIGNUNG FR EINEN BESTIMMTEN ZWECK.
-    Siehe die GNU General Public License fr weitere Details.
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
 
     Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
     Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.*****************************************************************************/
@@ -77,6 +81,7 @@ This program is free software: you can redistribute it and/or modify
 
 
 #include "cos_semaphore.h"
+#include "cos_memory.h"
 
 
 
@@ -178,7 +183,7 @@ uint8_t COS_SemDestroy(CosSema_t *s)
     while(s->root_pt != NULL)
     {   pt = s->root_pt;                    // node to be freed
         s->root_pt = s->root_pt->next_pt;  // next node in list
-        free(pt);
+        _memFree(pt, sizeof(Node_t));
     }
     return 0;
 }
@@ -234,7 +239,7 @@ void COS_SEM_SIGNAL(CosSema_t *s)
   (s->count)++;
   if(s->root_pt != NULL)  // any task waiting on this sema?
   { task_pt = s->root_pt->task_pt;  // first waiting task
-    task_pt->state = TASK_STATE_READY;  // make it ready to run
+    _setTaskReady(task_pt);  // make it ready to run
     s->root_pt = _unlinkTaskFromTaskList(s->root_pt, task_pt); // remove it from sema-list
   }
 
@@ -61,6 +61,7 @@
    0.1     | 17.09. 2013 | Fgb           | ported to Atmel AVR, deutsche Doku.
    0.2     | 08.10. 2015 | Fgb           | switch to renesas controller
    0.3     | 22.10.2015  | Fgb           | Bugfix in COS_SEM_WAIT()
+   0.4     | 18.10.2026  | Fgb           | trace event in COS_SEM_WAIT()
 
    @endverbatim
 
@@ -83,15 +84,15 @@ This program is free software: you can redistribute it and/or modify
     You should have received a copy of the GNU General Public License
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
-    Dieses Programm ist Freie Software: Sie knnen es unter den Bedingungen
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
     der GNU General Public License, wie von der Free Software Foundation,
     Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
-    verffentlichten Version, weiterverbreiten und/oder modifizieren.
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
 
-    Dieses Programm wird in der Hoffnung, dass es ntzlich sein wird, aber
-    OHNE JEDE GEWHRLEISTUNG, bereitgestellt; sogar ohne die implizite
-    Gewhrleistung der MARKTFHIGKEIT oder EIGNUNG FR EINEN BESTIMMTEN ZWECK.
-    Siehe die GNU General Public License fr weitere Details.
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
 
     Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
     Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
@@ -179,6 +180,7 @@ void myTask(CosTask_t *pt)
 #define COS_SEM_WAIT(s,pt)  (pt)->lineCnt=__LINE__;\
                             if((s)->count <= 0) {  \
                               (pt)->state = TASK_STATE_BLOCKED; \
+                              COS_TRACE_EVENT(COS_TRACE_BLOCK, (pt), 0); \
                               (s)->root_pt=_addTaskAtBeginningOfTaskList((s)->root_pt,(pt)); \
                             } \
                             ((s)->count)--; \
@@ -6,6 +6,19 @@
  *   @brief  Routines for serial communication on renesas Controller RX63N.
  *           Uses the board support package 'bsp' (Zink). The routines use
  *           putchar() and getchar().
+ *           On a POSIX host, stdout and stdin of the process are used
+ *           instead, the RX63N version is shared.
+ *
+ *           With COS_SER_TX_BUFFER > 0, serPutc() and all output functions
+ *           built on it do not wait for the UART: they put the bytes into
+ *           a ring buffer, which is written to the UART by a COS task (see
+ *           serTxStart()) or by a TX-empty interrupt (see serTxGetByte()).
+ *           A debug line then costs microseconds instead of the time to
+ *           send it. When the buffer is full, bytes are dropped or the
+ *           writer waits for the UART, see serTxSetPolicy(). Tasks may
+ *           wait for free space co-operatively with SER_TX_WAIT().
+ *           Without a drain, a full buffer is written to the UART by
+ *           serPutc() itself; on POSIX, the rest is sent at exit().
  *
  *
  *   @par Author:     Ernst Forgber (Fgb)
@@ -18,6 +31,13 @@
  * 0.0  04.12.2008  E. Forgber        file created
  * 0.1  20.03.2013  E. Forgber        Dokumentation auf Deutsch umgestellt
  * 0.2  09.10.2015  E. Forgber (Fgb)  switch to renesas controller
+ * 0.3  18.10.2026  E. Forgber (Fgb)  POSIX host version on stdin/stdout
+ * 0.4  18.10.2026  E. Forgber (Fgb)  buffered, non-blocking output
+ * 0.5  18.10.2026  E. Forgber (Fgb)  fast number formatting, serPrintf()
+ * 0.6  18.10.2026  E. Forgber (Fgb)  tasks woken by _setTaskReady()
+ * 0.7  18.10.2026  E. Forgber (Fgb)  TX buffer: no loss without drain, flush at exit
+ * 0.8  18.10.2026  E. Forgber (Fgb)  bulk output waits instead of dropping bytes
+ * 0.9  18.10.2026  E. Forgber (Fgb)  TX interrupt kicked after every put
  *
  *   @endverbatim
  *
@@ -43,15 +63,15 @@ This program is free software: you can redistribute it and/or modify
     You should have received a copy of the GNU General Public License
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
-    Dieses Programm ist Freie Software: Sie knnen es unter den Bedingungen
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
     der GNU General Public License, wie von der Free Software Foundation,
     Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
-    verffentlichten Version, weiterverbreiten und/oder modifizieren.
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
 
-    Dieses Programm wird in der Hoffnung, dass es ntzlich sein wird, aber
-    OHNE JEDE GEWHRLEISTUNG, bereitgestellt; sogar ohne die implizite
-    Gewhrleistung der MARKTFHIGKEIT oder EIGNUNG FR EINEN BESTIMMTEN ZWECK.
-    Siehe die GNU General Public License fr weitere Details.
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
 
     Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
     Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
@@ -62,16 +82,583 @@ This program is free software: you can redistribute it and/or modify
 
 //#include <avr/io.h>
 //#include <stdint.h>
+#include <string.h>
 #include "cos_ser.h"
 
 
 /**************************************************************************
-*      Renesas RX63N Verion                                               *
+*      Renesas RX63N and POSIX Verion                                     *
 **************************************************************************/
 
-#if COS_PLATFORM == PLATFORM_RENESAS_RX63N
+#if (COS_PLATFORM == PLATFORM_RENESAS_RX63N) || (COS_PLATFORM == PLATFORM_POSIX)
+
+#if COS_PLATFORM == PLATFORM_POSIX
+  #include <stdio.h>
+  #include <stdlib.h>
+  #include <poll.h>
+  #include <unistd.h>
+
+  #define SER_ECHO 0   /*!< the terminal echoes by itself */
+
+static uint8_t inputEof_g = 0;  /*!< 1: stdin has ended, see serEof() */
+
+/*!
+ **********************************************************************
+ * @par Description:
+ *   POSIX only: reads a byte from stdin, waiting at most 'timeout_ms'
+ *   milliseconds, -1 waits without time limit. Pending output is
+ *   flushed first, a prompt will be visible.
+ *
+ * @retval   the byte read or -1 if there was none
+ ************************************************************************/
+static int16_t _posixReadByte(int timeout_ms)
+{   struct pollfd pfd;
+    unsigned char c;
+
+    fflush(stdout);
+    pfd.fd = STDIN_FILENO;
+    pfd.events = POLLIN;
+    if(poll(&pfd, 1, timeout_ms) <= 0)
+    {   return -1;  /* nothing to read */
+    }
+    if(read(STDIN_FILENO, &c, 1) != 1)
+    {   inputEof_g = 1;
+        return -1;  /* end of file or error */
+    }
+    return c;
+}
+#else
+  #define SER_ECHO 1     /*!< 0: kein Echo, sonst empfangene Zeichen mit Echo */
+#endif
+
+
+
+#if COS_SER_TX_BUFFER > 0
+#include "cos_scheduler.h"
+
+#if (COS_SER_TX_BUFFER & (COS_SER_TX_BUFFER - 1)) || (COS_SER_TX_BUFFER > 32768)
+  #error "COS_SER_TX_BUFFER has to be a power of two, 32768 at most"
+#endif
+
+/*! index into the ring buffer */
+#define TX_INDEX(i)  ((i) & (COS_SER_TX_BUFFER - 1))
+
+static char txBuf_g[COS_SER_TX_BUFFER];   /*!< ring buffer of bytes to send */
+static volatile uint16_t txHead_g = 0;    /*!< bytes put, written by serPutc() only */
+static volatile uint16_t txTail_g = 0;    /*!< bytes taken, by the drain task or the ISR only */
+static uint8_t txPolicy_g = SER_TX_DROP;  /*!< reaction to a full buffer */
+static uint8_t txBulk_g = 0;              /*!< nesting of serTxBulkBegin() */
+static CosSerTxStats_t txStats_g = {0, 0, 0, 0}; /*!< counters */
+static CosTask_t *txTask_pt_g = NULL;     /*!< drain task, NULL if none */
+static void (*txKick_g)(void) = NULL;     /*!< starts the TX-empty interrupt */
+static Node_t *txWaiting_g = NULL;        /*!< tasks waiting in SER_TX_WAIT() */
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ *   Returns the number of bytes in the TX buffer.
+ ************************************************************************/
+static uint16_t _txUsed(void)
+{   return (uint16_t)(txHead_g - txTail_g);  /* wrap around is ok */
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ *   Writes the oldest byte of the TX buffer to the UART. Waits for the
+ *   UART, must not be used while an interrupt drains the buffer.
+ ************************************************************************/
+static void _txWriteOne(void)
+{   putchar(txBuf_g[TX_INDEX(txTail_g)]);
+    txTail_g++;
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ *   Wakes up the drain after bytes have been put into the buffer. The
+ *   interrupt is kicked after every put, not only when the buffer has
+ *   been empty before: between reading the fill level and storing the
+ *   byte, the interrupt may send the last byte and disable itself, and
+ *   the new byte would never be sent. Kicking a running interrupt must
+ *   not harm, see serTxSetKick(). The drain task is woken up, if it is
+ *   blocked after the store; it runs in the same context as the writer.
+ ************************************************************************/
+static void _txWakeUpDrain(void)
+{
+    if(NULL != txKick_g)
+    {   txKick_g();
+    }
+    if((NULL != txTask_pt_g) && (TASK_STATE_BLOCKED == txTask_pt_g->state))
+    {   _setTaskReady(txTask_pt_g);
+    }
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ *   Puts a byte into the TX buffer, see serPutc(). With a full buffer,
+ *   the byte is dropped (SER_TX_DROP) or the oldest byte is sent first,
+ *   waiting for the UART (SER_TX_BLOCK). With an interrupt draining the
+ *   buffer, SER_TX_BLOCK busy-waits for the interrupt instead: serPutc()
+ *   is no task, it cannot yield. Without a drain task or interrupt,
+ *   nothing would ever empty the buffer, so it is handled like
+ *   SER_TX_BLOCK: the output is delayed, not lost. Between
+ *   serTxBulkBegin() and serTxBulkEnd(), SER_TX_BLOCK is used as well.
+ ************************************************************************/
+static void _txPut(char x)
+{   uint16_t used = _txUsed();
+
+    if(used >= COS_SER_TX_BUFFER)
+    {   if((SER_TX_DROP == txPolicy_g) && (0 == txBulk_g) &&
+           ((NULL != txTask_pt_g) || (NULL != txKick_g)))
+        {   txStats_g.dropped++;
+            return;
+        }
+        txStats_g.waited++;
+        if(NULL == txKick_g)
+        {   _txWriteOne();  /* make room, waits for the UART */
+        }
+        while(_txUsed() >= COS_SER_TX_BUFFER)
+        {   /* busy wait: the TX-empty interrupt makes room */
+        }
+        used = _txUsed();
+    }
+    txBuf_g[TX_INDEX(txHead_g)] = x;
+    txHead_g++;
+    txStats_g.written++;
+    if(used + 1 > txStats_g.peakUsed)
+    {   txStats_g.peakUsed = used + 1;
+    }
+    _txWakeUpDrain();
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ *   Sets all tasks waiting in SER_TX_WAIT() ready, when at least half
+ *   of the buffer is free. They check the free space again.
+ ************************************************************************/
+static void _txWakeUpWriters(void)
+{   CosTask_t *task_pt;
+
+    while((NULL != txWaiting_g) && (_txUsed() <= COS_SER_TX_BUFFER / 2))
+    {   task_pt = txWaiting_g->task_pt;
+        _setTaskReady(task_pt);
+        txWaiting_g = _unlinkTaskFromTaskList(txWaiting_g, task_pt);
+    }
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ *   The drain task writes up to COS_SER_TX_CHUNK bytes per call to the
+ *   UART. With an empty buffer, it blocks until serPutc() wakes it up.
+ ************************************************************************/
+static void _txTask(CosTask_t *pt)
+{   uint16_t n;
+
+    COS_TASK_BEGIN(pt);
+    while(1)
+    {   for(n = 0; (n < COS_SER_TX_CHUNK) && (_txUsed() > 0); n++)
+        {   _txWriteOne();
+        }
+        _txWakeUpWriters();
+        if(0 == _txUsed())
+        {   pt->state = TASK_STATE_BLOCKED;  /* woken up by serPutc() */
+        }
+        COS_TASK_SCHEDULE(pt);
+    }
+    COS_TASK_END(pt);
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ *   Starts the task that drains the TX buffer. Without a drain task,
+ *   the buffer has to be drained by a TX-empty interrupt, see
+ *   serTxGetByte(). The priority should be low: the task waits for
+ *   the UART while it writes a byte. Call it after COS_InitTaskList(),
+ *   which starts with an empty task-list.
+ *
+ * @param  prio  - IN, priority of the drain task
+ *
+ * @retval 0 for ok, -1 if the task could not be created
+ *
+ * @par Example :
+ * @verbatim
+int main(void)
+{ ...
+  COS_InitTaskList();
+  serTxStart(1);
+  serTxSetPolicy(SER_TX_DROP);
+  ...
+  COS_RunScheduler();
+}
+  @endverbatim
+ ************************************************************************/
+int8_t serTxStart(uint8_t prio)
+{
+    if(NULL == txTask_pt_g)
+    {   txTask_pt_g = COS_CreateTask(prio, NULL, _txTask);
+        if(NULL == txTask_pt_g)
+        {   return -1;
+        }
+    }
+    return 0;
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ *   Sets the reaction of serPutc() to a full TX buffer:
+ *   SER_TX_DROP drops the byte and counts it, SER_TX_BLOCK waits
+ *   until the UART has taken a byte. Tasks that must not lose output
+ *   and must not block the system use SER_TX_WAIT() before writing.
+ *   With a TX-empty interrupt (serTxSetKick()), SER_TX_BLOCK busy-waits
+ *   in serPutc() until the interrupt has taken a byte, so serPutc()
+ *   must not be called with interrupts disabled or from an interrupt.
+ *   Without drain task and interrupt, SER_TX_DROP acts as SER_TX_BLOCK.
+ *
+ * @param  policy  - IN, SER_TX_DROP or SER_TX_BLOCK
+ ************************************************************************/
+void serTxSetPolicy(uint8_t policy)
+{   txPolicy_g = (SER_TX_BLOCK == policy) ? SER_TX_BLOCK : SER_TX_DROP;
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ *   Sets the function that starts the transmission by interrupt, e.g.
+ *   enables the TX-empty interrupt of the UART. serPutc() calls it
+ *   after every byte it puts into the buffer, so the function must be
+ *   idempotent: enabling an interrupt that is already enabled must
+ *   neither lose nor repeat a byte. The interrupt service routine
+ *   takes the bytes with serTxGetByte() and disables the interrupt,
+ *   when there are none left.
+ *
+ * @param  kick  - IN, function that starts the interrupt, NULL for none
+ ************************************************************************/
+void serTxSetKick(void (*kick)(void))
+{   txKick_g = kick;
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ *   Takes the next byte to send from the TX buffer. For the TX-empty
+ *   interrupt service routine, there must be no drain task.
+ *
+ * @retval   the byte or -1 if the buffer is empty
+ *
+ * @par Example :
+ * @verbatim
+void INT_Excep_SCI2_TXI2(void)
+{   int16_t c = serTxGetByte();
+
+    if(c < 0)
+    {   SCI2.SCR.BIT.TIE = 0;  // nothing left to send
+    }
+    else
+    {   SCI2.TDR = (uint8_t) c;
+    }
+}
+  @endverbatim
+ ************************************************************************/
+int16_t serTxGetByte(void)
+{   uint8_t c;
+
+    if(0 == _txUsed())
+    {   return -1;
+    }
+    c = (uint8_t) txBuf_g[TX_INDEX(txTail_g)];
+    txTail_g++;
+    return c;
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ *   Returns the number of free bytes in the TX buffer.
+ ************************************************************************/
+uint16_t serTxFree(void)
+{   return (uint16_t)(COS_SER_TX_BUFFER - _txUsed());
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ *   Sends all bytes in the TX buffer and returns, when it is empty. The
+ *   function waits for the UART, e.g. before a reset or at the end of
+ *   a program.
+ ************************************************************************/
+void serTxFlush(void)
+{
+    while(_txUsed() > 0)
+    {   if(NULL == txKick_g)
+        {   _txWriteOne();
+        }
+    }
+#if COS_PLATFORM == PLATFORM_POSIX
+    fflush(stdout);
+#endif
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ *   Starts the output of many lines at once, e.g. a dump. The drain
+ *   task cannot run before the writer returns, so the dump would fill
+ *   the buffer and lose its end with SER_TX_DROP. Up to serTxBulkEnd(),
+ *   a full buffer is handled as with SER_TX_BLOCK: serPutc() sends the
+ *   oldest byte itself and waits for the UART. Calls may be nested.
+ *   Use the macros SER_TX_BULK_BEGIN() and SER_TX_BULK_END(), they
+ *   also compile without TX buffer.
+ *
+ * @par Example :
+ * @verbatim
+void COS_TraceDump(void)
+{   SER_TX_BULK_BEGIN();
+    ...  // all lines of the dump
+    SER_TX_BULK_END();
+}
+  @endverbatim
+ ************************************************************************/
+void serTxBulkBegin(void)
+{   txBulk_g++;
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ *   Ends the output started by serTxBulkBegin(). The bytes still in the
+ *   buffer are sent by the drain as usual.
+ ************************************************************************/
+void serTxBulkEnd(void)
+{
+    if(txBulk_g > 0)
+    {   txBulk_g--;
+    }
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ *   Copies the counters of the TX buffer. 'dropped' counts the bytes
+ *   lost with SER_TX_DROP, 'waited' the bytes that had to wait for the
+ *   UART with SER_TX_BLOCK. A peak close to COS_SER_TX_BUFFER calls for
+ *   a larger buffer or a drain task of higher priority.
+ *
+ * @param  stats  - OUT, copy of the counters
+ ************************************************************************/
+void serTxGetStats(CosSerTxStats_t *stats)
+{   *stats = txStats_g;
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ *   PLEASE NOTE: This function is for internal use only! Use the macro
+ *   SER_TX_WAIT(). If less than n bytes are free in the TX buffer, the
+ *   task is blocked until the drain has freed half of the buffer.
+ *
+ * @param  pt  - IN/OUT, task
+ * @param  n   - IN, bytes needed, at most COS_SER_TX_BUFFER
+ *
+ * @retval 1 if the task has to wait, 0 otherwise
+ ************************************************************************/
+int8_t _serTxMustWait(struct CosTask_t *pt, uint16_t n)
+{
+    if(n > COS_SER_TX_BUFFER)
+    {   n = COS_SER_TX_BUFFER;
+    }
+    if(serTxFree() >= n)
+    {   return 0;
+    }
+    pt->state = TASK_STATE_BLOCKED;
+    COS_TRACE_EVENT(COS_TRACE_BLOCK, pt, 0);
+    txWaiting_g = _addTaskAtBeginningOfTaskList(txWaiting_g, pt);
+    return 1;
+}
+
 
-#define SER_ECHO 1     /*!< 0: kein Echo, sonst empfangene Zeichen mit Echo */
+/*!
+ **********************************************************************
+ * @par Description:
+ *   Puts a block of bytes into the TX buffer, see serWrite(). If the
+ *   block fits, it is copied at once, otherwise byte by byte with the
+ *   policy of _txPut().
+ ************************************************************************/
+static void _txWrite(const char *data, uint16_t len)
+{   uint16_t used = _txUsed();
+    uint16_t i;
+
+    if(len > COS_SER_TX_BUFFER - used)
+    {   while(len-- > 0)
+        {   _txPut(*data++);
+        }
+        return;
+    }
+    for(i = 0; i < len; i++)
+    {   txBuf_g[TX_INDEX(txHead_g + i)] = data[i];
+    }
+    txHead_g += len;
+    txStats_g.written += len;
+    if(used + len > txStats_g.peakUsed)
+    {   txStats_g.peakUsed = used + len;
+    }
+    if(len > 0)
+    {   _txWakeUpDrain();
+    }
+}
+#endif // COS_SER_TX_BUFFER
+
+
+
+/*---------------- formatting of numbers ------------------------*/
+/* The digits of a number are written into a small buffer, from its end
+   to its beginning, and the buffer is sent with one serWrite(). Decimal
+   numbers are converted two digits per division by a table of the pairs
+   "00".."99": half the divisions of the digit by digit algorithm. Below
+   65536 the division is done with 16 bit, cheap on 8 and 16 bit cores
+   without a 32 bit divide instruction. Compilers replace the division by
+   the constant 100 by a multiplication, if the core multiplies fast.
+*/
+
+/*! the pairs of decimal digits "00".."99" */
+static const char digitPairs_g[200] =
+{   '0','0','0','1','0','2','0','3','0','4','0','5','0','6','0','7','0','8','0','9',
+    '1','0','1','1','1','2','1','3','1','4','1','5','1','6','1','7','1','8','1','9',
+    '2','0','2','1','2','2','2','3','2','4','2','5','2','6','2','7','2','8','2','9',
+    '3','0','3','1','3','2','3','3','3','4','3','5','3','6','3','7','3','8','3','9',
+    '4','0','4','1','4','2','4','3','4','4','4','5','4','6','4','7','4','8','4','9',
+    '5','0','5','1','5','2','5','3','5','4','5','5','5','6','5','7','5','8','5','9',
+    '6','0','6','1','6','2','6','3','6','4','6','5','6','6','6','7','6','8','6','9',
+    '7','0','7','1','7','2','7','3','7','4','7','5','7','6','7','7','7','8','7','9',
+    '8','0','8','1','8','2','8','3','8','4','8','5','8','6','8','7','8','8','8','9',
+    '9','0','9','1','9','2','9','3','9','4','9','5','9','6','9','7','9','8','9','9'
+};
+static const char hexUpper_g[] = "0123456789ABCDEF"; /*!< digits of %X */
+static const char hexLower_g[] = "0123456789abcdef"; /*!< digits of %x */
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ *   Writes the decimal digits of x in front of 'end', without leading
+ *   zeros. The buffer needs 10 bytes in front of 'end'.
+ *
+ * @param  end  - IN, end of the digits (exclusive)
+ * @param  x    - IN, number
+ *
+ * @retval pointer to the first digit
+ ************************************************************************/
+static char *_fmtUint32Dec(char *end, uint32_t x)
+{   uint16_t y, r;
+
+    while(x > 0xFFFF)
+    {   r = (uint16_t)(x % 100);
+        x /= 100;
+        end -= 2;
+        end[0] = digitPairs_g[2*r];
+        end[1] = digitPairs_g[2*r+1];
+    }
+    y = (uint16_t) x;
+    while(y >= 100)
+    {   r = y % 100;
+        y /= 100;
+        end -= 2;
+        end[0] = digitPairs_g[2*r];
+        end[1] = digitPairs_g[2*r+1];
+    }
+    if(y >= 10)
+    {   end -= 2;
+        end[0] = digitPairs_g[2*y];
+        end[1] = digitPairs_g[2*y+1];
+    }
+    else
+    {   *--end = (char)('0' + y);
+    }
+    return end;
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ *   Writes the hex digits of x in front of 'end'. With nDigits == 0,
+ *   leading zeros are left out, otherwise exactly nDigits digits are
+ *   written.
+ *
+ * @param  end      - IN, end of the digits (exclusive)
+ * @param  x        - IN, number
+ * @param  nDigits  - IN, number of digits (1..8), 0 for as many as needed
+ * @param  digits   - IN, hexUpper_g or hexLower_g
+ *
+ * @retval pointer to the first digit
+ ************************************************************************/
+static char *_fmtUint32Hex(char *end, uint32_t x, uint8_t nDigits, const char *digits)
+{
+    do
+    {   *--end = digits[x & 0xF];
+        x >>= 4;
+    } while((nDigits > 0) ? (--nDigits > 0) : (x != 0));
+    return end;
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ *   Sends a decimal number with a leading blank, as serOutUint32Dec()
+ *   always did, and an optional sign.
+ *
+ * @param  x     - IN, magnitude
+ * @param  sign  - IN, '-' or 0 for none
+ ************************************************************************/
+static void _outDec(uint32_t x, char sign)
+{   char buf[12];
+    char *pt = _fmtUint32Dec(buf + sizeof(buf), x);
+
+    if(sign)
+    {   *--pt = sign;
+    }
+    *--pt = ' ';
+    serWrite(pt, (uint16_t)(buf + sizeof(buf) - pt));
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ *   Sends a hex number with prefix " 0x" and nDigits digits.
+ ************************************************************************/
+static void _outHex(uint32_t x, uint8_t nDigits)
+{   char buf[11];
+    char *pt = _fmtUint32Hex(buf + sizeof(buf), x, nDigits, hexUpper_g);
+
+    *--pt = 'x';  // Hex Praefix ist 0x
+    *--pt = '0';
+    *--pt = ' ';
+    serWrite(pt, (uint16_t)(buf + sizeof(buf) - pt));
+}
+/*---------------------------------------------------------------*/
 
 
 
@@ -84,7 +671,7 @@ This program is free software: you can redistribute it and/or modify
  *   Die Einstellungen der seriellen Schnittstelle werden durch das bsp
  *   initialisiert. Die
  *   Standardeinstellungen dort sind: 9600 Baud, 8 Datenbit, 1 Stoppbit,
- *   keine Parität (9600, 8N1).
+ *   keine ParitÃ¤t (9600, 8N1).
  *
 
  * @see file read.c
@@ -108,10 +695,18 @@ int main(void)
   @endverbatim
  ************************************************************************/
 void serInit(uint32_t baudRate)
-{   //uartInitialize(baudRate, UART_DATABITS_8, UART_PARITY_NONE, UART_STOPBITS_1);
+{
+#if COS_PLATFORM == PLATFORM_POSIX
+    (void) baudRate;  // stdin and stdout need no initialization
+  #if COS_SER_TX_BUFFER > 0
+    atexit(serTxFlush);  // the rest of the TX buffer when main() returns
+  #endif
+#else
+    //uartInitialize(baudRate, UART_DATABITS_8, UART_PARITY_NONE, UART_STOPBITS_1);
 	//nutzt die Funktionen aus dem bsp: putchar(), getchar()
 
 	_initSerialInterface_RX_Interrupt(); // siehe file read.c
+#endif
 }
 
 
@@ -144,7 +739,11 @@ int main(void)
  ************************************************************************/
 void serPutc(char x)
 {
+#if COS_SER_TX_BUFFER > 0
+    _txPut(x);
+#else
 	putchar(x);
+#endif
 }
 
 
@@ -178,10 +777,231 @@ int main(void)
  ************************************************************************/
 void serPuts(char *pt)
 {
-  while(*pt != '\0')
-  {  serPutc(*pt);
-     pt++;
-  }
+    serWrite(pt, (uint16_t) strlen(pt));
+}
+
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ *   Sends a block of bytes with one write: with COS_SER_TX_BUFFER, the
+ *   block is copied into the TX buffer at once, on POSIX it is one
+ *   fwrite().
+ *
+ * @see
+ * @arg  serPuts(), serPrintf()
+ *
+ * @param  data  - IN, bytes to send
+ * @param  len   - IN, number of bytes
+ ************************************************************************/
+void serWrite(const char *data, uint16_t len)
+{
+#if COS_SER_TX_BUFFER > 0
+    _txWrite(data, len);
+#elif COS_PLATFORM == PLATFORM_POSIX
+    fwrite(data, 1, len, stdout);
+#else
+    while(len-- > 0)
+    {   putchar(*data++);
+    }
+#endif
+}
+
+
+
+/*------------- serPrintf() -------------------------------------*/
+#define PRINTF_CHUNK  32  /*!< bytes collected by serVprintf() per serWrite() */
+
+/*! output of serVprintf(), sent in chunks */
+typedef struct
+{   char    buf[PRINTF_CHUNK];  /*!< bytes not yet sent */
+    uint8_t n;                  /*!< number of bytes in buf */
+    int16_t total;              /*!< bytes written so far */
+} PrintfOut_t;
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ *   Adds 'count' copies of c to the output of serVprintf().
+ ************************************************************************/
+static void _pfPut(PrintfOut_t *o, char c, uint16_t count)
+{
+    while(count-- > 0)
+    {   if(PRINTF_CHUNK == o->n)
+        {   serWrite(o->buf, o->n);
+            o->n = 0;
+        }
+        o->buf[o->n++] = c;
+        o->total++;
+    }
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ *   Formatted output like vprintf(), see serPrintf().
+ *
+ * @param  fmt  - IN, format string
+ * @param  ap   - IN, arguments
+ *
+ * @retval number of bytes written
+ ************************************************************************/
+int16_t serVprintf(const char *fmt, va_list ap)
+{   PrintfOut_t o;
+    char num[11];              /* digits of a number */
+    char *end = num + sizeof(num);
+    const char *pt;
+    uint8_t left, zero, lng, isNumber;
+    uint16_t width, len, i;
+    uint32_t u;
+    long v;
+    char c, sign;
+
+    o.n = 0;
+    o.total = 0;
+    while('\0' != *fmt)
+    {   if('%' != *fmt)
+        {   _pfPut(&o, *fmt++, 1);
+            continue;
+        }
+        fmt++;
+        left = 0;
+        zero = 0;
+        for(;; fmt++)  /* flags */
+        {   if('-' == *fmt)      left = 1;
+            else if('0' == *fmt) zero = 1;
+            else break;
+        }
+        width = 0;
+        while((*fmt >= '0') && (*fmt <= '9'))
+        {   if(width < 1000)
+            {   width = 10 * width + (uint16_t)(*fmt - '0');
+            }
+            fmt++;
+        }
+        lng = ('l' == *fmt);
+        if(lng)
+        {   fmt++;
+        }
+        c = *fmt;
+        if('\0' == c)
+        {   break;  /* '%' at the end of the format */
+        }
+        fmt++;
+        sign = 0;
+        isNumber = 1;
+        switch(c)
+        {   case 'd':
+            case 'i':
+                v = lng ? va_arg(ap, long) : (long) va_arg(ap, int);
+                if(v < 0)
+                {   sign = '-';
+                    u = (uint32_t)0 - (uint32_t)v;
+                }
+                else
+                {   u = (uint32_t)v;
+                }
+                pt = _fmtUint32Dec(end, u);
+                len = (uint16_t)(end - pt);
+                break;
+            case 'u':
+                u = lng ? (uint32_t) va_arg(ap, unsigned long) : (uint32_t) va_arg(ap, unsigned int);
+                pt = _fmtUint32Dec(end, u);
+                len = (uint16_t)(end - pt);
+                break;
+            case 'x':
+            case 'X':
+                u = lng ? (uint32_t) va_arg(ap, unsigned long) : (uint32_t) va_arg(ap, unsigned int);
+                pt = _fmtUint32Hex(end, u, 0, ('x' == c) ? hexLower_g : hexUpper_g);
+                len = (uint16_t)(end - pt);
+                break;
+            case 'c':
+                num[0] = (char) va_arg(ap, int);
+                pt = num;
+                len = 1;
+                isNumber = 0;
+                break;
+            case 's':
+                pt = va_arg(ap, const char *);
+                if(NULL == pt)
+                {   pt = "(null)";
+                }
+                len = (uint16_t) strlen(pt);
+                isNumber = 0;
+                break;
+            default:  /* %% and unknown conversions are copied */
+                _pfPut(&o, c, 1);
+                continue;
+        }
+        if(sign && (width > 0))
+        {   width--;  /* the sign is part of the field */
+        }
+        if(!left && !(zero && isNumber) && (width > len))
+        {   _pfPut(&o, ' ', width - len);
+        }
+        if(sign)
+        {   _pfPut(&o, sign, 1);
+        }
+        if(!left && zero && isNumber && (width > len))
+        {   _pfPut(&o, '0', width - len);
+        }
+        for(i = 0; i < len; i++)
+        {   _pfPut(&o, pt[i], 1);
+        }
+        if(left && (width > len))
+        {   _pfPut(&o, ' ', width - len);
+        }
+    }
+    if(o.n > 0)
+    {   serWrite(o.buf, o.n);
+    }
+    return o.total;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ *   Formatted output of text and numbers, a small printf(). The text is
+ *   sent in blocks of PRINTF_CHUNK bytes with serWrite(), the numbers
+ *   are converted by the same functions as serOutUint32Dec(). Numbers
+ *   are printed without the leading blank of the serOut...() functions.
+ *
+ *   Conversions: %d %i %u %x %X %c %s %%, with flags '-' (left
+ *   justified) and '0' (leading zeros), a field width and the length
+ *   'l' for long arguments. Numbers have 32 bits at most, there is no
+ *   floating point.
+ *
+ * @see
+ * @arg  serVprintf(), serWrite()
+ *
+ * @param  fmt  - IN, format string
+ *
+ * @retval number of bytes written
+ *
+ * @par Example :
+ * @verbatim
+int main(void)
+{ ...
+  serPrintf("t=%lu ms temp=%d.%02u C state=0x%04X %s\r\n",
+            (unsigned long) t_ms, temp / 100, (unsigned)(temp % 100), state, name);
+  ...
+}
+  @endverbatim
+ ************************************************************************/
+int16_t serPrintf(const char *fmt, ...)
+{   va_list ap;
+    int16_t n;
+
+    va_start(ap, fmt);
+    n = serVprintf(fmt, ap);
+    va_end(ap);
+    return n;
 }
 
 
@@ -213,13 +1033,14 @@ int main(void)
   @endverbatim
  ************************************************************************/
 void serOutUint8Bin(uint8_t x)
-{   uint8_t i;
+{   char buf[11] = " 0b";  // Praefix fuer Binaerzahl ist 0b
+    uint8_t i;
 
-    serPuts(" 0b");  // Praefix fuer Binaerzahl ist 0b
     for(i=0; i<8; i++)
-    {   serPutc((x>>7) + '0');
+    {   buf[3+i] = (char)((x>>7) + '0');
         x <<= 1;
     }
+    serWrite(buf, sizeof(buf));
 }
 
 
@@ -254,14 +1075,7 @@ int main(void)
  ************************************************************************/
 void serOutUint8Hex(uint8_t x)
 {
-    uint8_t y = x >> 4;
-
-    serPuts(" 0x");  // Hex Praefix ist 0x
-    if( (y) < 10) serPutc(y+0x30);  // high nibble
-    else          serPutc(y+0x37);
-    y = x & 0x0f;
-    if( (y) < 10) serPutc(y+0x30);  // low nibble
-    else          serPutc(y+0x37);
+    _outHex(x, 2);
 }
 
 
@@ -269,9 +1083,8 @@ void serOutUint8Hex(uint8_t x)
  **********************************************************************
  * @par Beschreibung:
  *   Ausgabe einer vorzeichenlosen 16 Bit Zahl im Dezimalsystem. Die
- *   Funktion wandelt ins Dezimalsystem mit Hilfe des Division und
- *   Modulo Algorithmus. Die Zeichen werden intern auf einem Stack
- *   gespeichert, um sie in umgekehrter Reihenfolge ausgeben zu koennen.
+ *   Ziffern erzeugt _fmtUint32Dec() paarweise, die ganze Zahl wird
+ *   mit einem einzigen serWrite() ausgegeben.
  *
  * @see
  * @arg serOutInt16Dec(), serOutUint8Hex()
@@ -294,17 +1107,8 @@ int main(void)
   @endverbatim
  ************************************************************************/
 void serOutUint16Dec(uint16_t x)
-{   unsigned char letter[5];
-    int16_t n=0, i;
-
-    serPutc(' ');
-    do
-    {   letter[n++] = (x % 10) + 0x30;
-        x /= 10;
-    } while(x != 0);
-    for(i=n-1; i>=0; i--)
-    {   serPutc(letter[i]); // Ausgabe in umgekehrter Reihenfolge
-    }
+{
+    _outDec(x, 0);
 }
 
 
@@ -335,23 +1139,7 @@ int main(void)
  ************************************************************************/
 void serOutUint16Hex(uint16_t x)
 {
-    uint16_t y = x >> 12;
-
-    serPuts(" 0x");  // Hex Praefix ist 0x
-    if( y < 10) serPutc(y+0x30);   // Bits 15..12
-    else        serPutc(y+0x37);
-
-    y = (x>>8) & 0xF;
-    if( y < 10) serPutc(y+0x30);  // Bits 11..8
-    else        serPutc(y+0x37);
-
-    y = (x>>4) & 0xF;
-    if( y < 10) serPutc(y+0x30);  // Bits 7..4
-    else        serPutc(y+0x37);
-
-    y = x & 0xF;
-    if(y < 10) serPutc(y+0x30);   // Bits 3..0
-    else       serPutc(y+0x37);
+    _outHex(x, 4);
 }
 
 
@@ -364,9 +1152,8 @@ void serOutUint16Hex(uint16_t x)
  **********************************************************************
  * @par Beschreibung:
  *   Ausgabe einer 16 Bit Zahl mit Vorzeichen im Dezimalsystem. Die
- *   Funktion wandelt ins Dezimalsystem mit Hilfe des Division und
- *   Modulo Algorithmus. Die Zeichen werden intern auf einem Stack
- *   gespeichert, um sie in umgekehrter Reihenfolge ausgeben zu koennen.
+ *   Ziffern erzeugt _fmtUint32Dec() paarweise, die ganze Zahl wird
+ *   mit einem einzigen serWrite() ausgegeben.
  *
  * @see
  * @arg
@@ -389,23 +1176,8 @@ int main(void)
   @endverbatim
  ************************************************************************/
 void serOutInt16Dec(int16_t y)
-{   unsigned char letter[5];
-    int16_t n=0, i;
-    int32_t x;
-
-    x = y;
-    serPutc(' ');
-    if(x<0)
-    {   serPutc('-');
-        x = -x;
-    }
-    do
-    {   letter[n++] = (x % 10) + 0x30;
-        x /= 10;
-    } while(x != 0);
-    for(i=n-1; i>=0; i--)
-    {   serPutc(letter[i]); // Ausgabe in umgekehrter Reihenfolge
-    }
+{
+    serOutInt32Dec(y);
 }
 
 
@@ -416,9 +1188,8 @@ void serOutInt16Dec(int16_t y)
  **********************************************************************
  * @par Beschreibung:
  *   Ausgabe einer vorzeichenlosen 32 Bit Zahl im Dezimalsystem. Die
- *   Funktion wandelt ins Dezimalsystem mit Hilfe des Division und
- *   Modulo Algorithmus. Die Zeichen werden intern auf einem Stack
- *   gespeichert, um sie in umgekehrter Reihenfolge ausgeben zu koennen.
+ *   Ziffern erzeugt _fmtUint32Dec() paarweise, die ganze Zahl wird
+ *   mit einem einzigen serWrite() ausgegeben.
  *
  * @see
  * @arg serOutInt16Dec(), serOutUint32Hex()
@@ -441,17 +1212,8 @@ int main(void)
   @endverbatim
  ************************************************************************/
 void serOutUint32Dec(uint32_t x)
-{   unsigned char letter[10];
-    int16_t n=0, i;
-
-    serPutc(' ');
-    do
-    {   letter[n++] = (x % 10) + 0x30;
-        x /= 10;
-    } while(x != 0);
-    for(i=n-1; i>=0; i--)
-    {   serPutc(letter[i]); // Ausgabe in umgekehrter Reihenfolge
-    }
+{
+    _outDec(x, 0);
 }
 
 
@@ -484,39 +1246,7 @@ int main(void)
  ************************************************************************/
 void serOutUint32Hex(uint32_t x)
 {
-    uint32_t y = x >> 28;
-
-    serPuts(" 0x");  // Hex Praefix ist 0x
-    if( y < 10) serPutc(y+0x30);   // Bits 31..28
-    else        serPutc(y+0x37);
-
-    y = (x>>24) & 0xF;
-    if( y < 10) serPutc(y+0x30);   // Bits 27..24
-    else        serPutc(y+0x37);
-
-    y = (x>>20) & 0xF;
-    if( y < 10) serPutc(y+0x30);   // Bits 23..20
-    else        serPutc(y+0x37);
-
-    y = (x>>16) & 0xF;
-    if( y < 10) serPutc(y+0x30);   // Bits 19..16
-    else        serPutc(y+0x37);
-
-    y = (x>>12) & 0xF;
-    if( y < 10) serPutc(y+0x30);   // Bits 15..12
-    else        serPutc(y+0x37);
-
-    y = (x>>8) & 0xF;
-    if( y < 10) serPutc(y+0x30);  // Bits 11..8
-    else        serPutc(y+0x37);
-
-    y = (x>>4) & 0xF;
-    if( y < 10) serPutc(y+0x30);  // Bits 7..4
-    else        serPutc(y+0x37);
-
-    y = x & 0xF;
-    if(y < 10) serPutc(y+0x30);   // Bits 3..0
-    else       serPutc(y+0x37);
+    _outHex(x, 8);
 }
 
 
@@ -529,9 +1259,8 @@ void serOutUint32Hex(uint32_t x)
  **********************************************************************
  * @par Beschreibung:
  *   Ausgabe einer 32 Bit Zahl mit Vorzeichen im Dezimalsystem. Die
- *   Funktion wandelt ins Dezimalsystem mit Hilfe des Division und
- *   Modulo Algorithmus. Die Zeichen werden intern auf einem Stack
- *   gespeichert, um sie in umgekehrter Reihenfolge ausgeben zu koennen.
+ *   Ziffern erzeugt _fmtUint32Dec() paarweise, die ganze Zahl wird
+ *   mit einem einzigen serWrite() ausgegeben.
  *
  * @see
  * @arg
@@ -554,22 +1283,12 @@ int main(void)
   @endverbatim
  ************************************************************************/
 void serOutInt32Dec(int32_t y)
-{   unsigned char letter[10];
-    int16_t n=0, i;
-    int32_t x;
-
-    x = y;
-    serPutc(' ');
-    if(x<0)
-    {   serPutc('-');
-        x = -x;
+{
+    if(y < 0)
+    {   _outDec((uint32_t)0 - (uint32_t)y, '-');  // auch fuer -2147483648
     }
-    do
-    {   letter[n++] = (x % 10) + 0x30;
-        x /= 10;
-    } while(x != 0);
-    for(i=n-1; i>=0; i--)
-    {   serPutc(letter[i]); // Ausgabe in umgekehrter Reihenfolge
+    else
+    {   _outDec((uint32_t)y, 0);
     }
 }
 
@@ -592,6 +1311,10 @@ void serOutInt32Dec(int32_t y)
  *
  * @retval                - das empfangene Zeichen (8 Bit)
  *
+ * POSIX: am Ende der Eingabe (EOF, z.B. "< /dev/null") blockiert
+ * serGetc() nicht, sondern liefert CR (0x0D), damit serGets() und
+ * serIn...() enden; serEof() liefert dann 1.
+ *
  * @par Beispiel :
  * @verbatim
 
@@ -608,7 +1331,18 @@ int main(void)
 uint8_t serGetc(void)
 {   uint8_t x;
 
+#if COS_SER_TX_BUFFER > 0
+    serTxFlush();  // Ausgabe (z.B. Prompt) vor dem Warten senden
+#endif
+#if COS_PLATFORM == PLATFORM_POSIX
+    int16_t c = _posixReadByte(-1);
+    if(c < 0)
+    {   return 0x0D;  // Ende der Eingabe: beendet serGets(), siehe serEof()
+    }
+    x = (uint8_t) c;
+#else
     x=getchar();
+#endif
     #if SER_ECHO
         serPutc(x);               // gerade gelesenes Byte als Echo senden
     #endif
@@ -646,7 +1380,11 @@ int main(void)
 int16_t serPollc(void)
 {   int16_t x=0;
 
+#if COS_PLATFORM == PLATFORM_POSIX
+    x = _posixReadByte(0);
+#else
     x = _pollSerialInterface();  // siehe read.c
+#endif
 
     #if SER_ECHO
         if(x>=0) serPutc(x);  // gerade gelesenes Byte als Echo senden
@@ -655,16 +1393,36 @@ int16_t serPollc(void)
 }
 
 
+/*!
+ **********************************************************************
+ * @par Description:
+ *   Tells, whether the input has ended. Only on POSIX, where stdin may
+ *   be a file or a pipe: serGetc() then returns CR, serPollc() -1.
+ *
+ * @retval   1 after the end of input, 0 otherwise
+ ************************************************************************/
+int8_t serEof(void)
+{
+#if COS_PLATFORM == PLATFORM_POSIX
+    return (int8_t) inputEof_g;
+#else
+    return 0;
+#endif
+}
+
+
 /*!
  **********************************************************************
  * @par Beschreibung:
  *   Liest einen String von der seriellen Schnittstelle. Das Terminalprogramm
  *   muss die Eingabe mit CR abschliessen. Die Funktion liest blockierend, bis ein
  *   CR empfangen wird. Alle Zeichen, ausser CR werden in die Zeichenkette pt kopiert,
- *   am Ende wird '\0' eingetragen.
+ *   am Ende wird '\0' eingetragen. Waehrend des Wartens laufen keine Tasks,
+ *   im laufenden Scheduler liest der Line Reader (cos_line_reader.h) Zeilen
+ *   ohne zu blockieren.
  *
  * @see
- * @arg  serGetc()
+ * @arg  serGetc(), COS_LineReaderBlockingRead()
  *
  *
  * @param    Zeiger auf den String
@@ -888,7 +1646,7 @@ int8_t serInUint16Hex(uint16_t *x)
 
 #endif // COS_PLATFORM
 /**************************************************************************
-*   END OF:    Renesas RX63N Verion                                       *
+*   END OF:    Renesas RX63N and POSIX Verion                             *
 **************************************************************************/
 
 
@@ -963,6 +1721,44 @@ void serPuts(char *pt)
 
 
 
+/*!
+ **********************************************************************
+ * @par Description:
+ *   Empty function provided for compatibility, on openCM use 'SerialUSB' instead.
+ ************************************************************************/
+void serWrite(const char *data, uint16_t len)
+{
+}
+
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ *   Empty function provided for compatibility, on openCM use 'SerialUSB' instead.
+ ************************************************************************/
+int16_t serVprintf(const char *fmt, va_list ap)
+{
+    return 0;
+}
+
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ *   Empty function provided for compatibility, on openCM use 'SerialUSB' instead.
+ ************************************************************************/
+int16_t serPrintf(const char *fmt, ...)
+{
+    return 0;
+}
+
+
+
+
 /*!
  **********************************************************************
  * @par Description
@@ -1244,6 +2040,16 @@ int16_t serPollc(void)
 }
 
 
+/*!
+ **********************************************************************
+ * @par Description:
+ *   Empty function provided for compatibility, the input never ends.
+ ************************************************************************/
+int8_t serEof(void)
+{   return 0;
+}
+
+
 /*!
  **********************************************************************
  * @par Beschreibung:
@@ -12,6 +12,10 @@
  * 0.0  04.12.2008  E. Forgber        - First Version
  * 0.1  20.03.2013  E. Forgber        Dokumentation auf Deutsch umgestellt
  * 0.2  09.10.2015  E. Forgber        switch to renesas controller
+ * 0.3  18.10.2026  E. Forgber        buffered, non-blocking output
+ * 0.4  18.10.2026  E. Forgber        serWrite(), serPrintf()
+ * 0.5  18.10.2026  E. Forgber        serEof()
+ * 0.6  18.10.2026  E. Forgber        SER_TX_BULK_BEGIN(), SER_TX_BULK_END()
  *
  *   @endverbatim
  ****************************************************************************/
@@ -33,15 +37,15 @@ This program is free software: you can redistribute it and/or modify
     You should have received a copy of the GNU General Public License
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
-    Dieses Programm ist Freie Software: Sie knnen es unter den Bedingungen
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
     der GNU General Public License, wie von der Free Software Foundation,
     Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
-    verffentlichten Version, weiterverbreiten und/oder modifizieren.
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
 
-    Dieses Programm wird in der Hoffnung, dass es ntzlich sein wird, aber
-    OHNE JEDE GEWHRLEISTUNG, bereitgestellt; sogar ohne die implizite
-    Gewhrleistung der MARKTFHIGKEIT oder EIGNUNG FR EINEN BESTIMMTEN ZWECK.
-    Siehe die GNU General Public License fr weitere Details.
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
 
     Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
     Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
@@ -56,6 +60,7 @@ This program is free software: you can redistribute it and/or modify
 #include "cos_configure.h"
 
 #include "cos_types.h"
+#include <stdarg.h>
 
 #if COS_PLATFORM == PLATFORM_RENESAS_RX63N
     #include "poll_serial_interface.h"
@@ -66,6 +71,9 @@ This program is free software: you can redistribute it and/or modify
 void serInit(uint32_t baudRate);
 void serPutc(char x);
 void serPuts(char *pt);
+void serWrite(const char *data, uint16_t len);
+int16_t serPrintf(const char *fmt, ...);
+int16_t serVprintf(const char *fmt, va_list ap);
 
 void serOutUint8Bin(uint8_t x);
 void serOutUint8Hex(uint8_t x);
@@ -79,8 +87,72 @@ void serOutUint32Hex(uint32_t x);
 void serOutInt32Dec(int32_t x);
 
 
+#if ((COS_PLATFORM == PLATFORM_RENESAS_RX63N) || (COS_PLATFORM == PLATFORM_POSIX)) && (COS_SER_TX_BUFFER > 0)
+/* reaction of serPutc() to a full TX buffer, see serTxSetPolicy() */
+#define SER_TX_DROP   0  /*!< drop the byte and count it */
+#define SER_TX_BLOCK  1  /*!< wait until the UART has taken a byte */
+
+struct CosTask_t;
+
+/*! counters of the TX buffer, see serTxGetStats() */
+typedef struct
+{   uint32_t written;    /*!< bytes put into the buffer */
+    uint32_t dropped;    /*!< bytes lost, buffer full, SER_TX_DROP */
+    uint32_t waited;     /*!< bytes that waited for the UART, SER_TX_BLOCK */
+    uint16_t peakUsed;   /*!< high-water mark of the buffer */
+} CosSerTxStats_t;
+
+int8_t   serTxStart(uint8_t prio);
+void     serTxSetPolicy(uint8_t policy);
+void     serTxSetKick(void (*kick)(void));
+int16_t  serTxGetByte(void);
+uint16_t serTxFree(void);
+void     serTxFlush(void);
+void     serTxBulkBegin(void);
+void     serTxBulkEnd(void);
+void     serTxGetStats(CosSerTxStats_t *stats);
+int8_t   _serTxMustWait(struct CosTask_t *pt, uint16_t n);
+
+/*!
+ **********************************************************************
+ * @par Description:
+ *   Co-operative wait for free space in the TX buffer: if less than n
+ *   bytes are free, the task blocks and other tasks run, until the
+ *   drain task has sent half of the buffer. Then n bytes may be written
+ *   without loss and without waiting for the UART. Needs the drain task
+ *   of serTxStart(), n is limited to COS_SER_TX_BUFFER.
+ *
+ * @par Macro parameters: (CosTask_t *pt, uint16_t n)
+ *
+ * @par Example :
+ * @verbatim
+void Task_Log(CosTask_t *pt)
+{   COS_TASK_BEGIN(pt);
+    while(1)
+    {   SER_TX_WAIT(pt, 40);
+        serPuts("temperature:"); serOutInt16Dec(readTemp()); serPuts("\r\n");
+        COS_TASK_SLEEP(pt,_milliSecToTicks(100));
+    }
+    COS_TASK_END(pt);
+}
+  @endverbatim
+ ************************************************************************/
+#define SER_TX_WAIT(pt, n)  (pt)->lineCnt=__LINE__;\
+                            case __LINE__:\
+                            if(_serTxMustWait((pt), (n))) return
+
+/* output of many lines by a function, e.g. COS_TraceDump(), see serTxBulkBegin() */
+#define SER_TX_BULK_BEGIN()  serTxBulkBegin()  /*!< bytes are not dropped from here ... */
+#define SER_TX_BULK_END()    serTxBulkEnd()    /*!< ... to here */
+#else
+#define SER_TX_BULK_BEGIN()  /*!< unbuffered output is never dropped */
+#define SER_TX_BULK_END()    /*!< unbuffered output is never dropped */
+#endif
+
+
 uint8_t serGetc(void);
 int16_t serPollc(void);
+int8_t  serEof(void);
 uint8_t serGets(char *pt);
 int8_t serInUint16Dec(uint16_t *x);
 int8_t serInInt16Dec(int16_t *x);
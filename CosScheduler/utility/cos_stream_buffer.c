@@ -0,0 +1,449 @@
+/*!
+ ********************************************************************
+   @file            cos_stream_buffer.c
+   @par Project   : co-operative scheduler (COS)
+   @par Module    : Stream buffer for byte streams
+
+   @brief  Stream buffer for COS. Writers store bytes in a ring buffer,
+          the single reader task wakes up at a trigger level or after a
+          timeout and reads all available bytes as one block.
+
+   @par Author    : Ernst Forgber (Fgb)
+   @par Company   : Hochschule Hannover - University of Applied Sciences and Arts, Germany
+   @par Department: Faculty 1
+ ********************************************************************
+
+   @par History   :
+   @verbatim
+   Version | Date        | Author | Change Description
+   0.0     | 18.10. 2026 | Fgb    | First Version
+   0.1     | 18.10. 2026 | Fgb    | buffer from _memAlloc()
+   0.2     | 18.10. 2026 | Fgb    | reader woken by _setTaskReady()
+   @endverbatim
+
+ ********************************************************************/
+/**************************************************************************
+
+Copyright 2026 Ernst Forgber
+
+
+This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+
+
+
+#include <stdlib.h>
+#include <string.h>  // for memcpy()
+#include "cos_ser.h"
+#include "cos_stream_buffer.h"
+#include "cos_memory.h"
+
+
+
+
+/*------------- DEBUGGING ---------------------------------*/
+#define DEBUG_MODULE 0  /*!< 0 for no additional debug code, 1 otherwise */
+
+#if DEBUG_MODULE
+  #define DebugCode( code_fragment ) { code_fragment } /*!< for debugging only: insert some code */
+#else
+  #define DebugCode( code_fragment ) /*!< for debugging only: insert some code */
+#endif
+
+#if DEBUG_MODULE
+static void _msg(char *msg)
+{
+    DebugCode(serPuts(msg););
+}
+#endif
+/*---------------------------------------------------------------*/
+
+
+
+/****************************************************************/
+/* private functions */
+/****************************************************************/
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Wakes up the waiting reader, if the trigger level is reached.
+ ************************************************************************/
+static void _wakeUpReader(CosStreamBuffer_t *sb)
+{ CosTask_t *task_pt = sb->reader_pt;
+
+  if((task_pt != NULL) && (sb->usedBytes >= sb->triggerLevel))
+  { task_pt->sleepTime_Ticks = 0;           /* end of timeout */
+    _setTaskReady(task_pt);                 /* if waiting forever */
+    sb->reader_pt = NULL;
+  }
+}
+
+
+
+
+/****************************************************************/
+/* exported module functions */
+/****************************************************************/
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * This function creates a stream buffer of 'size' bytes. The reader
+ * is woken up, when 'triggerLevel' bytes are available.
+ *
+ * @see
+ * @arg  COS_StreamBufferDestroy(), COS_StreamBufferSetTriggerLevel()
+ *
+ *
+ * @param  sb              - IN/OUT, pointer to stream buffer struct
+ * @param  size            - IN, size of buffer in bytes (1..65535)
+ * @param  triggerLevel    - IN, number of bytes to wake up the reader (1..size)
+ *
+ * @retval 0               - no error
+ * @retval negative        - an error occurrred
+ *
+ * @par Code example:
+ * @verbatim
+CosStreamBuffer_t rxStream;
+
+int main(void)
+{
+  ...
+  if(0!= COS_StreamBufferCreate(&rxStream, 128, 16))
+    serPuts("error creating stream buffer");
+  ...
+  COS_StreamBufferDestroy(&rxStream);
+  ...
+  return 0;
+}
+  @endverbatim
+ ************************************************************************/
+int8_t COS_StreamBufferCreate(CosStreamBuffer_t *sb, uint16_t size, uint16_t triggerLevel)
+{
+  if((size == 0) || (triggerLevel == 0) || (triggerLevel > size))
+  { DebugCode(_msg("StreamBufferCreate:size!"););
+    return -1;
+  }
+  sb->buffer = (char *) _memAlloc(size * sizeof(char));
+  if(NULL == sb->buffer)
+  { DebugCode(_msg("StreamBufferCreate:malloc!"););
+    return -1;
+  }
+  sb->size         = size;
+  sb->rIndex       = 0;         /* empty buffer */
+  sb->wIndex       = 0;
+  sb->usedBytes    = 0;
+  sb->triggerLevel = triggerLevel;
+  sb->reader_pt    = NULL;
+  sb->isInitialized = 1;
+  return 0;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * This function deletes a stream buffer and frees its memory. A
+ * waiting reader is released.
+ *
+ * @see
+ * @arg  COS_StreamBufferCreate()
+ *
+ *
+ * @param  sb              - IN/OUT, pointer to stream buffer struct
+ *
+ * @retval 0               - no error
+ * @retval negative        - an error occurred
+ ************************************************************************/
+int8_t COS_StreamBufferDestroy(CosStreamBuffer_t *sb)
+{
+  if(sb->isInitialized == 0)
+  { DebugCode(_msg("StreamBufferDestroy:not init."););
+    return -1;
+  }
+  sb->usedBytes = 0;
+  if(sb->reader_pt != NULL)
+  { sb->triggerLevel = 0;
+    _wakeUpReader(sb);  /* reader will find 0 bytes */
+  }
+  if(sb->buffer != NULL)
+  { _memFree(sb->buffer, sb->size * sizeof(char));
+    sb->buffer = NULL;
+  }
+  sb->isInitialized = 0;
+  return 0;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * This function changes the trigger level. If the new level is
+ * already reached, a waiting reader is woken up.
+ *
+ * @param  sb              - IN/OUT, pointer to stream buffer struct
+ * @param  triggerLevel    - IN, number of bytes to wake up the reader (1..size)
+ *
+ * @retval 0               - no error
+ * @retval negative        - an error occurred
+ ************************************************************************/
+int8_t COS_StreamBufferSetTriggerLevel(CosStreamBuffer_t *sb, uint16_t triggerLevel)
+{
+  if(sb->isInitialized == 0)
+  { DebugCode(_msg("StreamBufferSetTriggerLevel:not init"););
+    return -1;
+  }
+  if((triggerLevel == 0) || (triggerLevel > sb->size))
+  { DebugCode(_msg("StreamBufferSetTriggerLevel:level!"););
+    return -1;
+  }
+  sb->triggerLevel = triggerLevel;
+  _wakeUpReader(sb);
+  return 0;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * This function checks if a stream buffer is empty.
+ *
+ * @param  sb              - IN/OUT, pointer to stream buffer struct
+ *
+ * @retval 0               - buffer not empty
+ * @retval 1               - buffer empty
+ * @retval negative        - error
+ ************************************************************************/
+int8_t COS_StreamBufferIsEmpty(CosStreamBuffer_t *sb)
+{
+  if(sb->isInitialized == 0)
+  { DebugCode(_msg("StreamBufferIsEmpty:not init"););
+    return -1;
+  }
+  return (sb->usedBytes == 0) ? 1 : 0;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * This function returns the number of bytes in the buffer.
+ *
+ * @param  sb              - IN/OUT, pointer to stream buffer struct
+ *
+ * @retval number of used bytes
+ ************************************************************************/
+uint16_t COS_StreamBufferGetUsedBytes(CosStreamBuffer_t *sb)
+{   return sb->usedBytes;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * This function returns the number of free bytes.
+ *
+ * @param  sb              - IN/OUT, pointer to stream buffer struct
+ *
+ * @retval number of free bytes
+ ************************************************************************/
+uint16_t COS_StreamBufferGetFreeBytes(CosStreamBuffer_t *sb)
+{   return sb->size - sb->usedBytes;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * This function stores up to 'len' bytes in the stream buffer, it never
+ * blocks. Bytes that do not fit are not stored. If the trigger level
+ * is reached, the waiting reader is woken up.
+ *
+ * @see
+ * @arg  COS_StreamBufferPutc(), COS_StreamBufferBlockingRead()
+ *
+ * @param  sb              - IN/OUT, pointer to stream buffer struct
+ * @param  data            - IN, pointer to bytes
+ * @param  len             - IN, number of bytes
+ *
+ * @retval number of bytes stored
+ ************************************************************************/
+uint16_t COS_StreamBufferWrite(CosStreamBuffer_t *sb, const char *data, uint16_t len)
+{ uint16_t first;
+
+  if(sb->isInitialized == 0)
+  { DebugCode(_msg("StreamBufferWrite:not init"););
+    return 0;
+  }
+  if(len > sb->size - sb->usedBytes)
+  { len = sb->size - sb->usedBytes;  /* store what fits */
+  }
+  first = sb->size - sb->wIndex;     /* bytes up to the end of the buffer */
+  if(len <= first)
+  { memcpy(&(sb->buffer[sb->wIndex]), data, len);
+  }
+  else
+  { memcpy(&(sb->buffer[sb->wIndex]), data, first);
+    memcpy(sb->buffer, data + first, len - first);  /* wrap around */
+  }
+  sb->wIndex += len;
+  if(sb->wIndex >= sb->size) sb->wIndex -= sb->size;
+  sb->usedBytes += len;
+  _wakeUpReader(sb);
+  return len;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * This function stores a single byte in the stream buffer, it never
+ * blocks. If the trigger level is reached, the waiting reader is
+ * woken up.
+ *
+ * @see
+ * @arg  COS_StreamBufferWrite(), COS_StreamBufferBlockingRead()
+ *
+ * @param  sb              - IN/OUT, pointer to stream buffer struct
+ * @param  c               - IN, byte to be stored
+ *
+ * @retval 0               - no error
+ * @retval negative        - buffer full or not initialized
+ ************************************************************************/
+int8_t COS_StreamBufferPutc(CosStreamBuffer_t *sb, char c)
+{
+  if((sb->isInitialized == 0) || (sb->usedBytes >= sb->size))
+  { return -1;
+  }
+  sb->buffer[sb->wIndex] = c;
+  sb->wIndex++;
+  if(sb->wIndex >= sb->size) sb->wIndex = 0;
+  sb->usedBytes++;
+  _wakeUpReader(sb);
+  return 0;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * This function reads up to 'maxLen' bytes without blocking. The
+ * trigger level is not regarded.
+ *
+ * @see
+ * @arg  COS_StreamBufferBlockingRead()
+ *
+ * @param  sb              - IN/OUT, pointer to stream buffer struct
+ * @param  data            - OUT, pointer to data buffer
+ * @param  maxLen          - IN, size of data buffer in bytes
+ *
+ * @retval number of bytes read
+ ************************************************************************/
+uint16_t COS_StreamBufferTryRead(CosStreamBuffer_t *sb, char *data, uint16_t maxLen)
+{ uint16_t len, first;
+
+  if(sb->isInitialized == 0)
+  { DebugCode(_msg("StreamBufferTryRead:not init"););
+    return 0;
+  }
+  len = (maxLen < sb->usedBytes) ? maxLen : sb->usedBytes;
+  first = sb->size - sb->rIndex;     /* bytes up to the end of the buffer */
+  if(len <= first)
+  { memcpy(data, &(sb->buffer[sb->rIndex]), len);
+  }
+  else
+  { memcpy(data, &(sb->buffer[sb->rIndex]), first);
+    memcpy(data + first, sb->buffer, len - first);  /* wrap around */
+  }
+  sb->rIndex += len;
+  if(sb->rIndex >= sb->size) sb->rIndex -= sb->size;
+  sb->usedBytes -= len;
+  return len;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * PLEASE NOTE: This function is for internal use only! It is called by
+ * COS_StreamBufferBlockingRead(). If the trigger level is not reached,
+ * the task is registered as reader and its sleep time is set to the
+ * timeout. With COS_SB_WAIT_FOREVER, the task is blocked instead.
+ *
+ * @param  sb              - IN/OUT, pointer to stream buffer struct
+ * @param  pt              - IN/OUT, pointer to task struct
+ * @param  timeout_Ticks   - IN, maximum time to wait
+ *
+ * @retval 1               - task has to wait
+ * @retval 0               - trigger level reached, read immediately
+ ************************************************************************/
+int8_t _sbMustWait(CosStreamBuffer_t *sb, CosTask_t *pt, CosTicks_t timeout_Ticks)
+{
+  if((sb->isInitialized == 0) || (sb->usedBytes >= sb->triggerLevel))
+  { return 0;
+  }
+  sb->reader_pt = pt;
+  if(timeout_Ticks == COS_SB_WAIT_FOREVER)
+  { pt->state = TASK_STATE_BLOCKED;
+  }
+  else
+  { pt->sleepTime_Ticks = timeout_Ticks;
+  }
+  return 1;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * PLEASE NOTE: This function is for internal use only! It is called by
+ * COS_StreamBufferBlockingRead() after the reader has woken up, either
+ * at the trigger level or after the timeout.
+ *
+ * @param  sb              - IN/OUT, pointer to stream buffer struct
+ * @param  data            - OUT, pointer to data buffer
+ * @param  maxLen          - IN, size of data buffer in bytes
+ *
+ * @retval number of bytes read
+ ************************************************************************/
+uint16_t _sbRead(CosStreamBuffer_t *sb, char *data, uint16_t maxLen)
+{
+  sb->reader_pt = NULL;  /* no longer waiting, e.g. after timeout */
+  return COS_StreamBufferTryRead(sb, data, maxLen);
+}
@@ -0,0 +1,204 @@
+/*!
+ ********************************************************************
+   @file            cos_stream_buffer.h
+   @par Project   : co-operative scheduler (COS)
+   @par Module    : Stream buffer for byte streams
+
+   @brief  Stream buffer for COS. A serial line or a protocol delivers
+          single bytes, a FIFO with slots of one byte would cost one
+          semaphore operation and one scheduler pass per byte. The
+          stream buffer collects bytes in a ring buffer and wakes up its
+          reader only, if at least 'triggerLevel' bytes are available
+          or if the reader's timeout has expired. The reader then takes
+          all available bytes as one block.
+
+          A stream buffer has a single reader task, there may be any
+          number of writers. Writing never blocks, bytes that do not fit
+          are not stored. The buffer uses dynamic memory allocation
+          (malloc()).
+
+   @par Author    : Ernst Forgber (Fgb)
+   @par Company   : Hochschule Hannover - University of Applied Sciences and Arts, Germany
+   @par Department: Faculty 1
+ ********************************************************************
+
+   @par History   :
+   @verbatim
+   Version | Date        | Author | Change Description
+   0.0     | 18.10. 2026 | Fgb    | First Version
+   0.1     | 18.10. 2026 | Fgb    | COS_SB_MAX_TIMEOUT, COS_SB_TIMEOUT()
+   @endverbatim
+
+ ********************************************************************/
+/**************************************************************************
+
+Copyright 2026 Ernst Forgber
+
+
+This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+
+
+#ifndef _cos_stream_buffer_h_
+#define _cos_stream_buffer_h_
+
+
+#include "cos_configure.h"
+#include "cos_scheduler.h"
+#include "cos_types.h"
+
+#ifndef NULL
+    #define NULL 0  /*!< the null pointer value */
+#endif
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Timeout values of COS_StreamBufferBlockingRead(). The largest value
+ * of CosTicks_t is reserved for COS_SB_WAIT_FOREVER, the longest finite
+ * timeout is one tick less: 65534 ticks with 16 bit ticks. A timeout
+ * computed at run time should pass through COS_SB_TIMEOUT(), which
+ * clamps it to COS_SB_MAX_TIMEOUT. Otherwise a result of 65535 ticks
+ * would wait forever, e.g. _milliSecToTicks(), which saturates at the
+ * largest value: COS_SB_TIMEOUT(_milliSecToTicks(ms)).
+ ************************************************************************/
+#define COS_SB_WAIT_FOREVER   ((CosTicks_t) -1)  /*!< wait for the trigger level without time limit */
+#define COS_SB_MAX_TIMEOUT    ((CosTicks_t) -2)  /*!< longest finite timeout */
+#define COS_SB_TIMEOUT(t)     (((uint32_t)(t) >= (uint32_t) COS_SB_MAX_TIMEOUT) ? COS_SB_MAX_TIMEOUT : (CosTicks_t)(t))
+
+
+/*!
+ ********************************************************************
+  @par Description
+  Stream buffer data structure. The buffer is used as ring buffer of
+  bytes.
+********************************************************************/
+typedef struct                 /*! stream buffer data structure */
+{
+        char *buffer;          /*!< ring buffer of bytes */
+        uint16_t size;         /*!< size of buffer in bytes */
+        uint16_t rIndex;       /*!< index of the next byte to read */
+        uint16_t wIndex;       /*!< index of the next byte to write */
+        uint16_t usedBytes;    /*!< number of bytes in the buffer */
+        uint16_t triggerLevel; /*!< reader wakes up at this number of bytes */
+        CosTask_t *reader_pt;  /*!< task waiting for data, NULL if none */
+        uint8_t isInitialized; /*!< 0 if not yet initialized */
+} CosStreamBuffer_t;
+
+
+
+int8_t   COS_StreamBufferCreate(CosStreamBuffer_t *sb, uint16_t size, uint16_t triggerLevel);
+int8_t   COS_StreamBufferDestroy(CosStreamBuffer_t *sb);
+int8_t   COS_StreamBufferSetTriggerLevel(CosStreamBuffer_t *sb, uint16_t triggerLevel);
+int8_t   COS_StreamBufferIsEmpty(CosStreamBuffer_t *sb);
+uint16_t COS_StreamBufferGetUsedBytes(CosStreamBuffer_t *sb);
+uint16_t COS_StreamBufferGetFreeBytes(CosStreamBuffer_t *sb);
+uint16_t COS_StreamBufferWrite(CosStreamBuffer_t *sb, const char *data, uint16_t len);
+int8_t   COS_StreamBufferPutc(CosStreamBuffer_t *sb, char c);
+uint16_t COS_StreamBufferTryRead(CosStreamBuffer_t *sb, char *data, uint16_t maxLen);
+
+int8_t   _sbMustWait(CosStreamBuffer_t *sb, CosTask_t *pt, CosTicks_t timeout_Ticks);
+uint16_t _sbRead(CosStreamBuffer_t *sb, char *data, uint16_t maxLen);
+
+
+// blocking Macros
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * This macro reads up to 'maxLen' bytes from the stream buffer. If less
+ * than 'triggerLevel' bytes are available, the task *pt sleeps until
+ * a writer has filled the buffer up to the trigger level, or until
+ * 'timeout_Ticks' have passed. After a timeout, the bytes available are
+ * read, 'len' may be less than the trigger level or even 0.
+ * With timeout COS_SB_WAIT_FOREVER the task is changed to state
+ * TASK_STATE_BLOCKED and waits for the trigger level only. Finite
+ * timeouts are at most COS_SB_MAX_TIMEOUT, see COS_SB_TIMEOUT().
+ * Only one task may read from a stream buffer.
+ *
+ * @see
+ * @arg  COS_StreamBufferWrite(), COS_StreamBufferPutc(), _sbMustWait()
+ *
+ * @par Macro parameters: (CosTask_t *pt, CosStreamBuffer_t *sb, char *data, uint16_t maxLen, CosTicks_t timeout_Ticks, uint16_t len)
+ *
+ * @param  pt              - IN/OUT, pointer to task struct
+ * @param  sb              - IN/OUT, pointer to stream buffer struct
+ * @param  data            - OUT, pointer to data buffer
+ * @param  maxLen          - IN, size of data buffer in bytes
+ * @param  timeout_Ticks   - IN, maximum time to wait for the trigger level
+ * @param  len             - OUT, variable for the number of bytes read
+ * @retval void
+ * @par Example :
+ *    A receive task handles blocks of at least 16 bytes, but does not
+ *    keep a few bytes longer than 20 ms:
+ * @verbatim
+CosStreamBuffer_t rxStream;
+
+void Task_Rx(CosTask_t *pt)
+{   static char block[32];
+    static uint16_t len;
+
+    COS_TASK_BEGIN(pt);
+    while(1)
+    {   COS_StreamBufferBlockingRead(pt, &rxStream, block, sizeof(block),
+                                     _milliSecToTicks(20), len);
+        ...
+    }
+    COS_TASK_END(pt);
+}
+
+void Task_Uart(CosTask_t *pt)
+{   COS_TASK_BEGIN(pt);
+    while(1)
+    {   while(byteReceived())
+        {   COS_StreamBufferPutc(&rxStream, readByte());
+        }
+        COS_TASK_SCHEDULE(pt);
+    }
+    COS_TASK_END(pt);
+}
+
+int main(void)
+{ ...
+  COS_InitTaskList();
+  if(0!= COS_StreamBufferCreate(&rxStream, 128, 16))
+    serPuts("error creating stream buffer");
+  ...
+}
+  @endverbatim
+ ************************************************************************/
+#define COS_StreamBufferBlockingRead(pt, sb, data, maxLen, timeout_Ticks, len) \
+                            if(_sbMustWait((sb), (pt), (timeout_Ticks))) { \
+                              (pt)->lineCnt=__LINE__; \
+                              return; \
+                            } \
+                            case __LINE__: \
+                            (len) = _sbRead((sb), (char *)(data), (maxLen))
+
+#endif
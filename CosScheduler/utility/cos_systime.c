@@ -2,10 +2,19 @@
  ********************************************************************
    @file            cos_systime.c
 
-   @brief  This modul provides basic time functions. On Arduino and openCM, use 'millis()' instead
+   @brief  This modul provides basic time functions. Time is measured in
+           ticks of COS_MICROSEC_PER_TICK microseconds.
 
-   For platforms other than Arduino and openCM: Time is measured in ticks.
-   A Timer overflow interrupt is used to increment a tick counter.
+   On Renesas RX63N, a timer interrupt increments a tick counter every
+   millisecond. On openCM, the DWT cycle counter of the Cortex-M3 is
+   used, on Arduino micros(). Both are extended to a tick counter of
+   type CosTicks_t by software. On a POSIX host, clock_gettime() is
+   used.
+
+   With COS_VIRTUAL_TIME, the clock is virtual on every platform: it
+   stands still while tasks run, and the scheduler jumps to the next
+   activation time, when no task is ready. Simulated hours pass in
+   milliseconds and every run gives the same result.
 
    @par Author    : Ernst Forgber (Fgb)
  ********************************************************************
@@ -17,6 +26,10 @@
    0.1     | 01.08. 2013 | Fgb      | bugfix in _milliSecToTicks()
    0.2     | 09.10. 2015 | Fgb      | change to renesas controller RX63N
    0.3     | 11.11. 2016 | Fgb      | openCM compatibility included
+   0.4     | 18.10. 2026 | Fgb      | 32 bit ticks, DWT cycle counter on openCM
+   0.5     | 18.10. 2026 | Fgb      | POSIX version, clock_gettime()
+   0.6     | 18.10. 2026 | Fgb      | virtual time for simulation
+   0.7     | 18.10. 2026 | Fgb      | count the reads of the system time
    @endverbatim
 
  ********************************************************************/
@@ -40,15 +53,15 @@ This program is free software: you can redistribute it and/or modify
     You should have received a copy of the GNU General Public License
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
-    Dieses Programm ist Freie Software: Sie knnen es unter den Bedingungen
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
     der GNU General Public License, wie von der Free Software Foundation,
     Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
-    verffentlichten Version, weiterverbreiten und/oder modifizieren.
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
 
-    Dieses Programm wird in der Hoffnung, dass es ntzlich sein wird, aber
-    OHNE JEDE GEWHRLEISTUNG, bereitgestellt; sogar ohne die implizite
-    Gewhrleistung der MARKTFHIGKEIT oder EIGNUNG FR EINEN BESTIMMTEN ZWECK.
-    Siehe die GNU General Public License fr weitere Details.
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
 
     Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
     Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
@@ -58,15 +71,41 @@ This program is free software: you can redistribute it and/or modify
 
 
 
+/**************************************************************************
+*      all platforms                                                      *
+**************************************************************************/
+#if COS_SCHEDULER_COUNTERS
+static uint32_t timeReads_g=0; /*!< calls of _gettime_Ticks() */
+  /*! counts a read of the system time */
+  #define COUNT_TIME_READ()  (timeReads_g++)
+
+/*!
+ **********************************************************************
+ * @par Description:
+ *   PLEASE NOTE: This function is for internal use only! Returns the
+ *   number of calls of _gettime_Ticks(), i.e. of reads of the hardware
+ *   clock (micros() on Arduino, the DWT cycle counter on openCM,
+ *   clock_gettime() on POSIX). The counter wraps around.
+ * @retval                - number of reads since start-up
+ ************************************************************************/
+uint32_t _getTimeReads(void)
+{   return timeReads_g;
+}
+/*-------------------------------------------------------*/
+#else
+  #define COUNT_TIME_READ()
+#endif
+
+
+
 /**************************************************************************
 *      Renesas RX63N Verion                                               *
 **************************************************************************/
-#if COS_PLATFORM == PLATFORM_RENESAS_RX63N
+#if (COS_PLATFORM == PLATFORM_RENESAS_RX63N) && !COS_VIRTUAL_TIME
 
 #include "iodefine.h"
 #include "isr.h"
 
-#define MICROSEC_PER_TICK 1000
 
 /************************************************************
  * Debugging section Renesas RX63N:
@@ -110,7 +149,7 @@ static volatile unsigned char _led15_state=0;
 	 * port direction register (PDR)
 	 * des ports d mit 1en belegen,
 	 * d.h. leds an port d als
-	 * ausgänge definieren
+	 * ausgÃ¤nge definieren
 	 */											\
 	PORTD.PDR.BYTE   = 0xFF;					\
 												\
@@ -118,7 +157,7 @@ static volatile unsigned char _led15_state=0;
 	 * port direction register (PDR)
 	 * des ports e mit 1en belegen,
 	 * d.h. leds an port e als
-	 * ausgänge definieren
+	 * ausgÃ¤nge definieren
 	 */											\
 	PORTE.PDR.BYTE  |= 0x0F;					\
 }
@@ -141,7 +180,7 @@ static volatile unsigned char _led15_state=0;
  * static variables
  ****************************************************************/
 
-static volatile uint16_t systemTimeInTicks=0; /*!< private tick counter */
+static volatile CosTicks_t systemTimeInTicks=0; /*!< private tick counter */
 
 
 
@@ -234,113 +273,341 @@ void INT_Excep_CMT0_CMI0(void)
 //-------------------------------------------------------
 
 
-/*!
- **********************************************************************
- * @par Description:
- *   Returns the number of microseconds, that
- *   correspond to a timer tick.
- * @see
- * @arg _initSystemTime()
- *
- * @retval                - Tick-interval in microseconds
-  ************************************************************************/
- uint16_t _microSecPerTick(void)
-{   return MICROSEC_PER_TICK;
-}
-
-/*-------------------------------------------------------*/
-
 /*!
  **********************************************************************
  * @par Description:
  *   Returns the system time in ticks.
  * @retval                - system time in ticks
  ************************************************************************/
- uint16_t _gettime_Ticks(void)
-{   uint16_t t;
+ CosTicks_t _gettime_Ticks(void)
+{   CosTicks_t t;
+    COUNT_TIME_READ();
     //cli();  // deactivate INT, mutex for tick variable, AVR only
     t = systemTimeInTicks;
     //sei(); // aktivate INT, Timer0 ISR may change systemTimeInTicks, AVR only
     return t;
 }
 /*-------------------------------------------------------*/
+
+
+
+
+
+#endif // COS_PLATFORM
+/**************************************************************************
+*   END OF:    Renesas RX63N Verion                                       *
+**************************************************************************/
+
+
+
+/**************************************************************************
+*      openCM9.04  Verion                                                 *
+**************************************************************************/
+/* this part is shared with the Arduino version */
+#if ((COS_PLATFORM == PLATFORM_OPEN_CM_9_04) || (COS_PLATFORM == PLATFORM_ARDUINO)) && !COS_VIRTUAL_TIME
+
+/****************************************************************
+ * static variables
+ ****************************************************************/
+static CosTicks_t systemTimeInTicks=0; /*!< private tick counter */
+static uint32_t lastCount_g=0;         /*!< hardware counter at last call */
+static uint32_t restCount_g=0;         /*!< counts not yet converted to ticks */
+
+
 /*!
  **********************************************************************
  * @par Description:
- *   Given the number of milliseconds, the function returns the corresponding
- *   number of ticks. The constant MICROSEC_PER_TICK has to be set
- *   accordingly.
- *
- * @param  milliSec  - IN, time in milliseconds
+ *   Extends a free running 32 bit hardware counter to the tick counter.
+ *   The counts since the last call are converted to ticks, the rest is
+ *   kept for the next call. The function has to be called at least once
+ *   per turn-around of the hardware counter, the scheduler does so
+ *   continuously.
  *
- * @retval                - time in ticks
+ * @param  count          - IN, current value of the hardware counter
+ * @param  countsPerTick  - IN, counts per tick
  *
+ * @retval                - system time in ticks
  ************************************************************************/
- uint16_t _milliSecToTicks(uint16_t milliSec)
-{   uint32_t t_ms;
-
-    t_ms = ((uint32_t) milliSec*1000)/MICROSEC_PER_TICK;
-    if (t_ms<1) t_ms=1;
-    return ((uint16_t) t_ms);
+static CosTicks_t _countToTicks(uint32_t count, uint32_t countsPerTick)
+{   uint32_t delta;
+
+    delta = (uint32_t)(count - lastCount_g) + restCount_g;  /* wrap around is ok */
+    lastCount_g = count;
+    systemTimeInTicks += (CosTicks_t)(delta / countsPerTick);
+    restCount_g = delta % countsPerTick;
+    return systemTimeInTicks;
 }
 /*-------------------------------------------------------*/
+#endif
 
 
+#if (COS_PLATFORM == PLATFORM_OPEN_CM_9_04) && !COS_VIRTUAL_TIME
 
+/* Data Watchpoint and Trace unit (DWT) of the Cortex-M3 */
+#define SCB_DEMCR           (*(volatile uint32_t *) 0xE000EDFC) /*!< debug exception and monitor control */
+#define DWT_CTRL            (*(volatile uint32_t *) 0xE0001000) /*!< DWT control register */
+#define DWT_CYCCNT          (*(volatile uint32_t *) 0xE0001004) /*!< DWT cycle counter */
+#define DEMCR_TRCENA        (1UL << 24)  /*!< enables the DWT unit */
+#define DWT_CTRL_CYCCNTENA  (1UL << 0)   /*!< enables the cycle counter */
 
-#endif // COS_PLATFORM
-/**************************************************************************
-*   END OF:    Renesas RX63N Verion                                       *
-**************************************************************************/
+/*! CPU cycles per tick */
+#define CYCLES_PER_TICK     ((COS_CPU_CLOCK_HZ / 1000000UL) * COS_MICROSEC_PER_TICK)
 
+/*!
+ **********************************************************************
+ * @par Description:
+ *   Starts the cycle counter of the DWT unit, which counts the CPU
+ *   clock. With 72 MHz, the counter turns around every 59 seconds, it is
+ *   extended to the tick counter by _gettime_Ticks().
+ ************************************************************************/
+void _initSystemTime(void)
+{   SCB_DEMCR  |= DEMCR_TRCENA;
+    DWT_CYCCNT  = 0;
+    DWT_CTRL   |= DWT_CTRL_CYCCNTENA;
+    lastCount_g = 0;
+    restCount_g = 0;
+}
+/*-------------------------------------------------------*/
 
+/*!
+ **********************************************************************
+ * @par Description:
+ *   Returns the system time in ticks, derived from the DWT cycle
+ *   counter.
+ * @retval                - system time in ticks
+ ************************************************************************/
+CosTicks_t _gettime_Ticks(void)
+{   COUNT_TIME_READ();
+    return _countToTicks(DWT_CYCCNT, CYCLES_PER_TICK);
+}
+/*-------------------------------------------------------*/
 
+#endif
 /**************************************************************************
-*      openCM9.04  Verion                                                 *
+*   END OF:    openCM9.04  Verion                                         *
 **************************************************************************/
 
-#if COS_PLATFORM == PLATFORM_OPEN_CM_9_04
 
-/*********************************************************************
-*  these function are empty and provided for compatibility. On openCM9.04
-*  use 'millis()' instead!
-*************************************************************************/
+/**************************************************************************
+*      Arduino Verion                                                     *
+**************************************************************************/
+#if (COS_PLATFORM == PLATFORM_ARDUINO) && !COS_VIRTUAL_TIME
+
+extern unsigned long micros(void);  /* Arduino core library */
 
 /*!
  ********************************************************************
   @par Description
-  On platforms Arduino and openCM, this function is empty and
-  provided for compatibility only.
+  On Arduino, the system time is derived from micros(). This function
+  is provided for compatibility only.
  ********************************************************************/
-void     _initSystemTime(void){ return; }
+void _initSystemTime(void)
+{   lastCount_g = (uint32_t) micros();
+    restCount_g = 0;
+}
+/*-------------------------------------------------------*/
 
 /*!
- ********************************************************************
-  @par Description
-  On platforms Arduino and openCM, this function provided for
-  compatibility only. On these platforms, a tick is 1000 microseconds.
- ********************************************************************/
-uint16_t _microSecPerTick(void){ return 1000; }
+ **********************************************************************
+ * @par Description:
+ *   Returns the system time in ticks, derived from micros().
+ * @retval                - system time in ticks
+ ************************************************************************/
+CosTicks_t _gettime_Ticks(void)
+{   COUNT_TIME_READ();
+    return _countToTicks((uint32_t) micros(), COS_MICROSEC_PER_TICK);
+}
+/*-------------------------------------------------------*/
+
+#endif
+/**************************************************************************
+*   END OF:    Arduino Verion                                             *
+**************************************************************************/
+
+
+
+/**************************************************************************
+*      POSIX Verion                                                       *
+**************************************************************************/
+#if (COS_PLATFORM == PLATFORM_POSIX) && !COS_VIRTUAL_TIME
+
+#include <time.h>
+
+static uint64_t startTime_us = 0; /*!< time of _initSystemTime() */
 
 /*!
- ********************************************************************
-  @par Description
-  On platforms Arduino and openCM, this function is empty and
-  provided for compatibility only.
- ********************************************************************/
-uint16_t _gettime_Ticks(void){ return 0; }
+ **********************************************************************
+ * @par Description:
+ *   Returns the monotonic clock of the host in microseconds.
+ ************************************************************************/
+static uint64_t _monotonicMicroSec(void)
+{   struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000ULL + (uint64_t) ts.tv_nsec / 1000ULL;
+}
+/*-------------------------------------------------------*/
 
 /*!
- ********************************************************************
-  @par Description
-  On platforms Arduino and openCM, this function is provided for
-  compatibility only. On these platforms, a tick is 1 millisecond.
- ********************************************************************/
-uint16_t _milliSecToTicks(uint16_t milliSec){ return milliSec; }
+ **********************************************************************
+ * @par Description:
+ *   Sets the system time to 0. On a POSIX host, the monotonic clock
+ *   (clock_gettime()) is used, no timer interrupt is required.
+ ************************************************************************/
+void _initSystemTime(void)
+{   startTime_us = _monotonicMicroSec();
+}
+/*-------------------------------------------------------*/
+
+/*!
+ **********************************************************************
+ * @par Description:
+ *   Returns the system time in ticks since _initSystemTime().
+ * @retval                - system time in ticks
+ ************************************************************************/
+CosTicks_t _gettime_Ticks(void)
+{   COUNT_TIME_READ();
+    return (CosTicks_t)((_monotonicMicroSec() - startTime_us) / COS_MICROSEC_PER_TICK);
+}
+/*-------------------------------------------------------*/
 
 #endif
 /**************************************************************************
-*   END OF:    openCM9.04  Verion                                         *
+*   END OF:    POSIX Verion                                               *
+**************************************************************************/
+
+
+
+/**************************************************************************
+*      virtual time, all platforms                                        *
+**************************************************************************/
+#if COS_VIRTUAL_TIME
+
+static CosTicks_t virtualTime_Ticks = 0; /*!< advanced by the scheduler only */
+
+/*!
+ **********************************************************************
+ * @par Description:
+ *   Sets the virtual system time to 0. No hardware is used.
+ ************************************************************************/
+void _initSystemTime(void)
+{   virtualTime_Ticks = 0;
+}
+/*-------------------------------------------------------*/
+
+/*!
+ **********************************************************************
+ * @par Description:
+ *   Returns the virtual system time in ticks. The time does not
+ *   advance while tasks are running, only the scheduler moves it
+ *   forward, when no task is ready to run.
+ * @retval                - system time in ticks
+ ************************************************************************/
+CosTicks_t _gettime_Ticks(void)
+{   COUNT_TIME_READ();
+    return virtualTime_Ticks;
+}
+/*-------------------------------------------------------*/
+
+/*!
+ **********************************************************************
+ * @par Description:
+ *   Sets the virtual system time. Used by the scheduler to jump to the
+ *   next activation of a task, may be used by a test to simulate the
+ *   run-time of a task function.
+ *
+ * @param  t_Ticks  - IN, new system time in ticks
+ ************************************************************************/
+void _setVirtualTime_Ticks(CosTicks_t t_Ticks)
+{   virtualTime_Ticks = t_Ticks;
+}
+/*-------------------------------------------------------*/
+
+#endif
+/**************************************************************************
+*   END OF:    virtual time                                               *
 **************************************************************************/
 
 
+
+/**************************************************************************
+*      all platforms                                                      *
+**************************************************************************/
+
+/*!
+ **********************************************************************
+ * @par Description:
+ *   Returns the number of microseconds, that
+ *   correspond to a timer tick.
+ * @see
+ * @arg _initSystemTime()
+ *
+ * @retval                - Tick-interval in microseconds
+  ************************************************************************/
+uint16_t _microSecPerTick(void)
+{   return COS_MICROSEC_PER_TICK;
+}
+/*-------------------------------------------------------*/
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ *   Limits a number of ticks to the range of CosTicks_t and to a
+ *   minimum of one tick.
+ ************************************************************************/
+static CosTicks_t _limitTicks(uint32_t t)
+{
+#if !COS_TICKS_32BIT
+    if (t > 0xFFFF) t = 0xFFFF;
+#endif
+    if (t < 1) t = 1;
+    return ((CosTicks_t) t);
+}
+/*-------------------------------------------------------*/
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ *   Given the number of milliseconds, the function returns the corresponding
+ *   number of ticks. The constant COS_MICROSEC_PER_TICK has to be set
+ *   accordingly.
+ *
+ * @param  milliSec  - IN, time in milliseconds
+ *
+ * @retval                - time in ticks
+ *
+ ************************************************************************/
+CosTicks_t _milliSecToTicks(uint32_t milliSec)
+{   uint32_t t;
+
+    if ((milliSec / COS_MICROSEC_PER_TICK) > (0xFFFFFFFFUL / 1000UL))
+    {   t = 0xFFFFFFFFUL;  /* out of range */
+    }
+    else
+    {   /* same as milliSec*1000/COS_MICROSEC_PER_TICK, without overflow */
+        t = (milliSec / COS_MICROSEC_PER_TICK) * 1000UL
+          + ((milliSec % COS_MICROSEC_PER_TICK) * 1000UL) / COS_MICROSEC_PER_TICK;
+    }
+    return _limitTicks(t);
+}
+/*-------------------------------------------------------*/
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ *   Given the number of microseconds, the function returns the
+ *   corresponding number of ticks. Times shorter than a tick are
+ *   rounded up to one tick.
+ *
+ * @param  microSec  - IN, time in microseconds
+ *
+ * @retval                - time in ticks
+ *
+ ************************************************************************/
+CosTicks_t _microSecToTicks(uint32_t microSec)
+{   return _limitTicks(microSec / COS_MICROSEC_PER_TICK);
+}
+/*-------------------------------------------------------*/
@@ -2,7 +2,8 @@
  ********************************************************************
    @file            cos_systime.h
 
-   @brief  This modul provides basic time functions. On Arduino and openCM, use 'millis()' instead
+   @brief  This modul provides basic time functions. Time is measured in
+           ticks of COS_MICROSEC_PER_TICK microseconds, see cos_configure.h.
 
 
 
@@ -18,6 +19,9 @@
    0.0     | 03.04. 2013 | Fgb     | First Version
    0.1     | 08.10. 2015 | Fgb     | change to renesas controller RX63N
    0.2     | 11.11. 2016 | Fgb     | openCM compatibility included
+   0.3     | 18.10. 2026 | Fgb     | 32 bit ticks, microsecond resolution
+   0.4     | 18.10. 2026 | Fgb     | virtual time
+   0.5     | 18.10. 2026 | Fgb     | _getTimeReads()
 
    @endverbatim
 
@@ -40,15 +44,15 @@ This program is free software: you can redistribute it and/or modify
     You should have received a copy of the GNU General Public License
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
-    Dieses Programm ist Freie Software: Sie knnen es unter den Bedingungen
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
     der GNU General Public License, wie von der Free Software Foundation,
     Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
-    verffentlichten Version, weiterverbreiten und/oder modifizieren.
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
 
-    Dieses Programm wird in der Hoffnung, dass es ntzlich sein wird, aber
-    OHNE JEDE GEWHRLEISTUNG, bereitgestellt; sogar ohne die implizite
-    Gewhrleistung der MARKTFHIGKEIT oder EIGNUNG FR EINEN BESTIMMTEN ZWECK.
-    Siehe die GNU General Public License fr weitere Details.
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
 
     Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
     Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
@@ -72,10 +76,19 @@ This program is free software: you can redistribute it and/or modify
 #define clear_bit(sfr,bit)  sfr &= ~(1<<(bit))  /**< macro to clear a dedicated bit */
 
 
-void     _initSystemTime(void);
-uint16_t _microSecPerTick(void);
-uint16_t _gettime_Ticks(void);
-uint16_t _milliSecToTicks(uint16_t milliSec);
+void       _initSystemTime(void);
+uint16_t   _microSecPerTick(void);
+CosTicks_t _gettime_Ticks(void);
+CosTicks_t _milliSecToTicks(uint32_t milliSec);
+CosTicks_t _microSecToTicks(uint32_t microSec);
+
+#if COS_VIRTUAL_TIME
+void       _setVirtualTime_Ticks(CosTicks_t t_Ticks);
+#endif
+
+#if COS_SCHEDULER_COUNTERS
+uint32_t   _getTimeReads(void);
+#endif
 
 
 #endif
@@ -0,0 +1,496 @@
+/*!
+ ********************************************************************
+   @file            cos_timer.c
+   @par Project   : co-operative scheduler (COS)
+   @par Module    : Software timers
+
+   @brief  Software timers for COS, served by a single timer task. The
+          running timers are kept in a binary heap (min-heap), sorted by
+          expiry time.
+
+  @verbatim
+
+   heap_g[0] expires first, children of heap_g[i] are heap_g[2i+1] and
+   heap_g[2i+2], a child never expires before its parent:
+
+                         [0]
+                       /     \
+                    [1]       [2]
+                   /   \     /   \
+                 [3]   [4] [5]   [6]  ...
+
+  @endverbatim
+
+   @par Author    : Ernst Forgber (Fgb)
+   @par Company   : Hochschule Hannover - University of Applied Sciences and Arts, Germany
+   @par Department: Faculty 1
+ ********************************************************************
+
+   @par History   :
+   @verbatim
+   Version | Date        | Author | Change Description
+   0.0     | 18.10. 2026 | Fgb    | First Version
+   0.1     | 18.10. 2026 | Fgb    | timers from _memAlloc()
+   0.2     | 18.10. 2026 | Fgb    | timer task woken by _setTaskReady()
+   @endverbatim
+
+ ********************************************************************/
+/**************************************************************************
+
+Copyright 2026 Ernst Forgber
+
+
+This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+
+
+
+#include <stdlib.h>
+#include "cos_ser.h"
+#include "cos_timer.h"
+#include "cos_memory.h"
+
+
+
+
+/*------------- DEBUGGING ---------------------------------*/
+#define DEBUG_MODULE 0  /*!< 0 for no additional debug code, 1 otherwise */
+
+#if DEBUG_MODULE
+  #define DebugCode( code_fragment ) { code_fragment } /*!< for debugging only: insert some code */
+#else
+  #define DebugCode( code_fragment ) /*!< for debugging only: insert some code */
+#endif
+
+#if DEBUG_MODULE
+static void _msg(char *msg)
+{
+    DebugCode(serPuts(msg););
+}
+#endif
+/*---------------------------------------------------------------*/
+
+
+
+/****************************************************************/
+/* private module variables */
+/****************************************************************/
+static CosTimer_t *heap_g[COS_TIMER_MAX_TIMERS]; /*!< running timers */
+static uint16_t nRunning_g = 0;                  /*!< number of timers in heap */
+static CosTask_t *timerTask_pt_g = NULL;         /*!< the timer task */
+
+
+
+/****************************************************************/
+/* private functions */
+/****************************************************************/
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Compares two points in time. Like the scheduler, the difference of
+ * the tick values is used, timer wrap-around will not cause problems
+ * as long as both times are less than half a turn-around apart.
+ *
+ * @retval 1 if time a is before time b, 0 otherwise
+ ************************************************************************/
+static uint8_t _isBefore(CosTicks_t a, CosTicks_t b)
+{   return ((CosTicks_t)(a - b) > (((CosTicks_t) -1) >> 1)) ? 1 : 0;
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Puts timer t at position i of the heap.
+ ************************************************************************/
+static void _heapSet(uint16_t i, CosTimer_t *t)
+{   heap_g[i] = t;
+    t->heapIndex = i;
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Moves the timer at position i towards the root of the heap, until
+ * its parent expires before it.
+ ************************************************************************/
+static void _siftUp(uint16_t i)
+{ CosTimer_t *t = heap_g[i];
+  uint16_t parent;
+
+  while(i > 0)
+  { parent = (i - 1) / 2;
+    if(!_isBefore(t->expiry_Ticks, heap_g[parent]->expiry_Ticks))
+    { break;
+    }
+    _heapSet(i, heap_g[parent]);  /* parent moves down */
+    i = parent;
+  }
+  _heapSet(i, t);
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Moves the timer at position i away from the root of the heap, until
+ * it expires before both of its children.
+ ************************************************************************/
+static void _siftDown(uint16_t i)
+{ CosTimer_t *t = heap_g[i];
+  uint16_t child;
+
+  while((child = 2 * i + 1) < nRunning_g)
+  { if((child + 1 < nRunning_g) &&
+       _isBefore(heap_g[child + 1]->expiry_Ticks, heap_g[child]->expiry_Ticks))
+    { child++;  /* right child expires first */
+    }
+    if(!_isBefore(heap_g[child]->expiry_Ticks, t->expiry_Ticks))
+    { break;
+    }
+    _heapSet(i, heap_g[child]);  /* child moves up */
+    i = child;
+  }
+  _heapSet(i, t);
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Removes the timer at position i from the heap.
+ ************************************************************************/
+static void _heapRemove(uint16_t i)
+{ CosTimer_t *t = heap_g[i];
+
+  nRunning_g--;
+  t->heapIndex = COS_TIMER_NOT_RUNNING;
+  if(i == nRunning_g)
+  { return;  /* was the last one */
+  }
+  _heapSet(i, heap_g[nRunning_g]);  /* fill the gap with the last timer */
+  if((i > 0) && _isBefore(heap_g[i]->expiry_Ticks, heap_g[(i - 1) / 2]->expiry_Ticks))
+  { _siftUp(i);
+  }
+  else
+  { _siftDown(i);
+  }
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * The first timer in the heap may have changed: the timer task has to
+ * compute its sleep time again. It is woken up immediately.
+ ************************************************************************/
+static void _wakeUpTimerTask(void)
+{
+  if(timerTask_pt_g != NULL)
+  { timerTask_pt_g->sleepTime_Ticks = 0;
+    _setTaskReady(timerTask_pt_g);
+  }
+}
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * The timer task calls the callback-functions of all expired timers.
+ * Periodic timers are re-inserted into the heap with their next expiry
+ * time, which is computed from the previous expiry time, not from the
+ * current time: the period will not drift. Then the task sleeps until
+ * the first timer in the heap expires. Without running timers, the
+ * task blocks until a timer is started.
+ ************************************************************************/
+static void _timerTask(CosTask_t *pt)
+{ CosTimer_t *t = NULL;
+
+  COS_TASK_BEGIN(pt);
+  while(1)
+  { while((nRunning_g > 0) &&
+          !_isBefore(_gettime_Ticks(), heap_g[0]->expiry_Ticks))
+    { t = heap_g[0];
+      if(t->oneShot)
+      { _heapRemove(0);
+      }
+      else
+      { t->expiry_Ticks += t->period_Ticks;
+        _siftDown(0);
+      }
+      t->callback(t->arg);  /* may start, stop or delete timers */
+    }
+    if(nRunning_g == 0)
+    { pt->state = TASK_STATE_BLOCKED;  /* woken up by COS_TimerStart() */
+      COS_TASK_SCHEDULE(pt);
+    }
+    else
+    { /* sleep time is measured from the last activation */
+      COS_TASK_SLEEP(pt, _isBefore(heap_g[0]->expiry_Ticks, pt->lastActivationTime_Ticks) ? 0 :
+                         (CosTicks_t)(heap_g[0]->expiry_Ticks - pt->lastActivationTime_Ticks));
+    }
+  }
+  COS_TASK_END(pt);
+}
+
+
+
+
+/****************************************************************/
+/* exported module functions */
+/****************************************************************/
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * This function creates a software timer and starts it. After
+ * 'period_Ticks', the callback-function is called with argument 'arg'.
+ * A periodic timer is called again every 'period_Ticks', a one-shot
+ * timer stops and may be started again by COS_TimerStart().
+ * The first call creates the timer task.
+ *
+ * @see
+ * @arg  COS_TimerDelete(), COS_TimerStart(), COS_TimerStop()
+ *
+ *
+ * @param  period_Ticks    - IN, period of a periodic timer, delay of a one-shot timer
+ * @param  oneShot         - IN, 1 for a one-shot timer, 0 for a periodic timer
+ * @param  callback        - IN, function to be called at expiry
+ * @param  arg             - IN, argument of the callback-function
+ *
+ * @retval pointer to timer struct or NULL on error
+ *
+ * @par Code example:
+ * @verbatim
+void blink(void *arg)
+{   uint8_t *led = (uint8_t *) arg;
+    *led = !(*led);
+}
+
+void switchOff(void *arg)
+{   ...
+}
+
+int main(void)
+{ static uint8_t led = 0;
+  ...
+  COS_InitTaskList();
+  COS_TimerCreate(_milliSecToTicks(500), 0, blink, &led);
+  COS_TimerCreate(_milliSecToTicks(60000), 1, switchOff, NULL);
+  ...
+  COS_RunScheduler();
+}
+  @endverbatim
+ ************************************************************************/
+CosTimer_t *COS_TimerCreate(CosTicks_t period_Ticks, uint8_t oneShot,
+                            CosTimerCallback_t callback, void *arg)
+{ CosTimer_t *t = NULL;
+
+  if((NULL == callback) || ((period_Ticks == 0) && !oneShot))
+  { DebugCode(_msg("TimerCreate:param!"););
+    return NULL;
+  }
+  if(NULL == timerTask_pt_g)
+  { timerTask_pt_g = COS_CreateTask(COS_TIMER_TASK_PRIO, NULL, _timerTask);
+    if(NULL == timerTask_pt_g)
+    { DebugCode(_msg("TimerCreate:task!"););
+      return NULL;
+    }
+  }
+  t = (CosTimer_t *) _memAlloc(sizeof(CosTimer_t));
+  if(NULL == t)
+  { DebugCode(_msg("TimerCreate:malloc!"););
+    return NULL;
+  }
+  t->period_Ticks = period_Ticks;
+  t->oneShot      = oneShot ? 1 : 0;
+  t->callback     = callback;
+  t->arg          = arg;
+  t->heapIndex    = COS_TIMER_NOT_RUNNING;
+  if(0 != COS_TimerStart(t))
+  { _memFree(t, sizeof(CosTimer_t));
+    return NULL;
+  }
+  return t;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * This function stops a timer and frees its memory. A timer may delete
+ * itself in its callback-function.
+ *
+ * @see
+ * @arg  COS_TimerCreate()
+ *
+ * @param  t               - IN/OUT, pointer to timer struct
+ *
+ * @retval 0               - no error
+ * @retval negative        - an error occurred
+ ************************************************************************/
+int8_t COS_TimerDelete(CosTimer_t *t)
+{
+  if(NULL == t)
+  { return -1;
+  }
+  COS_TimerStop(t);
+  _memFree(t, sizeof(CosTimer_t));
+  return 0;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * This function starts a timer. The timer expires 'period_Ticks' after
+ * now. A running timer is restarted, this way a timer may be used as
+ * watchdog, that expires only if it is not restarted in time.
+ *
+ * @see
+ * @arg  COS_TimerStop(), COS_TimerChangePeriod()
+ *
+ * @param  t               - IN/OUT, pointer to timer struct
+ *
+ * @retval 0               - no error
+ * @retval negative        - too many running timers
+ ************************************************************************/
+int8_t COS_TimerStart(CosTimer_t *t)
+{
+  if(NULL == t)
+  { return -1;
+  }
+  t->expiry_Ticks = _gettime_Ticks() + t->period_Ticks;
+  if(t->heapIndex == COS_TIMER_NOT_RUNNING)
+  { if(nRunning_g >= COS_TIMER_MAX_TIMERS)
+    { DebugCode(_msg("TimerStart:heap full!"););
+      return -1;
+    }
+    _heapSet(nRunning_g, t);  /* append, then restore heap order */
+    nRunning_g++;
+    _siftUp(t->heapIndex);
+  }
+  else
+  { /* restarted: expiry time is later than before */
+    _siftDown(t->heapIndex);
+  }
+  _wakeUpTimerTask();
+  return 0;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * This function stops a timer, its callback-function will not be
+ * called any more. Stopping a timer, that is not running, is no error.
+ *
+ * @see
+ * @arg  COS_TimerStart()
+ *
+ * @param  t               - IN/OUT, pointer to timer struct
+ *
+ * @retval 0               - no error
+ * @retval negative        - an error occurred
+ ************************************************************************/
+int8_t COS_TimerStop(CosTimer_t *t)
+{
+  if(NULL == t)
+  { return -1;
+  }
+  if(t->heapIndex != COS_TIMER_NOT_RUNNING)
+  { _heapRemove(t->heapIndex);
+    _wakeUpTimerTask();
+  }
+  return 0;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * This function changes the period of a timer and (re-)starts it.
+ *
+ * @param  t               - IN/OUT, pointer to timer struct
+ * @param  period_Ticks    - IN, new period or delay in ticks
+ *
+ * @retval 0               - no error
+ * @retval negative        - an error occurred
+ ************************************************************************/
+int8_t COS_TimerChangePeriod(CosTimer_t *t, CosTicks_t period_Ticks)
+{
+  if((NULL == t) || ((period_Ticks == 0) && !t->oneShot))
+  { DebugCode(_msg("TimerChangePeriod:param!"););
+    return -1;
+  }
+  if(t->heapIndex != COS_TIMER_NOT_RUNNING)
+  { _heapRemove(t->heapIndex);  /* new expiry may be earlier */
+  }
+  t->period_Ticks = period_Ticks;
+  return COS_TimerStart(t);
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * This function checks if a timer is running.
+ *
+ * @param  t               - IN, pointer to timer struct
+ *
+ * @retval 1               - timer is running
+ * @retval 0               - timer is stopped
+ * @retval negative        - error
+ ************************************************************************/
+int8_t COS_TimerIsRunning(CosTimer_t *t)
+{
+  if(NULL == t)
+  { return -1;
+  }
+  return (t->heapIndex != COS_TIMER_NOT_RUNNING) ? 1 : 0;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * This function returns the number of running timers.
+ *
+ * @retval number of running timers
+ ************************************************************************/
+uint16_t COS_TimerGetNumberRunning(void)
+{   return nRunning_g;
+}
@@ -0,0 +1,117 @@
+/*!
+ ********************************************************************
+   @file            cos_timer.h
+   @par Project   : co-operative scheduler (COS)
+   @par Module    : Software timers
+
+   @brief  Software timers for COS. A timer calls a callback-function
+          once after a given time (one-shot timer) or periodically. All
+          timers are served by a single timer task, so a timer costs no
+          entry of its own in the task-list. The running timers are kept
+          in a binary heap, sorted by expiry time: the timer task only
+          looks at the first timer and sleeps until it expires.
+          Starting or stopping a timer costs O(log n).
+
+          The callback-functions run in the context of the timer task.
+          They must not block and must not use the scheduling macros.
+          Timers use dynamic memory allocation (malloc()), the number of
+          running timers is limited by COS_TIMER_MAX_TIMERS, see
+          cos_configure.h. The period of a timer has to be shorter than
+          half the range of CosTicks_t, i.e. 35 minutes with 32 bit
+          ticks of 1 microsecond.
+
+   @par Author    : Ernst Forgber (Fgb)
+   @par Company   : Hochschule Hannover - University of Applied Sciences and Arts, Germany
+   @par Department: Faculty 1
+ ********************************************************************
+
+   @par History   :
+   @verbatim
+   Version | Date        | Author | Change Description
+   0.0     | 18.10. 2026 | Fgb    | First Version
+   @endverbatim
+
+ ********************************************************************/
+/**************************************************************************
+
+Copyright 2026 Ernst Forgber
+
+
+This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+
+
+#ifndef _cos_timer_h_
+#define _cos_timer_h_
+
+
+#include "cos_configure.h"
+#include "cos_scheduler.h"
+#include "cos_types.h"
+
+#ifndef NULL
+    #define NULL 0  /*!< the null pointer value */
+#endif
+
+
+/*! heap index of a timer, that is not running */
+#define COS_TIMER_NOT_RUNNING   0xFFFF
+
+
+/*! type of a timer callback-function */
+typedef void (*CosTimerCallback_t)(void *arg);
+
+
+/*!
+ ********************************************************************
+  @par Description
+  Timer data structure. Use the functions below to access it.
+********************************************************************/
+typedef struct                      /*! software timer data structure */
+{
+        CosTicks_t expiry_Ticks;    /*!< time of next expiry */
+        CosTicks_t period_Ticks;    /*!< period or delay in ticks */
+        CosTimerCallback_t callback;/*!< called at expiry */
+        void *arg;                  /*!< argument of the callback */
+        uint16_t heapIndex;         /*!< position in heap, COS_TIMER_NOT_RUNNING if stopped */
+        uint8_t oneShot;            /*!< 1 for a one-shot timer, 0 for a periodic timer */
+} CosTimer_t;
+
+
+
+CosTimer_t *COS_TimerCreate(CosTicks_t period_Ticks, uint8_t oneShot,
+                            CosTimerCallback_t callback, void *arg);
+int8_t      COS_TimerDelete(CosTimer_t *t);
+int8_t      COS_TimerStart(CosTimer_t *t);
+int8_t      COS_TimerStop(CosTimer_t *t);
+int8_t      COS_TimerChangePeriod(CosTimer_t *t, CosTicks_t period_Ticks);
+int8_t      COS_TimerIsRunning(CosTimer_t *t);
+uint16_t    COS_TimerGetNumberRunning(void);
+
+
+#endif
@@ -0,0 +1,323 @@
+/*!
+ ********************************************************************
+   @file            cos_trace.c
+   @par Project   : co-operative scheduler (COS)
+   @par Module    : Scheduler trace recorder
+
+   @brief  RAM ring buffer of binary trace records, see cos_trace.h.
+
+   Dump format of COS_TraceDump(), one line per record, oldest first:
+   @verbatim
+   COSTRACE 1 <microseconds per tick> <bits of time stamp> <lost events>
+   <time stamp, 8 hex digits> <task id, 4 hex> <event, 2 hex> <arg, 2 hex>
+   ...
+   COSTRACE END
+   @endverbatim
+
+   @par Author    : Ernst Forgber (Fgb)
+   @par Company   : Hochschule Hannover - University of Applied Sciences and Arts, Germany
+   @par Department: Faculty 1
+ ********************************************************************
+
+   @par History   :
+   @verbatim
+   Version | Date        | Author | Change Description
+   0.0     | 18.10. 2026 | Fgb    | First Version
+   0.1     | 18.10. 2026 | Fgb    | dump not truncated by a full TX buffer
+   @endverbatim
+
+ ********************************************************************/
+/**************************************************************************
+
+Copyright 2026 Ernst Forgber
+
+
+This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+
+
+
+#include "cos_ser.h"
+#include "cos_linear_task_list.h"
+#include "cos_trace.h"
+
+#if COS_TRACE
+
+#if (COS_TRACE_BUFFER_EVENTS & (COS_TRACE_BUFFER_EVENTS - 1)) != 0
+  #error "COS_TRACE_BUFFER_EVENTS has to be a power of two"
+#endif
+
+
+
+/*------------- DEBUGGING ---------------------------------*/
+#define DEBUG_MODULE 0  /*!< 0 for no additional debug code, 1 otherwise */
+
+#if DEBUG_MODULE
+  #define DebugCode( code_fragment ) { code_fragment } /*!< for debugging only: insert some code */
+#else
+  #define DebugCode( code_fragment ) /*!< for debugging only: insert some code */
+#endif
+/*---------------------------------------------------------------*/
+
+
+/*! wraps indices of the ring buffer */
+#define TRACE_INDEX_MASK   (COS_TRACE_BUFFER_EVENTS - 1)
+
+
+/****************************************************************/
+/* private module variables */
+/****************************************************************/
+static CosTraceEvent_t buffer_g[COS_TRACE_BUFFER_EVENTS]; /*!< ring buffer */
+static uint16_t head_g = 0;        /*!< next record to write */
+static uint16_t count_g = 0;       /*!< number of records in buffer */
+static uint32_t lost_g = 0;        /*!< overwritten records */
+static uint8_t  enabled_g = 1;     /*!< 0: recording stopped */
+static uint16_t runningId_g = 0;   /*!< id of the running task, 0 for none */
+static uint16_t nextTaskId_g = 1;  /*!< id of the next task created */
+
+
+
+/****************************************************************/
+/* private functions */
+/****************************************************************/
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Writes the lower 'digits' hex digits of x.
+ ************************************************************************/
+static void _putHex(uint32_t x, uint8_t digits)
+{   uint8_t y;
+
+    while(digits > 0)
+    {   digits--;
+        y = (x >> (4 * digits)) & 0xF;
+        serPutc((y < 10) ? (y + '0') : (y - 10 + 'A'));
+    }
+}
+
+
+
+/****************************************************************/
+/* exported module functions */
+/****************************************************************/
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * PLEASE NOTE: This function is for internal use only! Use the macro
+ * COS_TRACE_EVENT(), that expands to nothing without COS_TRACE.
+ * Stores a record in the ring buffer, the oldest record is overwritten
+ * if the buffer is full. Dispatch start and end events also keep track
+ * of the running task.
+ *
+ * @param  event           - IN, event type COS_TRACE_xxx
+ * @param  pt              - IN, task, NULL for the running task
+ * @param  arg             - IN, event argument
+ ************************************************************************/
+void _traceRecord(uint8_t event, struct CosTask_t *pt, uint8_t arg)
+{   CosTraceEvent_t *e;
+    uint16_t id = (NULL != pt) ? pt->traceId : runningId_g;
+
+    if(COS_TRACE_DISPATCH_START == event)
+    {   runningId_g = id;
+    }
+    else if(COS_TRACE_DISPATCH_END == event)
+    {   runningId_g = 0;
+    }
+    if(!enabled_g)
+    {   return;
+    }
+    e = &buffer_g[head_g];
+    e->time_Ticks = _gettime_Ticks();
+    e->taskId = id;
+    e->event = event;
+    e->arg = arg;
+    head_g = (head_g + 1) & TRACE_INDEX_MASK;
+    if(count_g < COS_TRACE_BUFFER_EVENTS)
+    {   count_g++;
+    }
+    else
+    {   lost_g++;  /* oldest record overwritten */
+    }
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * PLEASE NOTE: This function is for internal use only! Returns the
+ * trace id of a new task, called by _newTask().
+ *
+ * @retval task id, 1 for the first task
+ ************************************************************************/
+uint16_t _traceNewTaskId(void)
+{   if(0 == nextTaskId_g)
+    {   nextTaskId_g = 1;  /* 0 is reserved for 'no task' */
+    }
+    return nextTaskId_g++;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Starts or stops recording. A typical use is to stop the recorder
+ * when a deadline is missed, so the events before it are kept for
+ * COS_TraceDump().
+ *
+ * @param  on              - IN, 1 to record events, 0 to stop
+ *
+ * @par Code example:
+ * @verbatim
+void controlTask(CosTask_t *pt)
+{   COS_TASK_BEGIN(pt);
+    while(1)
+    {   ...
+        if((CosTicks_t)(_gettime_Ticks() - pt->lastActivationTime_Ticks) > deadline)
+        {   COS_TraceEnable(0);  // keep the history of the missed deadline
+        }
+        COS_TASK_SLEEP(pt,_milliSecToTicks(10));
+    }
+    COS_TASK_END(pt);
+}
+  @endverbatim
+ ************************************************************************/
+void COS_TraceEnable(uint8_t on)
+{   enabled_g = (0 != on);
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Removes all records from the buffer and clears the lost counter.
+ ************************************************************************/
+void COS_TraceClear(void)
+{   head_g = 0;
+    count_g = 0;
+    lost_g = 0;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Returns the number of records in the buffer.
+ ************************************************************************/
+uint16_t COS_TraceGetCount(void)
+{   return count_g;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Returns the number of records, that have been overwritten since the
+ * last COS_TraceClear().
+ ************************************************************************/
+uint32_t COS_TraceGetLost(void)
+{   return lost_g;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Copies the oldest records to 'events' and removes them from the
+ * buffer, e.g. to send them in binary form.
+ *
+ * @param  events          - OUT, array for the records
+ * @param  maxEvents       - IN, size of the array
+ *
+ * @retval number of records copied
+ ************************************************************************/
+uint16_t COS_TraceRead(CosTraceEvent_t *events, uint16_t maxEvents)
+{   uint16_t n = 0;
+    uint16_t tail = (head_g - count_g) & TRACE_INDEX_MASK;
+
+    while((n < maxEvents) && (count_g > 0))
+    {   events[n++] = buffer_g[tail];
+        tail = (tail + 1) & TRACE_INDEX_MASK;
+        count_g--;
+    }
+    return n;
+}
+
+
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Writes all records as hex text to the serial interface, oldest
+ * first, and empties the buffer. Recording is stopped during the
+ * dump, the dump itself causes no records. The format is described
+ * at the top of cos_trace.c. With a TX buffer, the dump waits for the
+ * UART when the buffer is full, see serTxBulkBegin().
+ *
+ * @par Code example:
+ * @verbatim
+   on the target:   COS_TraceDump();
+   on the host:     ./build/cos_trace2json < dump.txt > trace.json
+  @endverbatim
+ ************************************************************************/
+void COS_TraceDump(void)
+{   CosTraceEvent_t e;
+    uint8_t wasEnabled = enabled_g;
+
+    enabled_g = 0;
+    SER_TX_BULK_BEGIN();
+    serPuts("COSTRACE 1");  /* serOutUint32Dec() adds a leading blank */
+    serOutUint32Dec(COS_MICROSEC_PER_TICK);
+    serOutUint32Dec(8 * sizeof(CosTicks_t));
+    serOutUint32Dec(lost_g);
+    serPuts("\r\n");
+    while(COS_TraceRead(&e, 1) > 0)
+    {   _putHex(e.time_Ticks, 8);
+        serPutc(' ');
+        _putHex(e.taskId, 4);
+        serPutc(' ');
+        _putHex(e.event, 2);
+        serPutc(' ');
+        _putHex(e.arg, 2);
+        serPuts("\r\n");
+    }
+    serPuts("COSTRACE END\r\n");
+    SER_TX_BULK_END();
+    lost_g = 0;
+    enabled_g = wasEnabled;
+}
+
+
+#endif // COS_TRACE
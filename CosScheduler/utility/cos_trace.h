@@ -0,0 +1,140 @@
+/*!
+ ********************************************************************
+   @file            cos_trace.h
+   @par Project   : co-operative scheduler (COS)
+   @par Module    : Scheduler trace recorder
+
+   @brief  Optional trace of scheduler events. With COS_TRACE set to 1
+          in cos_configure.h, COS records task dispatch start and end,
+          blocking at and un-blocking by semaphores, FIFO reads and
+          writes, task creation, deletion, priority changes and budget
+          violations. Each event is an 8 byte binary record (time stamp,
+          task id, event type, argument) in a RAM ring buffer of
+          COS_TRACE_BUFFER_EVENTS records. When the buffer is full, the
+          oldest events are overwritten.
+
+          COS_TraceDump() writes the buffer as hex text to the serial
+          interface. The host tool in extras/trace2json converts such a
+          dump into Chrome trace JSON, which may be viewed as a timeline
+          in chrome://tracing or https://ui.perfetto.dev.
+
+          With COS_TRACE set to 0, the macro COS_TRACE_EVENT() expands
+          to nothing and the recorder costs neither RAM nor time.
+          Events must not be recorded from interrupt service routines.
+
+   @par Author    : Ernst Forgber (Fgb)
+   @par Company   : Hochschule Hannover - University of Applied Sciences and Arts, Germany
+   @par Department: Faculty 1
+ ********************************************************************
+
+   @par History   :
+   @verbatim
+   Version | Date        | Author | Change Description
+   0.0     | 18.10. 2026 | Fgb    | First Version
+   0.1     | 18.10. 2026 | Fgb    | budget violation event
+   @endverbatim
+
+ ********************************************************************/
+/**************************************************************************
+
+Copyright 2026 Ernst Forgber
+
+
+This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+
+
+#ifndef _cos_trace_h_
+#define _cos_trace_h_
+
+
+#include "cos_configure.h"
+#include "cos_types.h"
+
+struct CosTask_t;
+
+
+/* event types, the meaning of the argument is given in brackets */
+#define COS_TRACE_DISPATCH_START  1  /*!< task function called (-) */
+#define COS_TRACE_DISPATCH_END    2  /*!< task function returned (-) */
+#define COS_TRACE_BLOCK           3  /*!< task blocked at a semaphore (-) */
+#define COS_TRACE_UNBLOCK         4  /*!< task un-blocked by a semaphore (-) */
+#define COS_TRACE_FIFO_WRITE      5  /*!< slot written to a FIFO (used slots) */
+#define COS_TRACE_FIFO_READ       6  /*!< slot read from a FIFO (used slots) */
+#define COS_TRACE_TASK_CREATE     7  /*!< task created (priority) */
+#define COS_TRACE_TASK_DELETE     8  /*!< task deleted (-) */
+#define COS_TRACE_PRIO_CHANGE     9  /*!< task priority changed (new priority) */
+#define COS_TRACE_BUDGET         10  /*!< call longer than the budget of the task (-) */
+
+
+/*!
+ ********************************************************************
+  @par Description
+  One trace record. The task id is assigned when the task is created,
+  the first task gets id 1. Id 0 means: no task is running, e.g. an
+  event in main() before COS_RunScheduler().
+********************************************************************/
+typedef struct                 /*! trace record */
+{
+        uint32_t time_Ticks;   /*!< time stamp, _gettime_Ticks() */
+        uint16_t taskId;       /*!< task the event belongs to */
+        uint8_t  event;        /*!< event type COS_TRACE_xxx */
+        uint8_t  arg;          /*!< event argument */
+} CosTraceEvent_t;
+
+
+#if COS_TRACE
+
+/*!
+ **********************************************************************
+ * @par Description:
+ * Records an event. If pt is NULL, the event belongs to the task that
+ * is running at the moment.
+ *
+ * @par Macro parameters: (uint8_t event, CosTask_t *pt, uint8_t arg)
+ ************************************************************************/
+#define COS_TRACE_EVENT(event, pt, arg)  _traceRecord((event), (pt), (uint8_t)(arg))
+
+void     _traceRecord(uint8_t event, struct CosTask_t *pt, uint8_t arg);
+uint16_t _traceNewTaskId(void);
+
+void     COS_TraceEnable(uint8_t on);
+void     COS_TraceClear(void);
+uint16_t COS_TraceGetCount(void);
+uint32_t COS_TraceGetLost(void);
+uint16_t COS_TraceRead(CosTraceEvent_t *events, uint16_t maxEvents);
+void     COS_TraceDump(void);
+
+#else
+
+#define COS_TRACE_EVENT(event, pt, arg)
+
+#endif // COS_TRACE
+
+
+#endif
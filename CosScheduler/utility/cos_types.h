@@ -20,6 +20,9 @@
    Version | Date        | Author  | Change Description
    0.0     | 08.10. 2015 | Fgb     | created for renesas controller RX63N
    0.1     | 11.11. 2016 | Fgb     | compatibility to openCM included
+   0.2     | 18.10. 2026 | Fgb     | CosTicks_t, Arduino included
+   0.3     | 18.10. 2026 | Fgb     | POSIX included
+   0.4     | 18.10. 2026 | Fgb     | 64 bit types for RX63N
    @endverbatim
 
  ********************************************************************/
@@ -41,15 +44,15 @@ This program is free software: you can redistribute it and/or modify
     You should have received a copy of the GNU General Public License
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
-    Dieses Programm ist Freie Software: Sie knnen es unter den Bedingungen
+    Dieses Programm ist Freie Software: Sie können es unter den Bedingungen
     der GNU General Public License, wie von der Free Software Foundation,
     Version 3 der Lizenz oder (nach Ihrer Wahl) jeder neueren
-    verffentlichten Version, weiterverbreiten und/oder modifizieren.
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
 
-    Dieses Programm wird in der Hoffnung, dass es ntzlich sein wird, aber
-    OHNE JEDE GEWHRLEISTUNG, bereitgestellt; sogar ohne die implizite
-    Gewhrleistung der MARKTFHIGKEIT oder EIGNUNG FR EINEN BESTIMMTEN ZWECK.
-    Siehe die GNU General Public License fr weitere Details.
+    Dieses Programm wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
 
     Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
     Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
@@ -97,8 +100,25 @@ This program is free software: you can redistribute it and/or modify
     #ifndef uint32_t
         #define uint32_t unsigned long
     #endif
+    #ifndef int64_t
+        #define int64_t signed long long
+    #endif
+    #ifndef uint64_t
+        #define uint64_t unsigned long long
+    #endif
+#endif // COS_PLATFORM
+
+#if (COS_PLATFORM == PLATFORM_ARDUINO) || (COS_PLATFORM == PLATFORM_POSIX)
+    #include <stdint.h>
 #endif // COS_PLATFORM
 
 
+#if COS_TICKS_32BIT
+    typedef uint32_t                CosTicks_t; /**< system time and time intervals in ticks */
+#else
+    typedef uint16_t                CosTicks_t; /**< system time and time intervals in ticks */
+#endif
+
+
 
 #endif /* COS_TYPES_H_ */